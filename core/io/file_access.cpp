@@ -39,6 +39,7 @@
 #include "core/io/marshalls.h"
 #include "core/io/resource_uid.h"
 #include "core/object/class_db.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/os/time.h"
 
@@ -567,6 +568,57 @@ Vector<uint8_t> FileAccess::get_buffer(int64_t p_length) const {
 	return data;
 }
 
+uint64_t FileAccess::get_buffer_at(uint64_t p_position, uint8_t *p_dst, uint64_t p_length) const {
+	// Generic fallback: serialize positional reads through the cursor and restore it afterwards.
+	MutexLock lock(buffer_at_mutex);
+
+	FileAccess *self = const_cast<FileAccess *>(this);
+	uint64_t prev_position = get_position();
+	self->seek(p_position);
+	uint64_t read = get_buffer(p_dst, p_length);
+	self->seek(prev_position);
+
+	return read;
+}
+
+void FileAccess::_read_async_task(void *p_userdata) {
+	AsyncRead *ar = (AsyncRead *)p_userdata;
+	uint64_t read = ar->file->get_buffer_at(ar->position, ar->dst, ar->length);
+	if (ar->r_read) {
+		*ar->r_read = read;
+	}
+	memdelete(ar);
+}
+
+int64_t FileAccess::read_async(uint64_t p_position, uint8_t *p_dst, uint64_t p_length, uint64_t *r_read) {
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, WorkerThreadPool::INVALID_TASK_ID);
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (!pool) {
+		// No pool (yet), complete the read right away.
+		uint64_t read = get_buffer_at(p_position, p_dst, p_length);
+		if (r_read) {
+			*r_read = read;
+		}
+		return WorkerThreadPool::INVALID_TASK_ID;
+	}
+
+	AsyncRead *ar = memnew(AsyncRead);
+	ar->file = Ref<FileAccess>(this);
+	ar->position = p_position;
+	ar->dst = p_dst;
+	ar->length = p_length;
+	ar->r_read = r_read;
+	return pool->add_native_task(&FileAccess::_read_async_task, ar, false, SNAME("FileAccessReadAsync"));
+}
+
+void FileAccess::wait_async_read(int64_t p_id) {
+	if (p_id == WorkerThreadPool::INVALID_TASK_ID) {
+		return; // Completed synchronously.
+	}
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(p_id);
+}
+
 String FileAccess::get_as_utf8_string() const {
 	Vector<uint8_t> sourcef;
 	uint64_t len = get_length();
@@ -931,26 +983,57 @@ String FileAccess::get_file_as_string(const String &p_path, Error *r_error) {
 	return ret;
 }
 
-String FileAccess::get_md5(const String &p_file) {
-	Ref<FileAccess> f = FileAccess::open(p_file, READ);
-	if (f.is_null()) {
-		return String();
-	}
+// Feeds the rest of a file to a hash context. The next block is read asynchronously
+// while the current one is being hashed, so I/O and hashing overlap on large files.
+template <typename T>
+static void _hash_file(const Ref<FileAccess> &p_file, T &r_ctx) {
+	constexpr uint64_t STEP = 65536;
 
-	CryptoCore::MD5Context ctx;
-	ctx.start();
+	Vector<uint8_t> buffer;
+	buffer.resize(STEP * 2);
+	uint8_t *blocks[2] = { buffer.ptrw(), buffer.ptrw() + STEP };
+	uint64_t read[2] = { 0, 0 };
+	int current = 0;
 
-	unsigned char step[32768];
+	uint64_t position = p_file->get_position();
+	read[current] = p_file->get_buffer_at(position, blocks[current], STEP);
 
 	while (true) {
-		uint64_t br = f->get_buffer(step, 32768);
+		uint64_t br = read[current];
+		if (br > STEP) {
+			break; // Read error.
+		}
+		position += br;
+
+		// A short read means end of file, otherwise prefetch the next block.
+		bool more = br == STEP;
+		int64_t pending = WorkerThreadPool::INVALID_TASK_ID;
+		if (more) {
+			pending = p_file->read_async(position, blocks[current ^ 1], STEP, &read[current ^ 1]);
+		}
+
 		if (br > 0) {
-			ctx.update(step, br);
+			r_ctx.update(blocks[current], br);
 		}
-		if (br < 4096) {
+
+		if (!more) {
 			break;
 		}
+		FileAccess::wait_async_read(pending);
+		current ^= 1;
 	}
+}
+
+String FileAccess::get_md5(const String &p_file) {
+	Ref<FileAccess> f = FileAccess::open(p_file, READ);
+	if (f.is_null()) {
+		return String();
+	}
+
+	CryptoCore::MD5Context ctx;
+	ctx.start();
+
+	_hash_file(f, ctx);
 
 	unsigned char hash[16];
 	ctx.finish(hash);
@@ -966,17 +1049,7 @@ String FileAccess::get_multiple_md5(const Vector<String> &p_file) {
 		Ref<FileAccess> f = FileAccess::open(p_file[i], READ);
 		ERR_CONTINUE(f.is_null());
 
-		unsigned char step[32768];
-
-		while (true) {
-			uint64_t br = f->get_buffer(step, 32768);
-			if (br > 0) {
-				ctx.update(step, br);
-			}
-			if (br < 4096) {
-				break;
-			}
-		}
+		_hash_file(f, ctx);
 	}
 
 	unsigned char hash[16];
@@ -994,17 +1067,7 @@ String FileAccess::get_sha256(const String &p_file) {
 	CryptoCore::SHA256Context ctx;
 	ctx.start();
 
-	unsigned char step[32768];
-
-	while (true) {
-		uint64_t br = f->get_buffer(step, 32768);
-		if (br > 0) {
-			ctx.update(step, br);
-		}
-		if (br < 4096) {
-			break;
-		}
-	}
+	_hash_file(f, ctx);
 
 	unsigned char hash[32];
 	ctx.finish(hash);
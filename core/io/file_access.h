@@ -34,6 +34,7 @@
 #include "core/math/math_defs.h"
 #include "core/object/ref_counted.h"
 #include "core/os/memory.h"
+#include "core/os/mutex.h"
 #include "core/string/ustring.h"
 #include "core/typedefs.h"
 #include "core/variant/type_info.h"
@@ -161,6 +162,17 @@ private:
 
 	static Ref<FileAccess> _create_temp(ModeFlags p_mode_flags, const String &p_prefix = "", const String &p_extension = "", bool p_keep = false);
 
+	mutable BinaryMutex buffer_at_mutex;
+
+	struct AsyncRead {
+		Ref<FileAccess> file;
+		uint64_t position = 0;
+		uint8_t *dst = nullptr;
+		uint64_t length = 0;
+		uint64_t *r_read = nullptr;
+	};
+	static void _read_async_task(void *p_userdata);
+
 public:
 	static void set_file_close_fail_notify_callback(FileCloseFailNotify p_cbk) { close_fail_notify = p_cbk; }
 
@@ -190,6 +202,17 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	virtual uint64_t get_buffer_at(uint64_t p_position, uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes from a given position, without using or moving the file cursor.
+
+	/**
+	 * Asynchronous reads, serviced on the WorkerThreadPool through get_buffer_at().
+	 * Several reads can be in flight at once and overlap with work on the calling thread.
+	 * The destination buffer (and r_read, if given) must stay valid until wait_async_read() returns,
+	 * and the file cursor must not be used while reads are pending, unless the implementation
+	 * overrides get_buffer_at() with a truly positional read.
+	 */
+	int64_t read_async(uint64_t p_position, uint8_t *p_dst, uint64_t p_length, uint64_t *r_read = nullptr);
+	static void wait_async_read(int64_t p_id);
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -493,6 +493,19 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return to_read;
 }
 
+uint64_t FileAccessPack::get_buffer_at(uint64_t p_position, uint8_t *p_dst, uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+
+	if (p_position >= pf.size) {
+		return 0;
+	}
+	uint64_t to_read = MIN(p_length, pf.size - p_position);
+
+	// Forward to the pack file, so reads stay positional (and concurrent) when it supports it.
+	return f->get_buffer_at(off + p_position, p_dst, to_read);
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
 	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
 
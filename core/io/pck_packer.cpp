@@ -35,8 +35,12 @@
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
 #include "core/object/class_db.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/version.h"
 
+// Queued file data is read, hashed and written once it reaches this size.
+static constexpr uint64_t PENDING_SIZE_MAX = 256 * 1024 * 1024;
+
 static int _get_pad(int p_alignment, int p_n) {
 	int rest = p_n % p_alignment;
 	int pad = 0;
@@ -49,13 +53,14 @@ static int _get_pad(int p_alignment, int p_n) {
 
 void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_path", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("pck_start_incremental", "pck_path", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start_incremental, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file", "target_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file_from_buffer", "target_path", "data", "encrypt"), &PCKPacker::add_file_from_buffer, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file_removal", "target_path"), &PCKPacker::add_file_removal);
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
 }
 
-Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const String &p_key, bool p_encrypt_directory) {
+Error PCKPacker::_start(int p_alignment, const String &p_key, bool p_encrypt_directory) {
 	ERR_FAIL_COND_V_MSG((p_key.is_empty() || !p_key.is_valid_hex_number(false) || p_key.length() != 64), ERR_CANT_CREATE, "Invalid Encryption Key (must be 64 characters long).");
 	ERR_FAIL_COND_V_MSG(p_alignment <= 0, ERR_CANT_CREATE, "Invalid alignment, must be greater then 0.");
 
@@ -85,12 +90,20 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 		key.write[i] = v;
 	}
 	enc_dir = p_encrypt_directory;
+	alignment = p_alignment;
 
-	file = FileAccess::open(p_pck_path, FileAccess::WRITE);
-	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_CANT_CREATE, vformat("Can't open file to write: '%s'.", String(p_pck_path)));
+	file_base = 0;
+	files.clear();
+	pending.clear();
+	pending_size = 0;
+	previous_files.clear();
+	incremental = false;
+	content_blobs.clear();
 
-	alignment = p_alignment;
+	return OK;
+}
 
+void PCKPacker::_store_header() {
 	file->store_32(PACK_HEADER_MAGIC);
 	file->store_32(PACK_FORMAT_VERSION);
 	file->store_32(GODOT_VERSION_MAJOR);
@@ -104,7 +117,7 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	file->store_32(pack_flags); // flags
 
 	file_base_ofs = file->get_position();
-	file->store_64(0); // Files base.
+	file->store_64(file_base); // Files base.
 
 	dir_base_ofs = file->get_position();
 	file->store_64(0); // Directory offset.
@@ -112,6 +125,18 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	for (int i = 0; i < 16; i++) {
 		file->store_32(0); // Reserved.
 	}
+}
+
+Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const String &p_key, bool p_encrypt_directory) {
+	Error err = _start(p_alignment, p_key, p_encrypt_directory);
+	if (err != OK) {
+		return err;
+	}
+
+	file = FileAccess::open(p_pck_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_CANT_CREATE, vformat("Can't open file to write: '%s'.", String(p_pck_path)));
+
+	_store_header();
 
 	// Align for first file.
 	int pad = _get_pad(alignment, file->get_position());
@@ -124,7 +149,109 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	file->store_64(file_base); // Update files base.
 	file->seek(file_base);
 
-	files.clear();
+	return OK;
+}
+
+Error PCKPacker::_read_previous_directory(uint64_t &r_dir_offset) {
+	file->seek(0);
+	if (file->get_32() != PACK_HEADER_MAGIC || file->get_32() != PACK_FORMAT_VERSION) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	for (int i = 0; i < 3; i++) {
+		file->get_32(); // Engine version.
+	}
+
+	uint32_t pack_flags = file->get_32();
+	if (!(pack_flags & PACK_REL_FILEBASE) || (pack_flags & PACK_SPARSE_BUNDLE)) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	bool dir_encrypted = pack_flags & PACK_DIR_ENCRYPTED;
+
+	file_base = file->get_64();
+	r_dir_offset = file->get_64();
+	if (file_base == 0 || r_dir_offset < file_base || r_dir_offset > file->get_length()) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	file->seek(r_dir_offset);
+	uint32_t file_count = file->get_32();
+
+	Ref<FileAccess> fdir = file;
+	if (dir_encrypted) {
+		Ref<FileAccessEncrypted> fae;
+		fae.instantiate();
+		Error err = fae->open_and_parse(file, key, FileAccessEncrypted::MODE_READ, false);
+		if (err != OK) {
+			return err;
+		}
+		fdir = fae;
+	}
+
+	for (uint32_t i = 0; i < file_count; i++) {
+		uint32_t sl = fdir->get_32();
+		if (fdir->eof_reached()) {
+			return ERR_FILE_CORRUPT;
+		}
+		CharString cs;
+		cs.resize_uninitialized(sl + 1);
+		fdir->get_buffer((uint8_t *)cs.ptr(), sl);
+		cs[sl] = 0;
+
+		File pf;
+		pf.path = String::utf8(cs.get_data());
+		pf.ofs = file_base + fdir->get_64();
+		pf.size = fdir->get_64();
+		pf.md5.resize(16);
+		fdir->get_buffer(pf.md5.ptrw(), 16);
+		uint32_t flags = fdir->get_32();
+		pf.encrypted = flags & PACK_FILE_ENCRYPTED;
+
+		if (fdir->eof_reached()) {
+			return ERR_FILE_CORRUPT;
+		}
+		if ((flags & (PACK_FILE_REMOVAL | PACK_FILE_DELTA)) || pf.ofs + pf.size > r_dir_offset) {
+			continue; // Nothing to reuse.
+		}
+		if (pf.encrypted && !dir_encrypted) {
+			continue; // The key these were encrypted with can't be verified.
+		}
+		previous_files[pf.path] = pf;
+	}
+
+	return OK;
+}
+
+Error PCKPacker::pck_start_incremental(const String &p_pck_path, int p_alignment, const String &p_key, bool p_encrypt_directory) {
+	if (!FileAccess::exists(p_pck_path)) {
+		return pck_start(p_pck_path, p_alignment, p_key, p_encrypt_directory);
+	}
+
+	Error err = _start(p_alignment, p_key, p_encrypt_directory);
+	if (err != OK) {
+		return err;
+	}
+
+	file = FileAccess::open(p_pck_path, FileAccess::READ_WRITE);
+	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_CANT_CREATE, vformat("Can't open file to update: '%s'.", String(p_pck_path)));
+
+	uint64_t dir_offset = 0;
+	if (_read_previous_directory(dir_offset) != OK) {
+		print_verbose(vformat("PCKPacker: Can't update '%s' in place, creating a new pack instead.", p_pck_path));
+		file.unref();
+		return pck_start(p_pck_path, p_alignment, p_key, p_encrypt_directory);
+	}
+	incremental = true;
+
+	// Rewrite the header for the current settings, the files base stays the same.
+	file->seek(0);
+	_store_header();
+
+	// Changed files are appended where the previous directory was.
+	file->seek(dir_offset);
+	int pad = _get_pad(alignment, file->get_position());
+	for (int i = 0; i < pad; i++) {
+		file->store_8(0);
+	}
 
 	return OK;
 }
@@ -132,17 +259,13 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 Error PCKPacker::add_file_removal(const String &p_target_path) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
-	File pf;
+	PendingFile pf;
 	// Simplify path here and on every 'files' access so that paths that have extra '/'
 	// symbols or 'res://' in them still match the MD5 hash for the saved path.
 	pf.path = p_target_path.simplify_path().trim_prefix("res://");
-	pf.ofs = file->get_position();
-	pf.size = 0;
 	pf.removal = true;
 
-	pf.md5.resize_initialized(16);
-
-	files.push_back(pf);
+	pending.push_back(pf);
 
 	return OK;
 }
@@ -154,40 +277,149 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 	if (f.is_null()) {
 		return ERR_FILE_CANT_OPEN;
 	}
-	Vector<uint8_t> data = FileAccess::get_file_as_bytes(p_source_path);
+	uint64_t size = f->get_length();
+	f.unref();
 
-	return _add_file(p_target_path, p_source_path, data, p_encrypt);
+	return _add_file(p_target_path, p_source_path, Vector<uint8_t>(), size, false, p_encrypt);
 }
 
 Error PCKPacker::add_file_from_buffer(const String &p_target_path, const Vector<uint8_t> &p_data, bool p_encrypt) {
-	return _add_file(p_target_path, "<PackedByteArray>", p_data, p_encrypt);
+	return _add_file(p_target_path, "<PackedByteArray>", p_data, p_data.size(), true, p_encrypt);
 }
 
-Error PCKPacker::_add_file(const String &p_target_path, const String &p_source_path, const Vector<uint8_t> &p_data, bool p_encrypt) {
+Error PCKPacker::_add_file(const String &p_target_path, const String &p_source_path, const Vector<uint8_t> &p_data, uint64_t p_size, bool p_from_buffer, bool p_encrypt) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
-	File pf;
+	PendingFile pf;
 	// Simplify path here and on every 'files' access so that paths that have extra '/'
 	// symbols or 'res://' in them still match the MD5 hash for the saved path.
 	pf.path = p_target_path.simplify_path().trim_prefix("res://");
 	pf.src_path = p_source_path;
-	pf.ofs = file->get_position();
-	pf.size = p_data.size();
+	pf.data = p_data;
+	pf.size = p_size;
+	pf.from_buffer = p_from_buffer;
+	pf.encrypted = p_encrypt;
 
-	{
-		unsigned char hash[16];
-		CryptoCore::md5(p_data.ptr(), p_data.size(), hash);
-		pf.md5.resize(16);
-		for (int i = 0; i < 16; i++) {
-			pf.md5.write[i] = hash[i];
+	pending.push_back(pf);
+	pending_size += p_size;
+
+	if (pending_size >= PENDING_SIZE_MAX) {
+		return _flush_pending();
+	}
+	return OK;
+}
+
+void PCKPacker::_process_pending_files(void *p_userdata) {
+	PendingBatch *batch = (PendingBatch *)p_userdata;
+
+	while (true) {
+		uint32_t index = batch->next.postincrement();
+		if (index >= batch->count) {
+			break;
+		}
+
+		PendingFile &pf = batch->files[index];
+		if (pf.removal) {
+			continue;
 		}
+		if (!pf.from_buffer) {
+			pf.data = FileAccess::get_file_as_bytes(pf.src_path, &pf.error);
+			if (pf.error != OK) {
+				continue;
+			}
+		}
+		CryptoCore::md5(pf.data.ptr(), pf.data.size(), pf.md5);
+		CryptoCore::sha256(pf.data.ptr(), pf.data.size(), pf.sha256);
+	}
+}
+
+Error PCKPacker::_flush_pending() {
+	if (pending.is_empty()) {
+		return OK;
+	}
+
+	// Read and hash the queued files on the worker threads, this thread helps as well.
+	PendingBatch batch;
+	batch.files = pending.ptr();
+	batch.count = pending.size();
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	if (pool && batch.count > 1) {
+		uint32_t task_count = MIN((uint32_t)pool->get_thread_count(), batch.count - 1);
+		for (uint32_t i = 0; i < task_count; i++) {
+			tasks.push_back(pool->add_native_task(&PCKPacker::_process_pending_files, &batch, false, SNAME("PCKPackerProcessFiles")));
+		}
+	}
+	_process_pending_files(&batch);
+	for (const WorkerThreadPool::TaskID &task : tasks) {
+		pool->wait_for_task_completion(task);
+	}
+
+	// Write them in the order they were added.
+	Error ret = OK;
+	for (PendingFile &pf : pending) {
+		Error err = pf.error;
+		if (err != OK) {
+			ERR_PRINT(vformat("Can't read file to pack: '%s'.", pf.src_path));
+		} else {
+			err = _write_file(pf);
+		}
+		if (err != OK && ret == OK) {
+			ret = err;
+		}
+		pf.data = Vector<uint8_t>();
+	}
+
+	pending.clear();
+	pending_size = 0;
+
+	return ret;
+}
+
+Error PCKPacker::_write_file(const PendingFile &p_file) {
+	File pf;
+	pf.path = p_file.path;
+	pf.src_path = p_file.src_path;
+	pf.ofs = file->get_position();
+	pf.size = p_file.data.size();
+	pf.encrypted = p_file.encrypted;
+	pf.removal = p_file.removal;
+	pf.md5.resize(16);
+	memcpy(pf.md5.ptrw(), p_file.md5, 16);
+
+	if (pf.removal) {
+		files.push_back(pf);
+		return OK;
+	}
+
+	// Encrypted and plain copies of the same content are different blobs.
+	String content_key = String::hex_encode_buffer(p_file.sha256, 32);
+	if (pf.encrypted) {
+		content_key += ":encrypted";
+	}
+
+	// Identical content was already written, share it.
+	const uint64_t *blob_ofs = content_blobs.getptr(content_key);
+	if (blob_ofs) {
+		pf.ofs = *blob_ofs;
+		files.push_back(pf);
+		return OK;
+	}
+
+	// Unchanged since the pack we're updating, point at the data already there.
+	const File *prev = previous_files.getptr(pf.path);
+	if (prev && prev->encrypted == pf.encrypted && prev->size == pf.size && prev->md5 == pf.md5) {
+		pf.ofs = prev->ofs;
+		content_blobs[content_key] = pf.ofs;
+		files.push_back(pf);
+		return OK;
 	}
-	pf.encrypted = p_encrypt;
 
 	Ref<FileAccess> ftmp = file;
 
 	Ref<FileAccessEncrypted> fae;
-	if (p_encrypt) {
+	if (pf.encrypted) {
 		fae.instantiate();
 		ERR_FAIL_COND_V(fae.is_null(), ERR_CANT_CREATE);
 
@@ -196,7 +428,7 @@ Error PCKPacker::_add_file(const String &p_target_path, const String &p_source_p
 		ftmp = fae;
 	}
 
-	ftmp->store_buffer(p_data);
+	ftmp->store_buffer(p_file.data);
 
 	if (fae.is_valid()) {
 		ftmp.unref();
@@ -208,6 +440,7 @@ Error PCKPacker::_add_file(const String &p_target_path, const String &p_source_p
 		file->store_8(0);
 	}
 
+	content_blobs[content_key] = pf.ofs;
 	files.push_back(pf);
 
 	return OK;
@@ -216,11 +449,12 @@ Error PCKPacker::_add_file(const String &p_target_path, const String &p_source_p
 Error PCKPacker::flush(bool p_verbose) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
+	Error pending_err = _flush_pending();
+
 	int dir_padding = _get_pad(alignment, file->get_position());
 	for (int i = 0; i < dir_padding; i++) {
 		file->store_8(0);
 	}
-
 	// Write directory.
 	uint64_t dir_offset = file->get_position();
 	file->seek(dir_base_ofs);
@@ -277,8 +511,17 @@ Error PCKPacker::flush(bool p_verbose) {
 		fae.unref();
 	}
 
+	if (incremental) {
+		// The new directory can be shorter than the previous one.
+		file->flush();
+		file->resize(file->get_position());
+	}
+
 	file.unref();
-	return OK;
+	previous_files.clear();
+	incremental = false;
+	content_blobs.clear();
+	return pending_err;
 }
 
 PCKPacker::~PCKPacker() {
@@ -31,6 +31,9 @@
 #pragma once
 
 #include "core/object/ref_counted.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 class FileAccess;
 
@@ -60,10 +63,48 @@ class PCKPacker : public RefCounted {
 	};
 	Vector<File> files;
 
-	Error _add_file(const String &p_target_path, const String &p_source_path, const Vector<uint8_t> &p_data, bool p_encrypt = false);
+	// Files are queued, read and hashed in parallel, then written in order.
+	struct PendingFile {
+		String path;
+		String src_path;
+		Vector<uint8_t> data; // Read from `src_path` unless added from a buffer.
+		uint64_t size = 0;
+		bool from_buffer = false;
+		bool encrypted = false;
+		bool removal = false;
+		uint8_t md5[16] = {};
+		uint8_t sha256[32] = {}; // Content address, used to store identical files once.
+		Error error = OK;
+	};
+	LocalVector<PendingFile> pending;
+	uint64_t pending_size = 0;
+
+	struct PendingBatch {
+		PendingFile *files = nullptr;
+		uint32_t count = 0;
+		SafeNumeric<uint32_t> next;
+	};
+
+	// Blobs of the pack reopened by pck_start_incremental(), by path. Unchanged files point back at them.
+	HashMap<String, File> previous_files;
+	bool incremental = false;
+
+	// Offsets of the data written so far, by content hash.
+	HashMap<String, uint64_t> content_blobs;
+
+	Error _start(int p_alignment, const String &p_key, bool p_encrypt_directory);
+	void _store_header();
+	Error _read_previous_directory(uint64_t &r_dir_offset);
+
+	static void _process_pending_files(void *p_userdata);
+	Error _flush_pending();
+	Error _write_file(const PendingFile &p_file);
+
+	Error _add_file(const String &p_target_path, const String &p_source_path, const Vector<uint8_t> &p_data, uint64_t p_size, bool p_from_buffer, bool p_encrypt = false);
 
 public:
 	Error pck_start(const String &p_pck_path, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
+	Error pck_start_incremental(const String &p_pck_path, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
 	Error add_file(const String &p_target_path, const String &p_source_path, bool p_encrypt = false);
 	Error add_file_from_buffer(const String &p_target_path, const Vector<uint8_t> &p_data, bool p_encrypt = false);
 	Error add_file_removal(const String &p_target_path);
@@ -1574,38 +1574,23 @@ bool ClassDB::set_property(Object *p_object, const StringName &p_property, const
 	while (check) {
 		const PropertySetGet *psg = check->property_setget.getptr(p_property);
 		if (psg) {
-			if (!psg->setter) {
-				if (r_valid) {
-					*r_valid = false;
-				}
-				return true; //return true but do nothing
-			}
-
-			Callable::CallError ce;
-
-			if (psg->index >= 0) {
-				Variant index = psg->index;
-				const Variant *arg[2] = { &index, &p_value };
-				//p_object->call(psg->setter,arg,2,ce);
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 2, ce);
-				} else {
-					p_object->callp(psg->setter, arg, 2, ce);
-				}
+			set_property_with_setget(p_object, *psg, p_value, r_valid);
+			return true;
+		}
 
-			} else {
-				const Variant *arg[1] = { &p_value };
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 1, ce);
-				} else {
-					p_object->callp(psg->setter, arg, 1, ce);
-				}
-			}
+		check = check->inherits_ptr;
+	}
 
-			if (r_valid) {
-				*r_valid = ce.error == Callable::CallError::CALL_OK;
-			}
+	return false;
+}
 
+bool ClassDB::get_property_setget(const StringName &p_class, const StringName &p_property, PropertySetGet &r_setget) {
+	ClassInfo *type = classes.getptr(p_class);
+	ClassInfo *check = type;
+	while (check) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+			r_setget = *psg;
 			return true;
 		}
 
@@ -1615,6 +1600,47 @@ bool ClassDB::set_property(Object *p_object, const StringName &p_property, const
 	return false;
 }
 
+void ClassDB::set_property_with_setget(Object *p_object, const PropertySetGet &p_setget, const Variant &p_value, bool *r_valid) {
+	ERR_FAIL_NULL(p_object);
+
+#ifdef TOOLS_ENABLED
+	// Same as Object::set(), for callers that resolve the setter themselves.
+	p_object->_edited = true;
+#endif
+
+	if (!p_setget.setter) {
+		if (r_valid) {
+			*r_valid = false;
+		}
+		return; //do nothing
+	}
+
+	Callable::CallError ce;
+
+	if (p_setget.index >= 0) {
+		Variant index = p_setget.index;
+		const Variant *arg[2] = { &index, &p_value };
+		//p_object->call(psg->setter,arg,2,ce);
+		if (p_setget._setptr) {
+			p_setget._setptr->call(p_object, arg, 2, ce);
+		} else {
+			p_object->callp(p_setget.setter, arg, 2, ce);
+		}
+
+	} else {
+		const Variant *arg[1] = { &p_value };
+		if (p_setget._setptr) {
+			p_setget._setptr->call(p_object, arg, 1, ce);
+		} else {
+			p_object->callp(p_setget.setter, arg, 1, ce);
+		}
+	}
+
+	if (r_valid) {
+		*r_valid = ce.error == Callable::CallError::CALL_OK;
+	}
+}
+
 bool ClassDB::get_property(Object *p_object, const StringName &p_property, Variant &r_value) {
 	ERR_FAIL_NULL_V(p_object, false);
 
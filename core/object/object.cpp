@@ -794,22 +794,8 @@ Variant Object::callp(const StringName &p_method, const Variant **p_args, int p_
 	Variant ret;
 	OBJ_DEBUG_LOCK
 
-	if (script_instance) {
-		ret = script_instance->callp(p_method, p_args, p_argcount, r_error);
-		// Force jump table.
-		switch (r_error.error) {
-			case Callable::CallError::CALL_OK:
-				return ret;
-			case Callable::CallError::CALL_ERROR_INVALID_METHOD:
-				break;
-			case Callable::CallError::CALL_ERROR_INVALID_ARGUMENT:
-			case Callable::CallError::CALL_ERROR_TOO_MANY_ARGUMENTS:
-			case Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS:
-			case Callable::CallError::CALL_ERROR_METHOD_NOT_CONST:
-				return ret;
-			case Callable::CallError::CALL_ERROR_INSTANCE_IS_NULL: {
-			}
-		}
+	if (script_instance && _callp_script_instance(p_method, p_args, p_argcount, r_error, ret)) {
+		return ret;
 	}
 
 	//extension does not need this, because all methods are registered in MethodBind
@@ -825,6 +811,48 @@ Variant Object::callp(const StringName &p_method, const Variant **p_args, int p_
 	return ret;
 }
 
+Variant Object::callp_with_method_bind(MethodBind *p_method_bind, const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
+	if (p_method == CoreStringName(free_)) {
+		return callp(p_method, p_args, p_argcount, r_error);
+	}
+
+	r_error.error = Callable::CallError::CALL_OK;
+
+	Variant ret;
+	OBJ_DEBUG_LOCK
+
+	if (script_instance && _callp_script_instance(p_method, p_args, p_argcount, r_error, ret)) {
+		return ret;
+	}
+
+	if (p_method_bind) {
+		ret = p_method_bind->call(this, p_args, p_argcount, r_error);
+	} else {
+		r_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
+	}
+
+	return ret;
+}
+
+bool Object::_callp_script_instance(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error, Variant &r_ret) {
+	r_ret = script_instance->callp(p_method, p_args, p_argcount, r_error);
+	// Force jump table.
+	switch (r_error.error) {
+		case Callable::CallError::CALL_OK:
+			return true;
+		case Callable::CallError::CALL_ERROR_INVALID_METHOD:
+			break;
+		case Callable::CallError::CALL_ERROR_INVALID_ARGUMENT:
+		case Callable::CallError::CALL_ERROR_TOO_MANY_ARGUMENTS:
+		case Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS:
+		case Callable::CallError::CALL_ERROR_METHOD_NOT_CONST:
+			return true;
+		case Callable::CallError::CALL_ERROR_INSTANCE_IS_NULL: {
+		}
+	}
+	return false;
+}
+
 Variant Object::call_const(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
 	r_error.error = Callable::CallError::CALL_OK;
 
@@ -1169,19 +1197,66 @@ Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::Cal
 	return emit_signalp(signal, args, argc);
 }
 
+struct Object::SignalTargets {
+	struct Target {
+		Callable callable;
+		// Native method of a method callable, resolved for the class of its object. Script methods still take precedence when calling it.
+		MethodBind *method_bind = nullptr;
+		uint32_t flags = 0;
+	};
+
+	SafeRefCount refcount;
+	LocalVector<Target> targets;
+
+	static SignalTargets *create(const HashMap<Callable, SignalData::Slot> &p_slot_map) {
+		SignalTargets *signal_targets = memnew(SignalTargets);
+		signal_targets->refcount.init();
+		signal_targets->targets.resize(p_slot_map.size());
+
+		uint32_t idx = 0;
+		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : p_slot_map) {
+			Target &target = signal_targets->targets[idx++];
+			target.callable = slot_kv.value.conn.callable;
+			target.flags = slot_kv.value.conn.flags;
+			if (target.callable.is_standard()) {
+				Object *object = target.callable.get_object();
+				// Extension methods can be replaced when reloading, keep looking them up.
+				if (object && !object->_extension) {
+					target.method_bind = ClassDB::get_method(object->get_class_name(), target.callable.get_method());
+				}
+			}
+		}
+		return signal_targets;
+	}
+
+	static void unref(SignalTargets *p_targets) {
+		if (p_targets->refcount.unref()) {
+			memdelete(p_targets);
+		}
+	}
+};
+
+void Object::SignalData::invalidate_targets() {
+	if (targets) {
+		SignalTargets::unref(targets);
+		targets = nullptr;
+	}
+}
+
+Object::SignalData &Object::SignalData::operator=(const SignalData &p_other) {
+	invalidate_targets();
+	user = p_other.user;
+	slot_map = p_other.slot_map;
+	removable = p_other.removable;
+	return *this;
+}
+
 Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount) {
 	if (_block_signals) {
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
 	}
 
-	constexpr int MAX_SLOTS_ON_STACK = 5;
-	// Don't default initialize the Callable objects on the stack, just reserve the space - we'll memnew_placement() them later.
-	alignas(Callable) uint8_t slot_callable_stack[sizeof(Callable) * MAX_SLOTS_ON_STACK];
-	uint32_t slot_flags_stack[MAX_SLOTS_ON_STACK];
-
-	Callable *slot_callables = (Callable *)slot_callable_stack;
-	uint32_t *slot_flags = slot_flags_stack;
-	uint32_t slot_count = 0;
+	SignalTargets *targets = nullptr;
 
 	{
 		ObjectSignalLock signal_lock(this);
@@ -1197,33 +1272,27 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 			return ERR_UNAVAILABLE;
 		}
 
-		if (s->slot_map.size() > MAX_SLOTS_ON_STACK) {
-			slot_callables = (Callable *)memalloc(sizeof(Callable) * s->slot_map.size());
-			slot_flags = (uint32_t *)memalloc(sizeof(uint32_t) * s->slot_map.size());
+		if (!s->targets) {
+			s->targets = SignalTargets::create(s->slot_map);
 		}
 
 		// Ensure that disconnecting the signal or even deleting the object
 		// will not affect the signal calling.
-		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-			memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-			slot_flags[slot_count] = slot_kv.value.conn.flags;
-			++slot_count;
-		}
-
-		DEV_ASSERT(slot_count == s->slot_map.size());
+		targets = s->targets;
+		targets->refcount.ref();
 	}
 
 	// Disconnect all one-shot connections before emitting to prevent recursion.
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
+	for (const SignalTargets::Target &target : targets->targets) {
+		bool disconnect = target.flags & CONNECT_ONE_SHOT;
 #ifdef TOOLS_ENABLED
-		if (disconnect && (slot_flags[i] & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+		if (disconnect && (target.flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
 			// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
 			disconnect = false;
 		}
 #endif
 		if (disconnect) {
-			_disconnect(p_name, slot_callables[i]);
+			_disconnect(p_name, target.callable);
 		}
 	}
 
@@ -1241,11 +1310,20 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 	Vector<const Variant *> append_source_mem;
 	Variant source = this;
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		const Callable &callable = slot_callables[i];
-		const uint32_t &flags = slot_flags[i];
-
-		if (!callable.is_valid()) {
+	for (const SignalTargets::Target &target : targets->targets) {
+		const Callable &callable = target.callable;
+		const uint32_t &flags = target.flags;
+
+		// Method callables resolved to a native method only need their object to still exist,
+		// others are checked the regular way.
+		Object *target_object = nullptr;
+		if (target.method_bind) {
+			target_object = ObjectDB::get_instance(callable.get_object_id());
+			if (!target_object) {
+				// Target might have been deleted during signal callback, this is expected and OK.
+				continue;
+			}
+		} else if (!callable.is_valid()) {
 			// Target might have been deleted during signal callback, this is expected and OK.
 			continue;
 		}
@@ -1283,8 +1361,12 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		} else {
 			Callable::CallError ce;
 			_emitting = true;
-			Variant ret;
-			callable.callp(args, argc, ret, ce);
+			if (target_object) {
+				target_object->callp_with_method_bind(target.method_bind, callable.get_method(), args, argc, ce);
+			} else {
+				Variant ret;
+				callable.callp(args, argc, ret, ce);
+			}
 			_emitting = false;
 
 			if (ce.error != Callable::CallError::CALL_OK) {
@@ -1308,14 +1390,7 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
-	}
-
-	if (slot_callables != (Callable *)slot_callable_stack) {
-		memfree(slot_callables);
-		memfree(slot_flags);
-	}
+	SignalTargets::unref(targets);
 
 	if (pending_unref) {
 		// We have to do the same Ref<T> would do. We can't just use Ref<T>
@@ -1572,6 +1647,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
+	s->invalidate_targets();
 
 	return OK;
 }
@@ -1650,6 +1726,7 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
+	s->invalidate_targets();
 
 	if (s->slot_map.is_empty() && get_gdtype().get_signal_map(false).has(p_signal)) {
 		//not user signal, delete
@@ -2375,8 +2452,9 @@ void ObjectDB::debug_objects(DebugFunc p_func, void *p_user_data) {
 	spin_lock.lock();
 
 	for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-		if (object_slots[i].validator) {
-			p_func(object_slots[i].object, p_user_data);
+		const ObjectSlot &object_slot = _get_slot(i);
+		if (object_slot.validator.load(std::memory_order_relaxed)) {
+			p_func(object_slot.object.load(std::memory_order_relaxed), p_user_data);
 			count--;
 		}
 	}
@@ -2432,7 +2510,7 @@ void Object::get_argument_options(const StringName &p_function, int p_idx, List<
 SpinLock ObjectDB::spin_lock;
 uint32_t ObjectDB::slot_count = 0;
 uint32_t ObjectDB::slot_max = 0;
-ObjectDB::ObjectSlot *ObjectDB::object_slots = nullptr;
+std::atomic<ObjectDB::ObjectSlot *> ObjectDB::object_slot_chunks[OBJECTDB_SLOT_CHUNK_MAX_COUNT] = {};
 uint64_t ObjectDB::validator_counter = 0;
 
 int ObjectDB::get_object_count() {
@@ -2444,29 +2522,28 @@ ObjectID ObjectDB::add_instance(Object *p_object) {
 	if (unlikely(slot_count == slot_max)) {
 		CRASH_COND(slot_count == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
 
-		uint32_t new_slot_max = slot_max > 0 ? slot_max * 2 : 1;
-		object_slots = (ObjectSlot *)memrealloc(object_slots, sizeof(ObjectSlot) * new_slot_max);
-		for (uint32_t i = slot_max; i < new_slot_max; i++) {
-			object_slots[i].object = nullptr;
-			object_slots[i].is_ref_counted = false;
-			object_slots[i].next_free = i;
-			object_slots[i].validator = 0;
+		ObjectSlot *chunk = (ObjectSlot *)memalloc(sizeof(ObjectSlot) * OBJECTDB_SLOT_CHUNK_SIZE);
+		for (uint32_t i = 0; i < OBJECTDB_SLOT_CHUNK_SIZE; i++) {
+			memnew_placement(&chunk[i], ObjectSlot);
+			chunk[i].next_free = slot_max + i;
 		}
-		slot_max = new_slot_max;
+		object_slot_chunks[slot_max >> OBJECTDB_SLOT_CHUNK_BITS].store(chunk, std::memory_order_release);
+		slot_max += OBJECTDB_SLOT_CHUNK_SIZE;
 	}
 
-	uint32_t slot = object_slots[slot_count].next_free;
-	if (object_slots[slot].object != nullptr) {
+	uint32_t slot = _get_slot(slot_count).next_free;
+	ObjectSlot &object_slot = _get_slot(slot);
+	if (object_slot.object.load(std::memory_order_relaxed) != nullptr) {
 		spin_lock.unlock();
-		ERR_FAIL_COND_V(object_slots[slot].object != nullptr, ObjectID());
+		ERR_FAIL_COND_V(object_slot.object.load(std::memory_order_relaxed) != nullptr, ObjectID());
 	}
-	object_slots[slot].object = p_object;
-	object_slots[slot].is_ref_counted = p_object->is_ref_counted();
+	object_slot.object.store(p_object, std::memory_order_release);
+	object_slot.is_ref_counted = p_object->is_ref_counted();
 	validator_counter = (validator_counter + 1) & OBJECTDB_VALIDATOR_MASK;
 	if (unlikely(validator_counter == 0)) {
 		validator_counter = 1;
 	}
-	object_slots[slot].validator = validator_counter;
+	object_slot.validator.store(validator_counter, std::memory_order_release);
 
 	uint64_t id = validator_counter;
 	id <<= OBJECTDB_SLOT_MAX_COUNT_BITS;
@@ -2489,17 +2566,19 @@ void ObjectDB::remove_instance(Object *p_object) {
 
 	spin_lock.lock();
 
+	ObjectSlot &object_slot = _get_slot(slot);
+
 #ifdef DEBUG_ENABLED
 
-	if (object_slots[slot].object != p_object) {
+	if (object_slot.object.load(std::memory_order_relaxed) != p_object) {
 		spin_lock.unlock();
-		ERR_FAIL_COND(object_slots[slot].object != p_object);
+		ERR_FAIL_COND(object_slot.object.load(std::memory_order_relaxed) != p_object);
 	}
 	{
 		uint64_t validator = (t >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
-		if (object_slots[slot].validator != validator) {
+		if (object_slot.validator.load(std::memory_order_relaxed) != validator) {
 			spin_lock.unlock();
-			ERR_FAIL_COND(object_slots[slot].validator != validator);
+			ERR_FAIL_COND(object_slot.validator.load(std::memory_order_relaxed) != validator);
 		}
 	}
 
@@ -2507,11 +2586,11 @@ void ObjectDB::remove_instance(Object *p_object) {
 	//decrease slot count
 	slot_count--;
 	//set the free slot properly
-	object_slots[slot_count].next_free = slot;
+	_get_slot(slot_count).next_free = slot;
 	//invalidate, so checks against it fail
-	object_slots[slot].validator = 0;
-	object_slots[slot].is_ref_counted = false;
-	object_slots[slot].object = nullptr;
+	object_slot.validator.store(0, std::memory_order_release);
+	object_slot.is_ref_counted = false;
+	object_slot.object.store(nullptr, std::memory_order_release);
 
 	spin_lock.unlock();
 }
@@ -2534,8 +2613,10 @@ void ObjectDB::cleanup() {
 			Callable::CallError call_error;
 
 			for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-				if (object_slots[i].validator) {
-					Object *obj = object_slots[i].object;
+				const ObjectSlot &object_slot = _get_slot(i);
+				const uint64_t validator = object_slot.validator.load(std::memory_order_relaxed);
+				if (validator) {
+					Object *obj = object_slot.object.load(std::memory_order_relaxed);
 
 					String extra_info;
 					if (obj->is_class("Node")) {
@@ -2548,7 +2629,7 @@ void ObjectDB::cleanup() {
 						extra_info = " - Reference count: " + itos((static_cast<RefCounted *>(obj))->get_reference_count());
 					}
 
-					uint64_t id = uint64_t(i) | (uint64_t(object_slots[i].validator) << OBJECTDB_SLOT_MAX_COUNT_BITS) | (object_slots[i].is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
+					uint64_t id = uint64_t(i) | (validator << OBJECTDB_SLOT_MAX_COUNT_BITS) | (object_slot.is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
 					DEV_ASSERT(id == (uint64_t)obj->get_instance_id()); // We could just use the id from the object, but this check may help catching memory corruption catastrophes.
 					print_line("Leaked instance: " + String(obj->get_class()) + ":" + uitos(id) + extra_info);
 
@@ -2559,9 +2640,14 @@ void ObjectDB::cleanup() {
 		}
 	}
 
-	if (object_slots) {
-		memfree(object_slots);
+	for (uint32_t i = 0; i < slot_max; i += OBJECTDB_SLOT_CHUNK_SIZE) {
+		ObjectSlot *chunk = object_slot_chunks[i >> OBJECTDB_SLOT_CHUNK_BITS].exchange(nullptr);
+		for (uint32_t j = 0; j < OBJECTDB_SLOT_CHUNK_SIZE; j++) {
+			chunk[j].~ObjectSlot();
+		}
+		memfree(chunk);
 	}
+	slot_max = 0;
 
 	spin_lock.unlock();
 }
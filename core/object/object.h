@@ -414,6 +414,9 @@ private:
 	ObjectGDExtension *_extension = nullptr;
 	GDExtensionClassInstancePtr _extension_instance = nullptr;
 
+	// Snapshot of the connections of a signal, as called when emitting.
+	struct SignalTargets;
+
 	struct SignalData {
 		struct Slot {
 			int reference_count = 0;
@@ -423,7 +426,17 @@ private:
 
 		MethodInfo user;
 		HashMap<Callable, Slot> slot_map;
+		// Built on emission from slot_map, and shared with emissions in progress. Dropped when connections change.
+		SignalTargets *targets = nullptr;
 		bool removable = false;
+
+		void invalidate_targets();
+
+		SignalData() {}
+		SignalData(const SignalData &p_other) :
+				user(p_other.user), slot_map(p_other.slot_map), removable(p_other.removable) {}
+		SignalData &operator=(const SignalData &p_other);
+		~SignalData() { invalidate_targets(); }
 	};
 	mutable Mutex *signal_mutex = nullptr;
 	HashMap<StringName, SignalData> signal_map;
@@ -436,6 +449,8 @@ private:
 	void _initialize();
 	void _postinitialize();
 
+	bool _callp_script_instance(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error, Variant &r_ret);
+
 	uint32_t _ancestry : 15;
 
 	bool _block_signals : 1;
@@ -707,6 +722,9 @@ public:
 	Variant callv(const StringName &p_method, const Array &p_args);
 	virtual Variant callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	virtual Variant call_const(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+	// Like callp(), with the native method already looked up through ClassDB::get_method() for this object's class (or null if it has none).
+	// Allows calling the same method on many objects of one class while resolving it only once.
+	Variant callp_with_method_bind(MethodBind *p_method_bind, const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 
 	template <typename... VarArgs>
 	Variant call(const StringName &p_method, VarArgs... p_args) {
@@ -883,20 +901,32 @@ class ObjectDB {
 #define OBJECTDB_SLOT_MAX_COUNT_BITS 24
 #define OBJECTDB_SLOT_MAX_COUNT_MASK ((uint64_t(1) << OBJECTDB_SLOT_MAX_COUNT_BITS) - 1)
 #define OBJECTDB_REFERENCE_BIT (uint64_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS + OBJECTDB_VALIDATOR_BITS))
-
-	struct ObjectSlot { // 128 bits per slot.
-		uint64_t validator : OBJECTDB_VALIDATOR_BITS;
-		uint64_t next_free : OBJECTDB_SLOT_MAX_COUNT_BITS;
-		uint64_t is_ref_counted : 1;
-		Object *object = nullptr;
+// Slots are allocated in chunks which are never moved nor freed before exit, so they can be looked up without locking.
+#define OBJECTDB_SLOT_CHUNK_BITS 12
+#define OBJECTDB_SLOT_CHUNK_SIZE (uint32_t(1) << OBJECTDB_SLOT_CHUNK_BITS)
+#define OBJECTDB_SLOT_CHUNK_MASK (OBJECTDB_SLOT_CHUNK_SIZE - 1)
+#define OBJECTDB_SLOT_CHUNK_MAX_COUNT (uint32_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS - OBJECTDB_SLOT_CHUNK_BITS))
+
+	struct ObjectSlot {
+		// Written with the lock held, read without it. The validator is zero while the slot is free.
+		// It is set after the object when adding, and cleared before it when removing.
+		std::atomic<uint64_t> validator = 0;
+		std::atomic<Object *> object = nullptr;
+		// Only accessed with the lock held.
+		uint32_t next_free = 0;
+		bool is_ref_counted = false;
 	};
 
 	static SpinLock spin_lock;
 	static uint32_t slot_count;
 	static uint32_t slot_max;
-	static ObjectSlot *object_slots;
+	static std::atomic<ObjectSlot *> object_slot_chunks[OBJECTDB_SLOT_CHUNK_MAX_COUNT];
 	static uint64_t validator_counter;
 
+	_FORCE_INLINE_ static ObjectSlot &_get_slot(uint32_t p_slot) {
+		return object_slot_chunks[p_slot >> OBJECTDB_SLOT_CHUNK_BITS].load(std::memory_order_relaxed)[p_slot & OBJECTDB_SLOT_CHUNK_MASK];
+	}
+
 	friend class Object;
 	friend void unregister_core_types();
 	static void cleanup();
@@ -914,20 +944,22 @@ public:
 		uint64_t id = p_instance_id;
 		uint32_t slot = id & OBJECTDB_SLOT_MAX_COUNT_MASK;
 
-		ERR_FAIL_COND_V(slot >= slot_max, nullptr); // This should never happen unless RID is corrupted.
-
-		spin_lock.lock();
+		ObjectSlot *chunk = object_slot_chunks[slot >> OBJECTDB_SLOT_CHUNK_BITS].load(std::memory_order_acquire);
+		ERR_FAIL_NULL_V(chunk, nullptr); // This should never happen unless RID is corrupted.
+		const ObjectSlot &object_slot = chunk[slot & OBJECTDB_SLOT_CHUNK_MASK];
 
 		uint64_t validator = (id >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
 
-		if (unlikely(object_slots[slot].validator != validator)) {
-			spin_lock.unlock();
+		if (unlikely(object_slot.validator.load(std::memory_order_acquire) != validator)) {
 			return nullptr;
 		}
 
-		Object *object = object_slots[slot].object;
+		Object *object = object_slot.object.load(std::memory_order_acquire);
 
-		spin_lock.unlock();
+		// The object may have been removed, and the slot reused, while reading it.
+		if (unlikely(object_slot.validator.load(std::memory_order_relaxed) != validator)) {
+			return nullptr;
+		}
 
 		return object;
 	}
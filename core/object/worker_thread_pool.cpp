@@ -882,6 +882,7 @@ void WorkerThreadPool::finish() {
 	}
 
 	threads.clear();
+	thread_ids.clear();
 }
 
 void WorkerThreadPool::_bind_methods() {
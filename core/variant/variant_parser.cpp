@@ -549,6 +549,113 @@ Error VariantParser::_parse_enginecfg(Stream *p_stream, Vector<String> &r_string
 	}
 }
 
+// Returns the next non-blank character in a constructor, skipping comments the same way get_token() does.
+// Returns 0 on EOF.
+static char32_t _get_construct_char(VariantParser::Stream *p_stream, int &r_line) {
+	while (true) {
+		char32_t c;
+		if (p_stream->saved) {
+			c = p_stream->saved;
+			p_stream->saved = 0;
+		} else {
+			c = p_stream->get_char();
+			if (p_stream->is_eof()) {
+				return 0;
+			}
+		}
+
+		if (c == '\n') {
+			r_line++;
+		} else if (c == ';') {
+			while (true) {
+				char32_t ch = p_stream->get_char();
+				if (p_stream->is_eof()) {
+					return 0;
+				}
+				if (ch == '\n') {
+					r_line++;
+					break;
+				}
+			}
+		} else if (c == 0 || c > 32) {
+			return c;
+		}
+	}
+}
+
+// Reads a number starting with p_char, following the same rules as get_token(), or one of
+// the identifiers accepted by stor_fix().
+static bool _parse_construct_number(VariantParser::Stream *p_stream, char32_t p_char, bool &r_is_float, int64_t &r_int, double &r_float) {
+	StringBuffer<> text;
+	char32_t c = p_char;
+	if (c == '-') {
+		text += '-';
+		c = p_stream->get_char();
+	}
+
+	if (is_digit(c)) {
+		bool reading_int = true;
+		bool reading_exp = false;
+		bool exp_sign = false;
+		bool exp_beg = false;
+		r_is_float = false;
+
+		while (true) {
+			if (reading_exp) {
+				if (is_digit(c)) {
+					exp_beg = true;
+				} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
+					exp_sign = true;
+				} else {
+					break;
+				}
+			} else if (!is_digit(c)) {
+				if (c == '.' && reading_int) {
+					reading_int = false;
+					r_is_float = true;
+				} else if (c == 'e' || c == 'E') {
+					reading_exp = true;
+					r_is_float = true;
+				} else {
+					break;
+				}
+			}
+			text += c;
+			c = p_stream->get_char();
+		}
+
+		p_stream->saved = c;
+
+		if (r_is_float) {
+			r_float = text.as_double();
+		} else {
+			r_int = text.as_int();
+		}
+		return true;
+	}
+
+	if (is_ascii_alphabet_char(c) || is_underscore(c)) {
+		bool first = true;
+		while (is_ascii_alphabet_char(c) || is_underscore(c) || (!first && is_digit(c))) {
+			text += c;
+			c = p_stream->get_char();
+			first = false;
+		}
+
+		p_stream->saved = c;
+
+		double real = stor_fix(text.as_string());
+		if (real == -1) {
+			return false;
+		}
+		r_is_float = true;
+		r_float = real;
+		return true;
+	}
+
+	return false;
+}
+
 template <typename T>
 Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct, int &r_line, String &r_err_str) {
 	Token token;
@@ -558,40 +665,33 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 		return ERR_PARSE_ERROR;
 	}
 
+	// Elements are read directly from the stream instead of going through get_token(), as this is
+	// the hot path for packed arrays and building a token for every number is comparatively slow.
 	bool first = true;
 	while (true) {
+		char32_t c = _get_construct_char(p_stream, r_line);
 		if (!first) {
-			get_token(p_stream, token, r_line, r_err_str);
-			if (token.type == TK_COMMA) {
-				//do none
-			} else if (token.type == TK_PARENTHESIS_CLOSE) {
+			if (c == ',') {
+				c = _get_construct_char(p_stream, r_line);
+			} else if (c == ')') {
 				break;
 			} else {
 				r_err_str = "Expected ',' or ')' in constructor";
 				return ERR_PARSE_ERROR;
 			}
+		} else if (c == ')') {
+			break;
 		}
-		get_token(p_stream, token, r_line, r_err_str);
 
-		if (first && token.type == TK_PARENTHESIS_CLOSE) {
-			break;
-		} else if (token.type != TK_NUMBER) {
-			bool valid = false;
-			if (token.type == TK_IDENTIFIER) {
-				double real = stor_fix(token.value);
-				if (real != -1) {
-					token.type = TK_NUMBER;
-					token.value = real;
-					valid = true;
-				}
-			}
-			if (!valid) {
-				r_err_str = "Expected float in constructor";
-				return ERR_PARSE_ERROR;
-			}
+		bool is_float = false;
+		int64_t int_value = 0;
+		double float_value = 0.0;
+		if (!_parse_construct_number(p_stream, c, is_float, int_value, float_value)) {
+			r_err_str = "Expected float in constructor";
+			return ERR_PARSE_ERROR;
 		}
 
-		r_construct.push_back(token.value);
+		r_construct.push_back(is_float ? (T)float_value : (T)int_value);
 		first = false;
 	}
 
@@ -631,37 +731,43 @@ Error VariantParser::_parse_byte_array(Stream *p_stream, Vector<uint8_t> &r_cons
 
 	} else if (token.type == TK_NUMBER || token.type == TK_IDENTIFIER) {
 		// Individual elements.
-		while (true) {
-			if (token.type != TK_NUMBER) {
-				bool valid = false;
-				if (token.type == TK_IDENTIFIER) {
-					double real = stor_fix(token.value);
-					if (real != -1) {
-						token.type = TK_NUMBER;
-						token.value = real;
-						valid = true;
-					}
-				}
-				if (!valid) {
-					r_err_str = "Expected number in constructor";
-					return ERR_PARSE_ERROR;
+		if (token.type != TK_NUMBER) {
+			bool valid = false;
+			if (token.type == TK_IDENTIFIER) {
+				double real = stor_fix(token.value);
+				if (real != -1) {
+					token.type = TK_NUMBER;
+					token.value = real;
+					valid = true;
 				}
 			}
+			if (!valid) {
+				r_err_str = "Expected number in constructor";
+				return ERR_PARSE_ERROR;
+			}
+		}
 
-			r_construct.push_back(token.value);
-
-			get_token(p_stream, token, r_line, r_err_str);
+		r_construct.push_back(token.value);
 
-			if (token.type == TK_COMMA) {
-				//do none
-			} else if (token.type == TK_PARENTHESIS_CLOSE) {
+		// The remaining elements are read directly from the stream, see _parse_construct().
+		while (true) {
+			char32_t c = _get_construct_char(p_stream, r_line);
+			if (c == ')') {
 				break;
-			} else {
+			} else if (c != ',') {
 				r_err_str = "Expected ',' or ')' in constructor";
 				return ERR_PARSE_ERROR;
 			}
 
-			get_token(p_stream, token, r_line, r_err_str);
+			bool is_float = false;
+			int64_t int_value = 0;
+			double float_value = 0.0;
+			if (!_parse_construct_number(p_stream, _get_construct_char(p_stream, r_line), is_float, int_value, float_value)) {
+				r_err_str = "Expected number in constructor";
+				return ERR_PARSE_ERROR;
+			}
+
+			r_construct.push_back(is_float ? (uint8_t)float_value : (uint8_t)int_value);
 		}
 	} else if (token.type == TK_PARENTHESIS_CLOSE) {
 		// Empty array.
@@ -1415,17 +1521,7 @@ Error VariantParser::parse_value(Token &r_token, Variant &r_value, Stream *p_str
 				return err;
 			}
 
-			Vector<uint8_t> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				uint8_t *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
-			r_value = arr;
+			r_value = args;
 		} else if (id == "PackedInt32Array" || id == "PackedIntArray" || id == "PoolIntArray" || id == "IntArray") {
 			Vector<int32_t> args;
 			Error err = _parse_construct<int32_t>(p_stream, args, r_line, r_err_str);
@@ -1433,17 +1529,7 @@ Error VariantParser::parse_value(Token &r_token, Variant &r_value, Stream *p_str
 				return err;
 			}
 
-			Vector<int32_t> arr;
-			{
-				int32_t len = args.size();
-				arr.resize(len);
-				int32_t *w = arr.ptrw();
-				for (int32_t i = 0; i < len; i++) {
-					w[i] = int32_t(args[i]);
-				}
-			}
-
-			r_value = arr;
+			r_value = args;
 		} else if (id == "PackedInt64Array") {
 			Vector<int64_t> args;
 			Error err = _parse_construct<int64_t>(p_stream, args, r_line, r_err_str);
@@ -1451,17 +1537,7 @@ Error VariantParser::parse_value(Token &r_token, Variant &r_value, Stream *p_str
 				return err;
 			}
 
-			Vector<int64_t> arr;
-			{
-				int64_t len = args.size();
-				arr.resize(len);
-				int64_t *w = arr.ptrw();
-				for (int64_t i = 0; i < len; i++) {
-					w[i] = int64_t(args[i]);
-				}
-			}
-
-			r_value = arr;
+			r_value = args;
 		} else if (id == "PackedFloat32Array" || id == "PackedRealArray" || id == "PoolRealArray" || id == "FloatArray") {
 			Vector<float> args;
 			Error err = _parse_construct<float>(p_stream, args, r_line, r_err_str);
@@ -1469,17 +1545,7 @@ Error VariantParser::parse_value(Token &r_token, Variant &r_value, Stream *p_str
 				return err;
 			}
 
-			Vector<float> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				float *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
-			r_value = arr;
+			r_value = args;
 		} else if (id == "PackedFloat64Array") {
 			Vector<double> args;
 			Error err = _parse_construct<double>(p_stream, args, r_line, r_err_str);
@@ -1487,17 +1553,7 @@ Error VariantParser::parse_value(Token &r_token, Variant &r_value, Stream *p_str
 				return err;
 			}
 
-			Vector<double> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				double *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
-			r_value = arr;
+			r_value = args;
 		} else if (id == "PackedStringArray" || id == "PoolStringArray" || id == "StringArray") {
 			get_token(p_stream, r_token, r_line, r_err_str);
 			if (r_token.type != TK_PARENTHESIS_OPEN) {
@@ -1556,8 +1612,9 @@ Error VariantParser::parse_value(Token &r_token, Variant &r_value, Stream *p_str
 				int len = args.size() / 2;
 				arr.resize(len);
 				Vector2 *w = arr.ptrw();
+				const real_t *r = args.ptr();
 				for (int i = 0; i < len; i++) {
-					w[i] = Vector2(args[i * 2 + 0], args[i * 2 + 1]);
+					w[i] = Vector2(r[i * 2 + 0], r[i * 2 + 1]);
 				}
 			}
 
@@ -1574,8 +1631,9 @@ Error VariantParser::parse_value(Token &r_token, Variant &r_value, Stream *p_str
 				int len = args.size() / 3;
 				arr.resize(len);
 				Vector3 *w = arr.ptrw();
+				const real_t *r = args.ptr();
 				for (int i = 0; i < len; i++) {
-					w[i] = Vector3(args[i * 3 + 0], args[i * 3 + 1], args[i * 3 + 2]);
+					w[i] = Vector3(r[i * 3 + 0], r[i * 3 + 1], r[i * 3 + 2]);
 				}
 			}
 
@@ -1592,8 +1650,9 @@ Error VariantParser::parse_value(Token &r_token, Variant &r_value, Stream *p_str
 				int len = args.size() / 4;
 				arr.resize(len);
 				Vector4 *w = arr.ptrw();
+				const real_t *r = args.ptr();
 				for (int i = 0; i < len; i++) {
-					w[i] = Vector4(args[i * 4 + 0], args[i * 4 + 1], args[i * 4 + 2], args[i * 4 + 3]);
+					w[i] = Vector4(r[i * 4 + 0], r[i * 4 + 1], r[i * 4 + 2], r[i * 4 + 3]);
 				}
 			}
 
@@ -1610,8 +1669,9 @@ Error VariantParser::parse_value(Token &r_token, Variant &r_value, Stream *p_str
 				int len = args.size() / 4;
 				arr.resize(len);
 				Color *w = arr.ptrw();
+				const float *r = args.ptr();
 				for (int i = 0; i < len; i++) {
-					w[i] = Color(args[i * 4 + 0], args[i * 4 + 1], args[i * 4 + 2], args[i * 4 + 3]);
+					w[i] = Color(r[i * 4 + 0], r[i * 4 + 1], r[i * 4 + 2], r[i * 4 + 3]);
 				}
 			}
 
@@ -1999,6 +2059,30 @@ static String rtos_fix(double p_value, bool p_compat) {
 	return String::num_scientific(p_value);
 }
 
+// Stores the elements of a packed array as a comma separated list. Elements are batched into chunks,
+// as calling the store function for every element dominates the cost of writing large arrays.
+template <typename T, typename F>
+static void _write_packed_array_elements(VariantWriter::StoreStringFunc p_store_string_func, void *p_store_string_ud, const T *p_ptr, int64_t p_len, F p_write_element) {
+	constexpr int CHUNK_LENGTH = 4096;
+
+	String chunk;
+	for (int64_t i = 0; i < p_len; i++) {
+		if (i > 0) {
+			chunk += ", ";
+		}
+		p_write_element(chunk, p_ptr[i]);
+
+		if (chunk.length() >= CHUNK_LENGTH) {
+			p_store_string_func(p_store_string_ud, chunk);
+			chunk = String();
+		}
+	}
+
+	if (!chunk.is_empty()) {
+		p_store_string_func(p_store_string_ud, chunk);
+	}
+}
+
 static String encode_resource_reference(const String &p_path) {
 	ResourceUID::ID uid = ResourceLoader::get_resource_uid(p_path);
 	if (uid != ResourceUID::INVALID_ID) {
@@ -2398,14 +2482,9 @@ Error VariantWriter::write(const Variant &p_variant, StoreStringFunc p_store_str
 			p_store_string_func(p_store_string_ud, "PackedByteArray(");
 			Vector<uint8_t> data = p_variant;
 			if (p_compat) {
-				int len = data.size();
-				const uint8_t *ptr = data.ptr();
-				for (int i = 0; i < len; i++) {
-					if (i > 0) {
-						p_store_string_func(p_store_string_ud, ", ");
-					}
-					p_store_string_func(p_store_string_ud, itos(ptr[i]));
-				}
+				_write_packed_array_elements(p_store_string_func, p_store_string_ud, data.ptr(), data.size(), [](String &r_chunk, const uint8_t &p_value) {
+					r_chunk += itos(p_value);
+				});
 			} else if (data.size() > 0) {
 				p_store_string_func(p_store_string_ud, "\"");
 				p_store_string_func(p_store_string_ud, CryptoCore::b64_encode_str(data.ptr(), data.size()));
@@ -2416,62 +2495,36 @@ Error VariantWriter::write(const Variant &p_variant, StoreStringFunc p_store_str
 		case Variant::PACKED_INT32_ARRAY: {
 			p_store_string_func(p_store_string_ud, "PackedInt32Array(");
 			Vector<int32_t> data = p_variant;
-			int32_t len = data.size();
-			const int32_t *ptr = data.ptr();
-
-			for (int32_t i = 0; i < len; i++) {
-				if (i > 0) {
-					p_store_string_func(p_store_string_ud, ", ");
-				}
-
-				p_store_string_func(p_store_string_ud, itos(ptr[i]));
-			}
+			_write_packed_array_elements(p_store_string_func, p_store_string_ud, data.ptr(), data.size(), [](String &r_chunk, const int32_t &p_value) {
+				r_chunk += itos(p_value);
+			});
 
 			p_store_string_func(p_store_string_ud, ")");
 		} break;
 		case Variant::PACKED_INT64_ARRAY: {
 			p_store_string_func(p_store_string_ud, "PackedInt64Array(");
 			Vector<int64_t> data = p_variant;
-			int64_t len = data.size();
-			const int64_t *ptr = data.ptr();
-
-			for (int64_t i = 0; i < len; i++) {
-				if (i > 0) {
-					p_store_string_func(p_store_string_ud, ", ");
-				}
-
-				p_store_string_func(p_store_string_ud, itos(ptr[i]));
-			}
+			_write_packed_array_elements(p_store_string_func, p_store_string_ud, data.ptr(), data.size(), [](String &r_chunk, const int64_t &p_value) {
+				r_chunk += itos(p_value);
+			});
 
 			p_store_string_func(p_store_string_ud, ")");
 		} break;
 		case Variant::PACKED_FLOAT32_ARRAY: {
 			p_store_string_func(p_store_string_ud, "PackedFloat32Array(");
 			Vector<float> data = p_variant;
-			int len = data.size();
-			const float *ptr = data.ptr();
-
-			for (int i = 0; i < len; i++) {
-				if (i > 0) {
-					p_store_string_func(p_store_string_ud, ", ");
-				}
-				p_store_string_func(p_store_string_ud, rtos_fix(ptr[i], p_compat));
-			}
+			_write_packed_array_elements(p_store_string_func, p_store_string_ud, data.ptr(), data.size(), [p_compat](String &r_chunk, const float &p_value) {
+				r_chunk += rtos_fix(p_value, p_compat);
+			});
 
 			p_store_string_func(p_store_string_ud, ")");
 		} break;
 		case Variant::PACKED_FLOAT64_ARRAY: {
 			p_store_string_func(p_store_string_ud, "PackedFloat64Array(");
 			Vector<double> data = p_variant;
-			int len = data.size();
-			const double *ptr = data.ptr();
-
-			for (int i = 0; i < len; i++) {
-				if (i > 0) {
-					p_store_string_func(p_store_string_ud, ", ");
-				}
-				p_store_string_func(p_store_string_ud, rtos_fix(ptr[i], p_compat));
-			}
+			_write_packed_array_elements(p_store_string_func, p_store_string_ud, data.ptr(), data.size(), [p_compat](String &r_chunk, const double &p_value) {
+				r_chunk += rtos_fix(p_value, p_compat);
+			});
 
 			p_store_string_func(p_store_string_ud, ")");
 		} break;
@@ -2493,60 +2546,54 @@ Error VariantWriter::write(const Variant &p_variant, StoreStringFunc p_store_str
 		case Variant::PACKED_VECTOR2_ARRAY: {
 			p_store_string_func(p_store_string_ud, "PackedVector2Array(");
 			Vector<Vector2> data = p_variant;
-			int len = data.size();
-			const Vector2 *ptr = data.ptr();
-
-			for (int i = 0; i < len; i++) {
-				if (i > 0) {
-					p_store_string_func(p_store_string_ud, ", ");
-				}
-				p_store_string_func(p_store_string_ud, rtos_fix(ptr[i].x, p_compat) + ", " + rtos_fix(ptr[i].y, p_compat));
-			}
+			_write_packed_array_elements(p_store_string_func, p_store_string_ud, data.ptr(), data.size(), [p_compat](String &r_chunk, const Vector2 &p_value) {
+				r_chunk += rtos_fix(p_value.x, p_compat);
+				r_chunk += ", ";
+				r_chunk += rtos_fix(p_value.y, p_compat);
+			});
 
 			p_store_string_func(p_store_string_ud, ")");
 		} break;
 		case Variant::PACKED_VECTOR3_ARRAY: {
 			p_store_string_func(p_store_string_ud, "PackedVector3Array(");
 			Vector<Vector3> data = p_variant;
-			int len = data.size();
-			const Vector3 *ptr = data.ptr();
-
-			for (int i = 0; i < len; i++) {
-				if (i > 0) {
-					p_store_string_func(p_store_string_ud, ", ");
-				}
-				p_store_string_func(p_store_string_ud, rtos_fix(ptr[i].x, p_compat) + ", " + rtos_fix(ptr[i].y, p_compat) + ", " + rtos_fix(ptr[i].z, p_compat));
-			}
+			_write_packed_array_elements(p_store_string_func, p_store_string_ud, data.ptr(), data.size(), [p_compat](String &r_chunk, const Vector3 &p_value) {
+				r_chunk += rtos_fix(p_value.x, p_compat);
+				r_chunk += ", ";
+				r_chunk += rtos_fix(p_value.y, p_compat);
+				r_chunk += ", ";
+				r_chunk += rtos_fix(p_value.z, p_compat);
+			});
 
 			p_store_string_func(p_store_string_ud, ")");
 		} break;
 		case Variant::PACKED_COLOR_ARRAY: {
 			p_store_string_func(p_store_string_ud, "PackedColorArray(");
 			Vector<Color> data = p_variant;
-			int len = data.size();
-			const Color *ptr = data.ptr();
-
-			for (int i = 0; i < len; i++) {
-				if (i > 0) {
-					p_store_string_func(p_store_string_ud, ", ");
-				}
-				p_store_string_func(p_store_string_ud, rtos_fix(ptr[i].r, p_compat) + ", " + rtos_fix(ptr[i].g, p_compat) + ", " + rtos_fix(ptr[i].b, p_compat) + ", " + rtos_fix(ptr[i].a, p_compat));
-			}
+			_write_packed_array_elements(p_store_string_func, p_store_string_ud, data.ptr(), data.size(), [p_compat](String &r_chunk, const Color &p_value) {
+				r_chunk += rtos_fix(p_value.r, p_compat);
+				r_chunk += ", ";
+				r_chunk += rtos_fix(p_value.g, p_compat);
+				r_chunk += ", ";
+				r_chunk += rtos_fix(p_value.b, p_compat);
+				r_chunk += ", ";
+				r_chunk += rtos_fix(p_value.a, p_compat);
+			});
 
 			p_store_string_func(p_store_string_ud, ")");
 		} break;
 		case Variant::PACKED_VECTOR4_ARRAY: {
 			p_store_string_func(p_store_string_ud, "PackedVector4Array(");
 			Vector<Vector4> data = p_variant;
-			int len = data.size();
-			const Vector4 *ptr = data.ptr();
-
-			for (int i = 0; i < len; i++) {
-				if (i > 0) {
-					p_store_string_func(p_store_string_ud, ", ");
-				}
-				p_store_string_func(p_store_string_ud, rtos_fix(ptr[i].x, p_compat) + ", " + rtos_fix(ptr[i].y, p_compat) + ", " + rtos_fix(ptr[i].z, p_compat) + ", " + rtos_fix(ptr[i].w, p_compat));
-			}
+			_write_packed_array_elements(p_store_string_func, p_store_string_ud, data.ptr(), data.size(), [p_compat](String &r_chunk, const Vector4 &p_value) {
+				r_chunk += rtos_fix(p_value.x, p_compat);
+				r_chunk += ", ";
+				r_chunk += rtos_fix(p_value.y, p_compat);
+				r_chunk += ", ";
+				r_chunk += rtos_fix(p_value.z, p_compat);
+				r_chunk += ", ";
+				r_chunk += rtos_fix(p_value.w, p_compat);
+			});
 
 			p_store_string_func(p_store_string_ud, ")");
 		} break;
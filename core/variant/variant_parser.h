@@ -56,6 +56,16 @@ public:
 		virtual bool is_utf8() const = 0;
 		bool is_eof() const;
 
+		// Characters already read from the source but not returned by get_char() yet.
+		uint32_t get_readahead_size() const { return readahead_pointer < readahead_filled ? readahead_filled - readahead_pointer : 0; }
+		// Drops the characters read ahead, so the next get_char() reads from the source's current position.
+		void clear_readahead() {
+			readahead_pointer = 0;
+			readahead_filled = 0;
+			eof = false;
+			saved = 0;
+		}
+
 		virtual ~Stream() {}
 	};
 
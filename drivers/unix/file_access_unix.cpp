@@ -305,6 +305,35 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+uint64_t FileAccessUnix::get_buffer_at(uint64_t p_position, uint8_t *p_dst, uint64_t p_length) const {
+	ERR_FAIL_NULL_V_MSG(f, -1, "File must be opened before use.");
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+
+	if (flags != READ) {
+		// Pending buffered writes would be missed by pread(), go through the cursor instead.
+		return FileAccess::get_buffer_at(p_position, p_dst, p_length);
+	}
+
+	// pread() doesn't touch the stream position, so any number of these can run concurrently.
+	int fd = fileno(f);
+	uint64_t read = 0;
+	while (read < p_length) {
+		ssize_t res = ::pread(fd, p_dst + read, p_length - read, p_position + read);
+		if (res < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			break;
+		}
+		if (res == 0) {
+			break; // EOF.
+		}
+		read += res;
+	}
+
+	return read;
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
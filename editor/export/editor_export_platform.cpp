@@ -374,22 +374,28 @@ void EditorExportPlatform::_unload_patches() {
 	patch_temp_dirs.clear();
 }
 
-Error EditorExportPlatform::_encrypt_and_store_data(Ref<FileAccess> p_fd, const String &p_path, const Vector<uint8_t> &p_data, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key, uint64_t p_seed, bool &r_encrypt) {
-	r_encrypt = false;
+bool EditorExportPlatform::_is_path_encrypted(const String &p_path, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters) {
+	bool encrypt = false;
 	for (int i = 0; i < p_enc_in_filters.size(); ++i) {
 		if (p_path.matchn(p_enc_in_filters[i]) || p_path.trim_prefix("res://").matchn(p_enc_in_filters[i])) {
-			r_encrypt = true;
+			encrypt = true;
 			break;
 		}
 	}
 
 	for (int i = 0; i < p_enc_ex_filters.size(); ++i) {
 		if (p_path.matchn(p_enc_ex_filters[i]) || p_path.trim_prefix("res://").matchn(p_enc_ex_filters[i])) {
-			r_encrypt = false;
+			encrypt = false;
 			break;
 		}
 	}
 
+	return encrypt;
+}
+
+Error EditorExportPlatform::_encrypt_and_store_data(Ref<FileAccess> p_fd, const String &p_path, const Vector<uint8_t> &p_data, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key, uint64_t p_seed, bool &r_encrypt) {
+	r_encrypt = _is_path_encrypted(p_path, p_enc_in_filters, p_enc_ex_filters);
+
 	Ref<FileAccessEncrypted> fae;
 	Ref<FileAccess> ftmp = p_fd;
 	if (r_encrypt) {
@@ -447,18 +453,36 @@ Error EditorExportPlatform::_save_pack_file(const Ref<EditorExportPreset> &p_pre
 	sd.ofs = (pd->use_sparse_pck) ? 0 : pd->f->get_position();
 	sd.size = p_data.size();
 	sd.delta = p_delta;
-	Error err = _encrypt_and_store_data(ftmp, simplified_path, p_data, p_enc_in_filters, p_enc_ex_filters, p_key, p_seed, sd.encrypted);
-	if (err != OK) {
-		return err;
-	}
+
+	// Files with identical content share their data in the pack.
+	String content_key;
+	const uint64_t *content_ofs = nullptr;
 	if (!pd->use_sparse_pck) {
-		ERR_FAIL_COND_V(pd->f->get_position() - sd.ofs < (uint64_t)p_data.size(), ERR_FILE_CANT_WRITE);
+		unsigned char hash[32];
+		CryptoCore::sha256(p_data.ptr(), p_data.size(), hash);
+		content_key = String::hex_encode_buffer(hash, 32);
+		sd.encrypted = _is_path_encrypted(simplified_path, p_enc_in_filters, p_enc_ex_filters);
+		if (sd.encrypted) {
+			content_key += ":encrypted"; // Encrypted and plain copies are different blobs.
+		}
+		content_ofs = pd->content_ofs.getptr(content_key);
 	}
 
-	if (!pd->use_sparse_pck) {
-		int pad = _get_pad(PCK_PADDING, pd->f->get_position());
-		for (int i = 0; i < pad; i++) {
-			pd->f->store_8(0);
+	if (content_ofs) {
+		sd.ofs = *content_ofs;
+	} else {
+		Error err = _encrypt_and_store_data(ftmp, simplified_path, p_data, p_enc_in_filters, p_enc_ex_filters, p_key, p_seed, sd.encrypted);
+		if (err != OK) {
+			return err;
+		}
+		if (!pd->use_sparse_pck) {
+			ERR_FAIL_COND_V(pd->f->get_position() - sd.ofs < (uint64_t)p_data.size(), ERR_FILE_CANT_WRITE);
+
+			int pad = _get_pad(PCK_PADDING, pd->f->get_position());
+			for (int i = 0; i < pad; i++) {
+				pd->f->store_8(0);
+			}
+			pd->content_ofs[content_key] = sd.ofs;
 		}
 	}
 
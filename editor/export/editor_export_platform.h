@@ -99,6 +99,7 @@ public:
 		String salt;
 		Ref<FileAccess> f;
 		Vector<SavedData> file_ofs;
+		HashMap<String, uint64_t> content_ofs; // Offsets of stored data by content hash, identical files are stored once.
 		EditorProgress *ep = nullptr;
 		Vector<SharedObject> *so_files = nullptr;
 		bool use_sparse_pck = false;
@@ -106,6 +107,7 @@ public:
 
 	static bool _store_header(Ref<FileAccess> p_fd, bool p_enc, bool p_sparse, uint64_t &r_file_base_ofs, uint64_t &r_dir_base_ofs, const String &p_salt);
 	static bool _encrypt_and_store_directory(Ref<FileAccess> p_fd, PackData &p_pack_data, const Vector<uint8_t> &p_key, uint64_t p_seed, uint64_t p_file_base);
+	static bool _is_path_encrypted(const String &p_path, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters);
 	static Error _encrypt_and_store_data(Ref<FileAccess> p_fd, const String &p_path, const Vector<uint8_t> &p_data, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key, uint64_t p_seed, bool &r_encrypt);
 	static String _get_script_encryption_key(const Ref<EditorExportPreset> &p_preset);
 	static Vector<uint8_t> _get_script_encryption_key_bytes(const Ref<EditorExportPreset> &p_preset);
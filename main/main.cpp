@@ -671,6 +671,8 @@ void Main::print_help(const char *p_binary) {
 #endif // TOOLS_ENABLED
 #ifdef TESTS_ENABLED
 	print_help_option("--test [--help]", "Run unit tests. Use --test --help for more information.\n");
+	print_help_option("--test --benchmark", "Run the engine benchmarks headless and print their timings to console in JSON format.\n");
+	print_help_option("--test --benchmark-file <path>", "Run the engine benchmarks headless and save their timings to a given file in JSON format.\n");
 #endif // TESTS_ENABLED
 	OS::get_singleton()->print("\n");
 }
@@ -36,6 +36,7 @@
 #include "core/os/os.h"
 #include "core/variant/typed_array.h"
 #include "scene/main/node.h"
+#include "scene/main/node_pool.h"
 #include "scene/main/scene_tree.h"
 #include "servers/audio/audio_server.h"
 #include "servers/rendering/rendering_server.h"
@@ -135,6 +136,24 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_EDGE_FREE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+	BIND_ENUM_CONSTANT(OBJECT_NODE_POOL_HITS);
+	BIND_ENUM_CONSTANT(OBJECT_NODE_POOL_MISSES);
+	BIND_ENUM_CONSTANT(PHYSICS_2D_CONTACT_COUNT);
+	BIND_ENUM_CONSTANT(PHYSICS_2D_SLEEPING_OBJECTS);
+	BIND_ENUM_CONSTANT(PHYSICS_2D_PAIRS_ADDED);
+	BIND_ENUM_CONSTANT(PHYSICS_2D_PAIRS_REMOVED);
+	BIND_ENUM_CONSTANT(PHYSICS_2D_QUERY_COUNT);
+	BIND_ENUM_CONSTANT(PHYSICS_2D_STEP_TIME);
+	BIND_ENUM_CONSTANT(PHYSICS_2D_SLOWEST_ISLAND_TIME);
+#ifndef _3D_DISABLED
+	BIND_ENUM_CONSTANT(PHYSICS_3D_CONTACT_COUNT);
+	BIND_ENUM_CONSTANT(PHYSICS_3D_SLEEPING_OBJECTS);
+	BIND_ENUM_CONSTANT(PHYSICS_3D_PAIRS_ADDED);
+	BIND_ENUM_CONSTANT(PHYSICS_3D_PAIRS_REMOVED);
+	BIND_ENUM_CONSTANT(PHYSICS_3D_QUERY_COUNT);
+	BIND_ENUM_CONSTANT(PHYSICS_3D_STEP_TIME);
+	BIND_ENUM_CONSTANT(PHYSICS_3D_SLOWEST_ISLAND_TIME);
+#endif // _3D_DISABLED
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 
 	BIND_ENUM_CONSTANT(MONITOR_TYPE_QUANTITY);
@@ -230,6 +249,22 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation_3d/edges_free"),
 		PNAME("navigation_3d/obstacles"),
 #endif // NAVIGATION_3D_DISABLED
+		PNAME("object/node_pool_hits"),
+		PNAME("object/node_pool_misses"),
+		PNAME("physics_2d/contacts"),
+		PNAME("physics_2d/sleeping_objects"),
+		PNAME("physics_2d/pairs_added"),
+		PNAME("physics_2d/pairs_removed"),
+		PNAME("physics_2d/queries"),
+		PNAME("physics_2d/step_time"),
+		PNAME("physics_2d/slowest_island_time"),
+		PNAME("physics_3d/contacts"),
+		PNAME("physics_3d/sleeping_objects"),
+		PNAME("physics_3d/pairs_added"),
+		PNAME("physics_3d/pairs_removed"),
+		PNAME("physics_3d/queries"),
+		PNAME("physics_3d/step_time"),
+		PNAME("physics_3d/slowest_island_time"),
 	};
 	static_assert(std_size(names) == MONITOR_MAX);
 
@@ -262,6 +297,10 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return _get_node_count();
 		case OBJECT_ORPHAN_NODE_COUNT:
 			return _get_orphan_node_count();
+		case OBJECT_NODE_POOL_HITS:
+			return NodePool::get_total_hit_count();
+		case OBJECT_NODE_POOL_MISSES:
+			return NodePool::get_total_miss_count();
 		case RENDER_TOTAL_OBJECTS_IN_FRAME:
 			return RS::get_singleton()->get_rendering_info(RSE::RENDERING_INFO_TOTAL_OBJECTS_IN_FRAME);
 		case RENDER_TOTAL_PRIMITIVES_IN_FRAME:
@@ -291,6 +330,20 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return PhysicsServer2D::get_singleton()->get_process_info(PS2DE::INFO_COLLISION_PAIRS);
 		case PHYSICS_2D_ISLAND_COUNT:
 			return PhysicsServer2D::get_singleton()->get_process_info(PS2DE::INFO_ISLAND_COUNT);
+		case PHYSICS_2D_CONTACT_COUNT:
+			return PhysicsServer2D::get_singleton()->get_process_info(PS2DE::INFO_CONTACT_COUNT);
+		case PHYSICS_2D_SLEEPING_OBJECTS:
+			return PhysicsServer2D::get_singleton()->get_process_info(PS2DE::INFO_SLEEPING_OBJECTS);
+		case PHYSICS_2D_PAIRS_ADDED:
+			return PhysicsServer2D::get_singleton()->get_process_info(PS2DE::INFO_PAIRS_ADDED);
+		case PHYSICS_2D_PAIRS_REMOVED:
+			return PhysicsServer2D::get_singleton()->get_process_info(PS2DE::INFO_PAIRS_REMOVED);
+		case PHYSICS_2D_QUERY_COUNT:
+			return PhysicsServer2D::get_singleton()->get_process_info(PS2DE::INFO_QUERY_COUNT);
+		case PHYSICS_2D_STEP_TIME:
+			return USEC_TO_SEC(PhysicsServer2D::get_singleton()->get_process_info(PS2DE::INFO_STEP_TIME));
+		case PHYSICS_2D_SLOWEST_ISLAND_TIME:
+			return USEC_TO_SEC(PhysicsServer2D::get_singleton()->get_process_info(PS2DE::INFO_SLOWEST_ISLAND_TIME));
 #else
 		case PHYSICS_2D_ACTIVE_OBJECTS:
 			return 0;
@@ -298,6 +351,20 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return 0;
 		case PHYSICS_2D_ISLAND_COUNT:
 			return 0;
+		case PHYSICS_2D_CONTACT_COUNT:
+			return 0;
+		case PHYSICS_2D_SLEEPING_OBJECTS:
+			return 0;
+		case PHYSICS_2D_PAIRS_ADDED:
+			return 0;
+		case PHYSICS_2D_PAIRS_REMOVED:
+			return 0;
+		case PHYSICS_2D_QUERY_COUNT:
+			return 0;
+		case PHYSICS_2D_STEP_TIME:
+			return 0;
+		case PHYSICS_2D_SLOWEST_ISLAND_TIME:
+			return 0;
 #endif // PHYSICS_2D_DISABLED
 #ifndef PHYSICS_3D_DISABLED
 		case PHYSICS_3D_ACTIVE_OBJECTS:
@@ -306,6 +373,20 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return PhysicsServer3D::get_singleton()->get_process_info(PS3DE::INFO_COLLISION_PAIRS);
 		case PHYSICS_3D_ISLAND_COUNT:
 			return PhysicsServer3D::get_singleton()->get_process_info(PS3DE::INFO_ISLAND_COUNT);
+		case PHYSICS_3D_CONTACT_COUNT:
+			return PhysicsServer3D::get_singleton()->get_process_info(PS3DE::INFO_CONTACT_COUNT);
+		case PHYSICS_3D_SLEEPING_OBJECTS:
+			return PhysicsServer3D::get_singleton()->get_process_info(PS3DE::INFO_SLEEPING_OBJECTS);
+		case PHYSICS_3D_PAIRS_ADDED:
+			return PhysicsServer3D::get_singleton()->get_process_info(PS3DE::INFO_PAIRS_ADDED);
+		case PHYSICS_3D_PAIRS_REMOVED:
+			return PhysicsServer3D::get_singleton()->get_process_info(PS3DE::INFO_PAIRS_REMOVED);
+		case PHYSICS_3D_QUERY_COUNT:
+			return PhysicsServer3D::get_singleton()->get_process_info(PS3DE::INFO_QUERY_COUNT);
+		case PHYSICS_3D_STEP_TIME:
+			return USEC_TO_SEC(PhysicsServer3D::get_singleton()->get_process_info(PS3DE::INFO_STEP_TIME));
+		case PHYSICS_3D_SLOWEST_ISLAND_TIME:
+			return USEC_TO_SEC(PhysicsServer3D::get_singleton()->get_process_info(PS3DE::INFO_SLOWEST_ISLAND_TIME));
 #else
 		case PHYSICS_3D_ACTIVE_OBJECTS:
 			return 0;
@@ -313,6 +394,20 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return 0;
 		case PHYSICS_3D_ISLAND_COUNT:
 			return 0;
+		case PHYSICS_3D_CONTACT_COUNT:
+			return 0;
+		case PHYSICS_3D_SLEEPING_OBJECTS:
+			return 0;
+		case PHYSICS_3D_PAIRS_ADDED:
+			return 0;
+		case PHYSICS_3D_PAIRS_REMOVED:
+			return 0;
+		case PHYSICS_3D_QUERY_COUNT:
+			return 0;
+		case PHYSICS_3D_STEP_TIME:
+			return 0;
+		case PHYSICS_3D_SLOWEST_ISLAND_TIME:
+			return 0;
 #endif // PHYSICS_3D_DISABLED
 
 		case AUDIO_OUTPUT_LATENCY:
@@ -527,7 +622,22 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 #endif // _3D_DISABLED
-
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
 	};
 	static_assert((sizeof(types) / sizeof(MonitorType)) == MONITOR_MAX);
 
@@ -122,6 +122,22 @@ public:
 		NAVIGATION_3D_EDGE_FREE_COUNT,
 		NAVIGATION_3D_OBSTACLE_COUNT,
 #endif // _3D_DISABLED
+		OBJECT_NODE_POOL_HITS,
+		OBJECT_NODE_POOL_MISSES,
+		PHYSICS_2D_CONTACT_COUNT,
+		PHYSICS_2D_SLEEPING_OBJECTS,
+		PHYSICS_2D_PAIRS_ADDED,
+		PHYSICS_2D_PAIRS_REMOVED,
+		PHYSICS_2D_QUERY_COUNT,
+		PHYSICS_2D_STEP_TIME,
+		PHYSICS_2D_SLOWEST_ISLAND_TIME,
+		PHYSICS_3D_CONTACT_COUNT,
+		PHYSICS_3D_SLEEPING_OBJECTS,
+		PHYSICS_3D_PAIRS_ADDED,
+		PHYSICS_3D_PAIRS_REMOVED,
+		PHYSICS_3D_QUERY_COUNT,
+		PHYSICS_3D_STEP_TIME,
+		PHYSICS_3D_SLOWEST_ISLAND_TIME,
 		MONITOR_MAX
 	};
 
@@ -720,6 +720,45 @@ bool GodotBody2D::sleep_test(real_t p_step) {
 	}
 }
 
+void GodotBody2D::save_snapshot_state(SnapshotState &r_state) const {
+	r_state.transform = get_transform();
+	r_state.inv_transform = get_inv_transform();
+	r_state.new_transform = new_transform;
+	r_state.linear_velocity = linear_velocity;
+	r_state.prev_linear_velocity = prev_linear_velocity;
+	r_state.constant_linear_velocity = constant_linear_velocity;
+	r_state.applied_force = applied_force;
+	r_state.constant_force = constant_force;
+	r_state.angular_velocity = angular_velocity;
+	r_state.prev_angular_velocity = prev_angular_velocity;
+	r_state.constant_angular_velocity = constant_angular_velocity;
+	r_state.applied_torque = applied_torque;
+	r_state.constant_torque = constant_torque;
+	r_state.still_time = still_time;
+	r_state.active = active;
+	r_state.first_time_kinematic = first_time_kinematic;
+}
+
+void GodotBody2D::restore_snapshot_state(const SnapshotState &p_state) {
+	_set_transform(p_state.transform);
+	_set_inv_transform(p_state.inv_transform);
+	_update_transform_dependent();
+	new_transform = p_state.new_transform;
+	linear_velocity = p_state.linear_velocity;
+	prev_linear_velocity = p_state.prev_linear_velocity;
+	constant_linear_velocity = p_state.constant_linear_velocity;
+	applied_force = p_state.applied_force;
+	constant_force = p_state.constant_force;
+	angular_velocity = p_state.angular_velocity;
+	prev_angular_velocity = p_state.prev_angular_velocity;
+	constant_angular_velocity = p_state.constant_angular_velocity;
+	applied_torque = p_state.applied_torque;
+	constant_torque = p_state.constant_torque;
+	still_time = p_state.still_time;
+	first_time_kinematic = p_state.first_time_kinematic;
+	set_active(p_state.active);
+}
+
 void GodotBody2D::set_state_sync_callback(const Callable &p_callable) {
 	body_state_callback = p_callable;
 }
@@ -113,7 +113,13 @@ class GodotBody2D : public GodotCollisionObject2D {
 		GodotArea2D *area = nullptr;
 		int refCount = 0;
 		_FORCE_INLINE_ bool operator==(const AreaCMP &p_cmp) const { return area->get_self() == p_cmp.area->get_self(); }
-		_FORCE_INLINE_ bool operator<(const AreaCMP &p_cmp) const { return area->get_priority() < p_cmp.area->get_priority(); }
+		_FORCE_INLINE_ bool operator<(const AreaCMP &p_cmp) const {
+			if (area->get_priority() != p_cmp.area->get_priority()) {
+				return area->get_priority() < p_cmp.area->get_priority();
+			}
+			// Keeps areas with the same priority in a stable order, so their gravity is combined the same way every time.
+			return area->get_sequence() < p_cmp.area->get_sequence();
+		}
 		_FORCE_INLINE_ AreaCMP() {}
 		_FORCE_INLINE_ AreaCMP(GodotArea2D *p_area) {
 			area = p_area;
@@ -338,6 +344,29 @@ public:
 
 	bool sleep_test(real_t p_step);
 
+	// Simulation state copied by space snapshots.
+	struct SnapshotState {
+		Transform2D transform;
+		Transform2D inv_transform;
+		Transform2D new_transform;
+		Vector2 linear_velocity;
+		Vector2 prev_linear_velocity;
+		Vector2 constant_linear_velocity;
+		Vector2 applied_force;
+		Vector2 constant_force;
+		real_t angular_velocity = 0.0;
+		real_t prev_angular_velocity = 0.0;
+		real_t constant_angular_velocity = 0.0;
+		real_t applied_torque = 0.0;
+		real_t constant_torque = 0.0;
+		real_t still_time = 0.0;
+		bool active = false;
+		bool first_time_kinematic = false;
+	};
+
+	void save_snapshot_state(SnapshotState &r_state) const;
+	void restore_snapshot_state(const SnapshotState &p_state);
+
 	GodotBody2D();
 	~GodotBody2D();
 };
@@ -596,8 +596,59 @@ void GodotBodyPair2D::solve(real_t p_step) {
 	}
 }
 
+void GodotBodyPair2D::save_snapshot_state(SnapshotState &r_state) const {
+	// Copied field by field, so that padding in the snapshot stays zeroed.
+	// Slots past the contact count are stale and left out, they're rebuilt before being used again.
+	for (int i = 0; i < contact_count; i++) {
+		const Contact &c = contacts[i];
+		Contact &s = r_state.contacts[i];
+		s.position = c.position;
+		s.normal = c.normal;
+		s.local_A = c.local_A;
+		s.local_B = c.local_B;
+		s.acc_impulse = c.acc_impulse;
+		s.acc_normal_impulse = c.acc_normal_impulse;
+		s.acc_tangent_impulse = c.acc_tangent_impulse;
+		s.acc_bias_impulse = c.acc_bias_impulse;
+		s.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
+		s.mass_normal = c.mass_normal;
+		s.mass_tangent = c.mass_tangent;
+		s.bias = c.bias;
+		s.depth = c.depth;
+		s.active = c.active;
+		s.used = c.used;
+		s.rA = c.rA;
+		s.rB = c.rB;
+		s.bounce = c.bounce;
+	}
+	r_state.sep_axis = sep_axis;
+	r_state.offset_B = offset_B;
+	r_state.contact_count = contact_count;
+	r_state.collided = collided;
+	r_state.oneway_disabled = oneway_disabled;
+}
+
+void GodotBodyPair2D::restore_snapshot_state(const SnapshotState &p_state) {
+	for (int i = 0; i < MAX_CONTACTS; i++) {
+		contacts[i] = p_state.contacts[i];
+	}
+	sep_axis = p_state.sep_axis;
+	offset_B = p_state.offset_B;
+	contact_count = CLAMP(p_state.contact_count, 0, int(MAX_CONTACTS));
+	collided = p_state.collided;
+	oneway_disabled = p_state.oneway_disabled;
+}
+
+void GodotBodyPair2D::clear_contacts() {
+	contact_count = 0;
+	collided = false;
+	oneway_disabled = false;
+	sep_axis = Vector2();
+}
+
 GodotBodyPair2D::GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p_B, int p_shape_B) :
-		GodotConstraint2D(_arr, 2) {
+		GodotConstraint2D(_arr, 2),
+		space_list(this) {
 	A = p_A;
 	B = p_B;
 	shape_A = p_shape_A;
@@ -605,6 +656,11 @@ GodotBodyPair2D::GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p
 	space = A->get_space();
 	A->add_constraint(this, 0);
 	B->add_constraint(this, 1);
+
+	set_order_key((uint64_t(uint32_t(shape_A)) << 32) | uint32_t(shape_B));
+	if (space) {
+		space->body_pair_add_to_list(&space_list);
+	}
 }
 
 GodotBodyPair2D::~GodotBodyPair2D() {
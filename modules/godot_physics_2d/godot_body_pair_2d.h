@@ -83,12 +83,34 @@ class GodotBodyPair2D : public GodotConstraint2D {
 	bool oneway_disabled = false;
 	bool report_contacts_only = false;
 
+	SelfList<GodotBodyPair2D> space_list;
+
 	bool _test_ccd(real_t p_step, GodotBody2D *p_A, int p_shape_A, const Transform2D &p_xform_A, GodotBody2D *p_B, int p_shape_B, const Transform2D &p_xform_B);
 	void _validate_contacts();
 	static void _add_contact(const Vector2 &p_point_A, const Vector2 &p_point_B, void *p_self);
 	_FORCE_INLINE_ void _contact_added_callback(const Vector2 &p_point_A, const Vector2 &p_point_B);
 
 public:
+	// Contact cache copied by space snapshots.
+	struct SnapshotState {
+		Contact contacts[MAX_CONTACTS];
+		Vector2 sep_axis;
+		Vector2 offset_B;
+		int32_t contact_count = 0;
+		bool collided = false;
+		bool oneway_disabled = false;
+	};
+
+	_FORCE_INLINE_ GodotBody2D *get_body_A() const { return A; }
+	_FORCE_INLINE_ GodotBody2D *get_body_B() const { return B; }
+	_FORCE_INLINE_ int get_shape_A() const { return shape_A; }
+	_FORCE_INLINE_ int get_shape_B() const { return shape_B; }
+	_FORCE_INLINE_ int get_contact_count() const { return contact_count; }
+
+	void save_snapshot_state(SnapshotState &r_state) const;
+	void restore_snapshot_state(const SnapshotState &p_state);
+	void clear_contacts();
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -0,0 +1,512 @@
+/**************************************************************************/
+/*  godot_broad_phase_2d_hash_grid.cpp                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "godot_broad_phase_2d_hash_grid.h"
+
+#include "godot_collision_object_2d.h"
+
+#include "core/config/project_settings.h"
+
+bool GodotBroadPhase2DHashGrid::_compute_cells(const Rect2 &p_aabb, int p_max_cells, Rect2i &r_cells) const {
+	const real_t min_x = Math::floor(p_aabb.position.x / cell_size);
+	const real_t min_y = Math::floor(p_aabb.position.y / cell_size);
+	const real_t max_x = Math::floor((p_aabb.position.x + p_aabb.size.x) / cell_size);
+	const real_t max_y = Math::floor((p_aabb.position.y + p_aabb.size.y) / cell_size);
+
+	// Written so that infinite and NaN extents also fail.
+	const real_t cell_count = (max_x - min_x + 1) * (max_y - min_y + 1);
+	if (!(cell_count <= p_max_cells)) {
+		return false;
+	}
+	if (!(Math::abs(min_x) < (1 << 30) && Math::abs(min_y) < (1 << 30))) {
+		return false;
+	}
+
+	r_cells = Rect2i(int(min_x), int(min_y), int(max_x - min_x) + 1, int(max_y - min_y) + 1);
+	return true;
+}
+
+void GodotBroadPhase2DHashGrid::_add_to_cell(const Vector2i &p_cell, ID p_id) {
+	LocalVector<ID> *cell = cells.getptr(p_cell);
+	if (!cell) {
+		cell = &cells.insert(p_cell, LocalVector<ID>())->value;
+	}
+	cell->push_back(p_id);
+}
+
+void GodotBroadPhase2DHashGrid::_remove_from_cell(const Vector2i &p_cell, ID p_id) {
+	LocalVector<ID> *cell = cells.getptr(p_cell);
+	ERR_FAIL_NULL(cell);
+	int64_t index = cell->find(p_id);
+	ERR_FAIL_COND(index < 0);
+	cell->remove_at_unordered(index);
+	if (cell->is_empty()) {
+		cells.erase(p_cell);
+	}
+}
+
+void GodotBroadPhase2DHashGrid::_enter_grid(ID p_id) {
+	const Element &e = elements[p_id - 1];
+	if (e.large) {
+		large_elements.push_back(p_id);
+		return;
+	}
+	const Vector2i end = e.cells.get_end();
+	for (int y = e.cells.position.y; y < end.y; y++) {
+		for (int x = e.cells.position.x; x < end.x; x++) {
+			_add_to_cell(Vector2i(x, y), p_id);
+		}
+	}
+}
+
+void GodotBroadPhase2DHashGrid::_exit_grid(ID p_id) {
+	const Element &e = elements[p_id - 1];
+	if (e.large) {
+		int64_t index = large_elements.find(p_id);
+		ERR_FAIL_COND(index < 0);
+		large_elements.remove_at_unordered(index);
+		return;
+	}
+	const Vector2i end = e.cells.get_end();
+	for (int y = e.cells.position.y; y < end.y; y++) {
+		for (int x = e.cells.position.x; x < end.x; x++) {
+			_remove_from_cell(Vector2i(x, y), p_id);
+		}
+	}
+}
+
+void GodotBroadPhase2DHashGrid::_move_in_grid(ID p_id, const Rect2i &p_new_cells) {
+	Element &e = elements[p_id - 1];
+	const Rect2i old_cells = e.cells;
+
+	// Only touch the cells that were left or entered.
+	Vector2i end = old_cells.get_end();
+	for (int y = old_cells.position.y; y < end.y; y++) {
+		for (int x = old_cells.position.x; x < end.x; x++) {
+			const Vector2i cell(x, y);
+			if (!p_new_cells.has_point(cell)) {
+				_remove_from_cell(cell, p_id);
+			}
+		}
+	}
+
+	end = p_new_cells.get_end();
+	for (int y = p_new_cells.position.y; y < end.y; y++) {
+		for (int x = p_new_cells.position.x; x < end.x; x++) {
+			const Vector2i cell(x, y);
+			if (!old_cells.has_point(cell)) {
+				_add_to_cell(cell, p_id);
+			}
+		}
+	}
+
+	e.cells = p_new_cells;
+}
+
+bool GodotBroadPhase2DHashGrid::_should_pair(ID p_a, ID p_b) const {
+	const Element &a = elements[p_a - 1];
+	const Element &b = elements[p_b - 1];
+	if (a.owner == b.owner || (a._static && b._static)) {
+		return false;
+	}
+	if (!a.aabb.intersects(b.aabb, true)) {
+		return false;
+	}
+	return p_a < p_b ? a.owner->interacts_with(b.owner) : b.owner->interacts_with(a.owner);
+}
+
+void GodotBroadPhase2DHashGrid::_pair(ID p_a, ID p_b) {
+	const ID id_A = MIN(p_a, p_b);
+	const ID id_B = MAX(p_a, p_b);
+	Element &A = elements[id_A - 1];
+	Element &B = elements[id_B - 1];
+
+	PairLink link;
+	if (pair_callback) {
+		link.data = pair_callback(A.owner, A.subindex, B.owner, B.subindex, pair_userdata);
+	}
+	link.other = id_B;
+	A.pairs.push_back(link);
+	link.other = id_A;
+	B.pairs.push_back(link);
+}
+
+void GodotBroadPhase2DHashGrid::_unpair(ID p_a, ID p_b) {
+	const ID id_A = MIN(p_a, p_b);
+	const ID id_B = MAX(p_a, p_b);
+	Element &A = elements[id_A - 1];
+	Element &B = elements[id_B - 1];
+
+	void *data = nullptr;
+	for (uint32_t i = 0; i < A.pairs.size(); i++) {
+		if (A.pairs[i].other == id_B) {
+			data = A.pairs[i].data;
+			A.pairs.remove_at_unordered(i);
+			break;
+		}
+	}
+	for (uint32_t i = 0; i < B.pairs.size(); i++) {
+		if (B.pairs[i].other == id_A) {
+			B.pairs.remove_at_unordered(i);
+			break;
+		}
+	}
+
+	if (unpair_callback) {
+		unpair_callback(A.owner, A.subindex, B.owner, B.subindex, data, unpair_userdata);
+	}
+}
+
+void GodotBroadPhase2DHashGrid::_check_pair(ID p_id, ID p_other) {
+	Element &other = elements[p_other - 1];
+	if (other.pass == pass) {
+		return;
+	}
+	other.pass = pass;
+	if (_should_pair(p_id, p_other)) {
+		_pair(p_id, p_other);
+	}
+}
+
+void GodotBroadPhase2DHashGrid::_update_pairs(ID p_id) {
+	Element &e = elements[p_id - 1];
+
+	// Drop pairs that no longer overlap or interact.
+	for (uint32_t i = 0; i < e.pairs.size();) {
+		const ID other = e.pairs[i].other;
+		if (_should_pair(p_id, other)) {
+			i++;
+		} else {
+			_unpair(p_id, other);
+		}
+	}
+
+	// Stamp the element and its current pairs so they are skipped when gathering new ones.
+	pass++;
+	e.pass = pass;
+	for (const PairLink &link : e.pairs) {
+		elements[link.other - 1].pass = pass;
+	}
+
+	if (e.large) {
+		for (uint32_t i = 0; i < elements.size(); i++) {
+			if (elements[i].owner) {
+				_check_pair(p_id, i + 1);
+			}
+		}
+		return;
+	}
+
+	const Vector2i end = e.cells.get_end();
+	for (int y = e.cells.position.y; y < end.y; y++) {
+		for (int x = e.cells.position.x; x < end.x; x++) {
+			const LocalVector<ID> *cell = cells.getptr(Vector2i(x, y));
+			if (!cell) {
+				continue;
+			}
+			for (const ID other : *cell) {
+				_check_pair(p_id, other);
+			}
+		}
+	}
+	for (const ID other : large_elements) {
+		_check_pair(p_id, other);
+	}
+}
+
+void GodotBroadPhase2DHashGrid::_mark_changed(ID p_id) {
+	Element &e = elements[p_id - 1];
+	if (!e.changed) {
+		e.changed = true;
+		changed_elements.push_back(p_id);
+	}
+}
+
+GodotBroadPhase2D::ID GodotBroadPhase2DHashGrid::create(GodotCollisionObject2D *p_object, int p_subindex, const Rect2 &p_aabb, bool p_static) {
+	ERR_FAIL_NULL_V(p_object, 0);
+	MutexLock lock(mutex);
+
+	ID id;
+	if (free_ids.size()) {
+		id = free_ids[free_ids.size() - 1];
+		free_ids.remove_at(free_ids.size() - 1);
+	} else {
+		elements.push_back(Element());
+		id = elements.size();
+	}
+
+	Element &e = elements[id - 1];
+	e.owner = p_object;
+	e.subindex = p_subindex;
+	e.aabb = p_aabb;
+	e._static = p_static;
+	e.large = !_compute_cells(p_aabb, max_object_cells, e.cells);
+	_enter_grid(id);
+	element_count++;
+
+	_update_pairs(id);
+	return id;
+}
+
+void GodotBroadPhase2DHashGrid::move(ID p_id, const Rect2 &p_aabb) {
+	MutexLock lock(mutex);
+	ERR_FAIL_COND(!_is_valid(p_id));
+
+	Element &e = elements[p_id - 1];
+	if (e.aabb == p_aabb) {
+		return;
+	}
+
+	Rect2i new_cells;
+	const bool large = !_compute_cells(p_aabb, max_object_cells, new_cells);
+	if (large != e.large) {
+		_exit_grid(p_id);
+		e.large = large;
+		e.cells = new_cells;
+		_enter_grid(p_id);
+	} else if (!large && new_cells != e.cells) {
+		_move_in_grid(p_id, new_cells);
+	}
+	e.aabb = p_aabb;
+
+	_mark_changed(p_id);
+}
+
+void GodotBroadPhase2DHashGrid::set_static(ID p_id, bool p_static) {
+	MutexLock lock(mutex);
+	ERR_FAIL_COND(!_is_valid(p_id));
+
+	Element &e = elements[p_id - 1];
+	if (e._static == p_static) {
+		return;
+	}
+	e._static = p_static;
+
+	_mark_changed(p_id);
+}
+
+void GodotBroadPhase2DHashGrid::remove(ID p_id) {
+	MutexLock lock(mutex);
+	ERR_FAIL_COND(!_is_valid(p_id));
+
+	Element &e = elements[p_id - 1];
+	while (e.pairs.size()) {
+		_unpair(p_id, e.pairs[e.pairs.size() - 1].other);
+	}
+	_exit_grid(p_id);
+
+	if (e.changed) {
+		int64_t index = changed_elements.find(p_id);
+		if (index >= 0) {
+			changed_elements.remove_at(index);
+		}
+	}
+
+	e = Element();
+	free_ids.push_back(p_id);
+	element_count--;
+}
+
+GodotCollisionObject2D *GodotBroadPhase2DHashGrid::get_object(ID p_id) const {
+	MutexLock lock(mutex);
+	ERR_FAIL_COND_V(!_is_valid(p_id), nullptr);
+	return elements[p_id - 1].owner;
+}
+
+bool GodotBroadPhase2DHashGrid::is_static(ID p_id) const {
+	MutexLock lock(mutex);
+	ERR_FAIL_COND_V(!_is_valid(p_id), false);
+	return elements[p_id - 1]._static;
+}
+
+int GodotBroadPhase2DHashGrid::get_subindex(ID p_id) const {
+	MutexLock lock(mutex);
+	ERR_FAIL_COND_V(!_is_valid(p_id), 0);
+	return elements[p_id - 1].subindex;
+}
+
+int GodotBroadPhase2DHashGrid::cull_segment(const Vector2 &p_from, const Vector2 &p_to, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices) {
+	MutexLock lock(mutex);
+	pass++;
+
+	int count = 0;
+	if (p_max_results <= 0) {
+		return 0;
+	}
+
+	const Vector2 from = p_from / cell_size;
+	const Vector2 to = p_to / cell_size;
+	const Vector2 dir = to - from;
+
+	// Walking more cells than there are elements is slower than testing them all.
+	if (!(Math::abs(dir.x) + Math::abs(dir.y) + 2 <= element_count) || !(Math::abs(from.x) < (1 << 30) && Math::abs(from.y) < (1 << 30))) {
+		for (uint32_t i = 0; i < elements.size(); i++) {
+			if (elements[i].owner && elements[i].aabb.intersects_segment(p_from, p_to)) {
+				_cull_add(i + 1, p_results, p_result_indices, count);
+				if (count >= p_max_results) {
+					return count;
+				}
+			}
+		}
+		return count;
+	}
+
+	for (const ID id : large_elements) {
+		if (elements[id - 1].aabb.intersects_segment(p_from, p_to)) {
+			_cull_add(id, p_results, p_result_indices, count);
+			if (count >= p_max_results) {
+				return count;
+			}
+		}
+	}
+
+	// Walk the cells crossed by the segment (Amanatides & Woo).
+	Vector2i cell = Vector2i(from.floor());
+	const Vector2i end_cell = Vector2i(to.floor());
+	const Vector2i step(dir.x > 0 ? 1 : -1, dir.y > 0 ? 1 : -1);
+	const Vector2 delta(dir.x != 0 ? Math::abs(1 / dir.x) : Math::INF, dir.y != 0 ? Math::abs(1 / dir.y) : Math::INF);
+	Vector2 t_max(
+			dir.x > 0 ? (cell.x + 1 - from.x) * delta.x : (dir.x < 0 ? (from.x - cell.x) * delta.x : Math::INF),
+			dir.y > 0 ? (cell.y + 1 - from.y) * delta.y : (dir.y < 0 ? (from.y - cell.y) * delta.y : Math::INF));
+
+	while (true) {
+		const LocalVector<ID> *ids = cells.getptr(cell);
+		if (ids) {
+			for (const ID id : *ids) {
+				const Element &e = elements[id - 1];
+				if (e.pass != pass && e.aabb.intersects_segment(p_from, p_to)) {
+					_cull_add(id, p_results, p_result_indices, count);
+					if (count >= p_max_results) {
+						return count;
+					}
+				}
+			}
+		}
+
+		if (cell == end_cell) {
+			break;
+		}
+
+		// Never step past the last cell on an axis, rounding could otherwise skip the end cell.
+		if (cell.y == end_cell.y || (cell.x != end_cell.x && t_max.x < t_max.y)) {
+			cell.x += step.x;
+			t_max.x += delta.x;
+		} else {
+			cell.y += step.y;
+			t_max.y += delta.y;
+		}
+	}
+
+	return count;
+}
+
+int GodotBroadPhase2DHashGrid::cull_aabb(const Rect2 &p_aabb, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices) {
+	MutexLock lock(mutex);
+	pass++;
+
+	int count = 0;
+	if (p_max_results <= 0) {
+		return 0;
+	}
+
+	Rect2i query_cells;
+	if (!_compute_cells(p_aabb, element_count, query_cells)) {
+		// Visiting more cells than there are elements is slower than testing them all.
+		for (uint32_t i = 0; i < elements.size(); i++) {
+			if (elements[i].owner && elements[i].aabb.intersects(p_aabb, true)) {
+				_cull_add(i + 1, p_results, p_result_indices, count);
+				if (count >= p_max_results) {
+					return count;
+				}
+			}
+		}
+		return count;
+	}
+
+	for (const ID id : large_elements) {
+		if (elements[id - 1].aabb.intersects(p_aabb, true)) {
+			_cull_add(id, p_results, p_result_indices, count);
+			if (count >= p_max_results) {
+				return count;
+			}
+		}
+	}
+
+	const Vector2i end = query_cells.get_end();
+	for (int y = query_cells.position.y; y < end.y; y++) {
+		for (int x = query_cells.position.x; x < end.x; x++) {
+			const LocalVector<ID> *ids = cells.getptr(Vector2i(x, y));
+			if (!ids) {
+				continue;
+			}
+			for (const ID id : *ids) {
+				const Element &e = elements[id - 1];
+				if (e.pass != pass && e.aabb.intersects(p_aabb, true)) {
+					_cull_add(id, p_results, p_result_indices, count);
+					if (count >= p_max_results) {
+						return count;
+					}
+				}
+			}
+		}
+	}
+
+	return count;
+}
+
+void GodotBroadPhase2DHashGrid::set_pair_callback(PairCallback p_pair_callback, void *p_userdata) {
+	pair_callback = p_pair_callback;
+	pair_userdata = p_userdata;
+}
+
+void GodotBroadPhase2DHashGrid::set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) {
+	unpair_callback = p_unpair_callback;
+	unpair_userdata = p_userdata;
+}
+
+void GodotBroadPhase2DHashGrid::update() {
+	MutexLock lock(mutex);
+
+	for (uint32_t i = 0; i < changed_elements.size(); i++) {
+		const ID id = changed_elements[i];
+		elements[id - 1].changed = false;
+		_update_pairs(id);
+	}
+	changed_elements.clear();
+}
+
+GodotBroadPhase2D *GodotBroadPhase2DHashGrid::_create() {
+	return memnew(GodotBroadPhase2DHashGrid(GLOBAL_GET("physics/godot_physics_2d/hash_grid/cell_size"), GLOBAL_GET("physics/godot_physics_2d/hash_grid/max_object_cells")));
+}
+
+GodotBroadPhase2DHashGrid::GodotBroadPhase2DHashGrid(real_t p_cell_size, int p_max_object_cells) {
+	cell_size = MAX(p_cell_size, real_t(1.0));
+	max_object_cells = MAX(p_max_object_cells, 1);
+}
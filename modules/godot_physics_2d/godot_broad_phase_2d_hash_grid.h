@@ -0,0 +1,131 @@
+/**************************************************************************/
+/*  godot_broad_phase_2d_hash_grid.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "godot_broad_phase_2d.h"
+
+#include "core/math/rect2.h"
+#include "core/math/rect2i.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Uniform grid broadphase, better suited than the BVH to many similarly sized moving objects:
+// moving an object only touches the cells it enters or leaves instead of refitting a tree.
+// Objects covering too many cells are kept in a separate list that is checked against everything.
+class GodotBroadPhase2DHashGrid : public GodotBroadPhase2D {
+	struct PairLink {
+		ID other = 0;
+		void *data = nullptr;
+	};
+
+	struct Element {
+		GodotCollisionObject2D *owner = nullptr;
+		Rect2 aabb;
+		Rect2i cells;
+		int subindex = 0;
+		bool _static = false;
+		bool large = false;
+		bool changed = false;
+		uint64_t pass = 0;
+		LocalVector<PairLink> pairs;
+	};
+
+	LocalVector<Element> elements;
+	LocalVector<ID> free_ids;
+	HashMap<Vector2i, LocalVector<ID>> cells;
+	LocalVector<ID> large_elements;
+	LocalVector<ID> changed_elements;
+	uint32_t element_count = 0;
+	uint64_t pass = 0;
+
+	real_t cell_size = 128.0;
+	int max_object_cells = 512;
+
+	PairCallback pair_callback = nullptr;
+	void *pair_userdata = nullptr;
+	UnpairCallback unpair_callback = nullptr;
+	void *unpair_userdata = nullptr;
+
+	mutable Mutex mutex;
+
+	_FORCE_INLINE_ bool _is_valid(ID p_id) const { return p_id && p_id <= elements.size() && elements[p_id - 1].owner; }
+
+	bool _compute_cells(const Rect2 &p_aabb, int p_max_cells, Rect2i &r_cells) const;
+	void _add_to_cell(const Vector2i &p_cell, ID p_id);
+	void _remove_from_cell(const Vector2i &p_cell, ID p_id);
+	void _enter_grid(ID p_id);
+	void _exit_grid(ID p_id);
+	void _move_in_grid(ID p_id, const Rect2i &p_new_cells);
+
+	bool _should_pair(ID p_a, ID p_b) const;
+	void _pair(ID p_a, ID p_b);
+	void _unpair(ID p_a, ID p_b);
+	void _check_pair(ID p_id, ID p_other);
+	void _update_pairs(ID p_id);
+	void _mark_changed(ID p_id);
+
+	_FORCE_INLINE_ bool _cull_add(ID p_id, GodotCollisionObject2D **p_results, int *p_result_indices, int &r_count) {
+		Element &e = elements[p_id - 1];
+		if (e.pass == pass) {
+			return false;
+		}
+		e.pass = pass;
+		p_results[r_count] = e.owner;
+		if (p_result_indices) {
+			p_result_indices[r_count] = e.subindex;
+		}
+		r_count++;
+		return true;
+	}
+
+public:
+	// 0 is an invalid ID
+	virtual ID create(GodotCollisionObject2D *p_object, int p_subindex = 0, const Rect2 &p_aabb = Rect2(), bool p_static = false) override;
+	virtual void move(ID p_id, const Rect2 &p_aabb) override;
+	virtual void set_static(ID p_id, bool p_static) override;
+	virtual void remove(ID p_id) override;
+
+	virtual GodotCollisionObject2D *get_object(ID p_id) const override;
+	virtual bool is_static(ID p_id) const override;
+	virtual int get_subindex(ID p_id) const override;
+
+	virtual int cull_segment(const Vector2 &p_from, const Vector2 &p_to, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
+	virtual int cull_aabb(const Rect2 &p_aabb, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
+
+	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) override;
+	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) override;
+
+	virtual void update() override;
+
+	static GodotBroadPhase2D *_create();
+	GodotBroadPhase2DHashGrid(real_t p_cell_size = 128.0, int p_max_object_cells = 512);
+};
@@ -49,6 +49,7 @@ private:
 	Type type;
 	RID self;
 	ObjectID instance_id;
+	uint64_t sequence = 0; // Order of addition to the space, used to sort objects the same way on every run in deterministic mode.
 	ObjectID canvas_instance_id;
 	bool pickable = true;
 
@@ -102,6 +103,9 @@ public:
 	_FORCE_INLINE_ void set_instance_id(const ObjectID &p_instance_id) { instance_id = p_instance_id; }
 	_FORCE_INLINE_ ObjectID get_instance_id() const { return instance_id; }
 
+	_FORCE_INLINE_ void set_sequence(uint64_t p_sequence) { sequence = p_sequence; }
+	_FORCE_INLINE_ uint64_t get_sequence() const { return sequence; }
+
 	_FORCE_INLINE_ void set_canvas_instance_id(const ObjectID &p_canvas_instance_id) { canvas_instance_id = p_canvas_instance_id; }
 	_FORCE_INLINE_ ObjectID get_canvas_instance_id() const { return canvas_instance_id; }
 
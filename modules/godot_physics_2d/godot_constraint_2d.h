@@ -36,6 +36,7 @@ class GodotConstraint2D {
 	GodotBody2D **_body_ptr;
 	int _body_count;
 	uint64_t island_step = 0;
+	uint64_t order_key = 0;
 	bool disabled_collisions_between_bodies = true;
 
 	RID self;
@@ -53,12 +54,18 @@ public:
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
 
+	// Orders constraints between the same bodies in deterministic mode.
+	_FORCE_INLINE_ uint64_t get_order_key() const { return order_key; }
+	_FORCE_INLINE_ void set_order_key(uint64_t p_key) { order_key = p_key; }
+
 	_FORCE_INLINE_ GodotBody2D **get_body_ptr() const { return _body_ptr; }
 	_FORCE_INLINE_ int get_body_count() const { return _body_count; }
 
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	virtual bool is_joint() const { return false; }
+
 	virtual bool setup(real_t p_step) = 0;
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
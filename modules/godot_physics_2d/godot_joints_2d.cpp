@@ -32,6 +32,8 @@
 
 #include "godot_space_2d.h"
 
+SafeNumeric<uint64_t> GodotJoint2D::next_sequence;
+
 //based on chipmunk joint constraints
 
 /* Copyright (c) 2007 Scott Lembcke
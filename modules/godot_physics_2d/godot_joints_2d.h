@@ -33,11 +33,16 @@
 #include "godot_body_2d.h"
 #include "godot_constraint_2d.h"
 
+#include "core/templates/safe_refcount.h"
+
 class GodotJoint2D : public GodotConstraint2D {
 	real_t bias = 0;
 	real_t max_bias = 3.40282e+38;
 	real_t max_force = 3.40282e+38;
 
+	// Only the relative creation order of joints matters, but they can be created from several threads.
+	static SafeNumeric<uint64_t> next_sequence;
+
 protected:
 	bool dynamic_A = false;
 	bool dynamic_B = false;
@@ -52,15 +57,29 @@ public:
 	_FORCE_INLINE_ void set_max_bias(real_t p_bias) { max_bias = p_bias; }
 	_FORCE_INLINE_ real_t get_max_bias() const { return max_bias; }
 
+	virtual bool is_joint() const override { return true; }
+
 	virtual bool setup(real_t p_step) override { return false; }
 	virtual bool pre_solve(real_t p_step) override { return false; }
 	virtual void solve(real_t p_step) override {}
 
+	// Impulses carried over between steps for warm starting, copied by space snapshots.
+	struct SnapshotState {
+		Vector2 impulse;
+		real_t angular_impulse = 0.0;
+	};
+
+	virtual void save_snapshot_state(SnapshotState &r_state) const {}
+	virtual void restore_snapshot_state(const SnapshotState &p_state) {}
+
 	void copy_settings_from(GodotJoint2D *p_joint);
 
 	virtual PS2DE::JointType get_type() const { return PS2DE::JOINT_TYPE_MAX; }
 	GodotJoint2D(GodotBody2D **p_body_ptr = nullptr, int p_body_count = 0) :
-			GodotConstraint2D(p_body_ptr, p_body_count) {}
+			GodotConstraint2D(p_body_ptr, p_body_count) {
+		// Joints sort after the body pairs between the same bodies, in creation order.
+		set_order_key((uint64_t(1) << 63) | next_sequence.postincrement());
+	}
 
 	virtual ~GodotJoint2D() {
 		for (int i = 0; i < get_body_count(); i++) {
@@ -114,6 +133,15 @@ public:
 	void set_flag(PS2DE::PinJointFlag p_flag, bool p_enabled);
 	bool get_flag(PS2DE::PinJointFlag p_flag) const;
 
+	virtual void save_snapshot_state(SnapshotState &r_state) const override {
+		r_state.impulse = P;
+		r_state.angular_impulse = j_acc;
+	}
+	virtual void restore_snapshot_state(const SnapshotState &p_state) override {
+		P = p_state.impulse;
+		j_acc = p_state.angular_impulse;
+	}
+
 	GodotPinJoint2D(const Vector2 &p_pos, GodotBody2D *p_body_a, GodotBody2D *p_body_b = nullptr);
 };
 
@@ -148,6 +176,9 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual void save_snapshot_state(SnapshotState &r_state) const override { r_state.impulse = jn_acc; }
+	virtual void restore_snapshot_state(const SnapshotState &p_state) override { jn_acc = p_state.impulse; }
+
 	GodotGrooveJoint2D(const Vector2 &p_a_groove1, const Vector2 &p_a_groove2, const Vector2 &p_b_anchor, GodotBody2D *p_body_a, GodotBody2D *p_body_b);
 };
 
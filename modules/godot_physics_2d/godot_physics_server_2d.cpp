@@ -32,8 +32,10 @@
 
 #include "godot_body_direct_state_2d.h"
 #include "godot_broad_phase_2d_bvh.h"
+#include "godot_broad_phase_2d_hash_grid.h"
 #include "godot_collision_solver_2d.h"
 
+#include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
 #include "core/os/os.h"
 
@@ -283,6 +285,18 @@ PhysicsDirectSpaceState2D *GodotPhysicsServer2D::space_get_direct_state(RID p_sp
 	return space->get_direct_state();
 }
 
+Vector<uint8_t> GodotPhysicsServer2D::space_save_state(RID p_space) {
+	GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, Vector<uint8_t>());
+	return space->save_state();
+}
+
+bool GodotPhysicsServer2D::space_restore_state(RID p_space, const Vector<uint8_t> &p_state) {
+	GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, false);
+	return space->restore_state(p_state);
+}
+
 RID GodotPhysicsServer2D::area_create() {
 	GodotArea2D *area = memnew(GodotArea2D);
 	RID rid = area_owner.make_rid(area);
@@ -1296,11 +1310,30 @@ void GodotPhysicsServer2D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	pairs_added = 0;
+	pairs_removed = 0;
+	query_count = 0;
+	slowest_island_time = 0;
+	const uint64_t begin_time = OS::get_singleton()->get_ticks_usec();
 	for (GodotSpace2D *E : active_spaces) {
 		stepper->step(E, p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
+		pairs_added += E->get_pairs_added();
+		pairs_removed += E->get_pairs_removed();
+		query_count += E->take_query_count();
+		slowest_island_time = MAX(slowest_island_time, E->get_slowest_island_time());
+	}
+	step_time = OS::get_singleton()->get_ticks_usec() - begin_time;
+
+	// Gathered here rather than when the monitors are read, since with physics on a separate thread
+	// the pair and object lists can only be walked safely from inside the step.
+	contact_count = 0;
+	sleeping_objects = 0;
+	for (const GodotSpace2D *E : active_spaces) {
+		contact_count += E->get_contact_count();
+		sleeping_objects += E->get_sleeping_objects();
 	}
 }
 
@@ -1383,6 +1416,27 @@ int GodotPhysicsServer2D::get_process_info(PS2DE::ProcessInfo p_info) {
 		case PS2DE::INFO_ISLAND_COUNT: {
 			return island_count;
 		} break;
+		case PS2DE::INFO_CONTACT_COUNT: {
+			return contact_count;
+		} break;
+		case PS2DE::INFO_SLEEPING_OBJECTS: {
+			return sleeping_objects;
+		} break;
+		case PS2DE::INFO_PAIRS_ADDED: {
+			return pairs_added;
+		} break;
+		case PS2DE::INFO_PAIRS_REMOVED: {
+			return pairs_removed;
+		} break;
+		case PS2DE::INFO_QUERY_COUNT: {
+			return query_count;
+		} break;
+		case PS2DE::INFO_STEP_TIME: {
+			return step_time;
+		} break;
+		case PS2DE::INFO_SLOWEST_ISLAND_TIME: {
+			return slowest_island_time;
+		} break;
 	}
 
 	return 0;
@@ -1392,7 +1446,11 @@ GodotPhysicsServer2D *GodotPhysicsServer2D::godot_singleton = nullptr;
 
 GodotPhysicsServer2D::GodotPhysicsServer2D(bool p_using_threads) {
 	godot_singleton = this;
-	GodotBroadPhase2D::create_func = GodotBroadPhase2DBVH::_create;
+	if (int(GLOBAL_GET("physics/godot_physics_2d/broadphase")) == 1) {
+		GodotBroadPhase2D::create_func = GodotBroadPhase2DHashGrid::_create;
+	} else {
+		GodotBroadPhase2D::create_func = GodotBroadPhase2DBVH::_create;
+	}
 
 	using_threads = p_using_threads;
 }
@@ -49,6 +49,13 @@ class GodotPhysicsServer2D : public PhysicsServer2D {
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	int pairs_added = 0;
+	int pairs_removed = 0;
+	int query_count = 0;
+	int contact_count = 0;
+	int sleeping_objects = 0;
+	uint64_t step_time = 0;
+	uint64_t slowest_island_time = 0;
 
 	bool using_threads = false;
 
@@ -115,6 +122,9 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual Vector<uint8_t> space_save_state(RID p_space) override;
+	virtual bool space_restore_state(RID p_space, const Vector<uint8_t> &p_state) override;
+
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState2D *space_get_direct_state(RID p_space) override;
 
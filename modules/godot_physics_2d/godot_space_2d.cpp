@@ -32,14 +32,21 @@
 
 #include "godot_area_pair_2d.h"
 #include "godot_body_pair_2d.h"
+#include "godot_broad_phase_2d_hash_grid.h"
 #include "godot_collision_solver_2d.h"
+#include "godot_joints_2d.h"
 #include "godot_physics_server_2d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/profiling/profiling.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
 
+// Amount of queries a worker thread runs at once when a query batch is split.
+#define QUERY_BATCH_CHUNK_SIZE 64
+
 _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject2D *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 	if (!(p_object->get_collision_layer() & p_collision_mask)) {
 		return false;
@@ -56,29 +63,29 @@ _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject2D *p_object, u
 	return true;
 }
 
-int GodotPhysicsDirectSpaceState2D::intersect_point(const PS2DT::PointParameters &p_parameters, PS2DT::ShapeResult *r_results, int p_result_max) {
+int GodotPhysicsDirectSpaceState2D::_intersect_point(const PS2DT::PointParameters &p_parameters, const Vector2 &p_position, PS2DT::ShapeResult *r_results, int p_result_max, GodotCollisionObject2D **r_cull_results, int *r_cull_subindex_results) {
 	if (p_result_max <= 0) {
 		return 0;
 	}
 
 	Rect2 aabb;
-	aabb.position = p_parameters.position - Vector2(0.00001, 0.00001);
+	aabb.position = p_position - Vector2(0.00001, 0.00001);
 	aabb.size = Vector2(0.00002, 0.00002);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, r_cull_results, GodotSpace2D::INTERSECTION_QUERY_MAX, r_cull_subindex_results);
 
 	int cc = 0;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject2D *col_obj = r_cull_results[i];
 
 		if (p_parameters.pick_point && !col_obj->is_pickable()) {
 			continue;
@@ -88,11 +95,11 @@ int GodotPhysicsDirectSpaceState2D::intersect_point(const PS2DT::PointParameters
 			continue;
 		}
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = r_cull_subindex_results[i];
 
 		GodotShape2D *shape = col_obj->get_shape(shape_idx);
 
-		Vector2 local_point = (col_obj->get_transform() * col_obj->get_shape_transform(shape_idx)).affine_inverse().xform(p_parameters.position);
+		Vector2 local_point = (col_obj->get_transform() * col_obj->get_shape_transform(shape_idx)).affine_inverse().xform(p_position);
 
 		if (!shape->contains_point(local_point)) {
 			continue;
@@ -115,16 +122,19 @@ int GodotPhysicsDirectSpaceState2D::intersect_point(const PS2DT::PointParameters
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState2D::intersect_ray(const PS2DT::RayParameters &p_parameters, PS2DT::RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
+int GodotPhysicsDirectSpaceState2D::intersect_point(const PS2DT::PointParameters &p_parameters, PS2DT::ShapeResult *r_results, int p_result_max) {
+	space->add_query_count(1);
+	return _intersect_point(p_parameters, p_parameters.position, r_results, p_result_max, space->intersection_query_results, space->intersection_query_subindex_results);
+}
 
+bool GodotPhysicsDirectSpaceState2D::_intersect_ray(const PS2DT::RayParameters &p_parameters, const Vector2 &p_from, const Vector2 &p_to, PS2DT::RayResult &r_result, GodotCollisionObject2D **r_cull_results, int *r_cull_subindex_results) {
 	Vector2 begin, end;
 	Vector2 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_segment(begin, end, r_cull_results, GodotSpace2D::INTERSECTION_QUERY_MAX, r_cull_subindex_results);
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -135,17 +145,17 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const PS2DT::RayParameters &p
 	real_t min_d = 1e10;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject2D *col_obj = r_cull_results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = r_cull_subindex_results[i];
 		Transform2D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector2 local_from = inv_xform.xform(begin);
@@ -205,7 +215,14 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const PS2DT::RayParameters &p
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState2D::intersect_ray(const PS2DT::RayParameters &p_parameters, PS2DT::RayResult &r_result) {
+	space->add_query_count(1);
+	ERR_FAIL_COND_V(space->locked, false);
+	return _intersect_ray(p_parameters, p_parameters.from, p_parameters.to, r_result, space->intersection_query_results, space->intersection_query_subindex_results);
+}
+
 int GodotPhysicsDirectSpaceState2D::intersect_shape(const PS2DT::ShapeParameters &p_parameters, PS2DT::ShapeResult *r_results, int p_result_max) {
+	space->add_query_count(1);
 	if (p_result_max <= 0) {
 		return 0;
 	}
@@ -254,43 +271,42 @@ int GodotPhysicsDirectSpaceState2D::intersect_shape(const PS2DT::ShapeParameters
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState2D::cast_motion(const PS2DT::ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) {
-	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, false);
+bool GodotPhysicsDirectSpaceState2D::_cast_motion(const PS2DT::ShapeParameters &p_parameters, GodotShape2D *p_shape, const Transform2D &p_transform, const Vector2 &p_motion, real_t &p_closest_safe, real_t &p_closest_unsafe, GodotCollisionObject2D **r_cull_results, int *r_cull_subindex_results) {
+	GodotShape2D *shape = p_shape;
 
-	Rect2 aabb = p_parameters.transform.xform(shape->get_aabb());
-	aabb = aabb.merge(Rect2(aabb.position + p_parameters.motion, aabb.size)); //motion
+	Rect2 aabb = p_transform.xform(shape->get_aabb());
+	aabb = aabb.merge(Rect2(aabb.position + p_motion, aabb.size)); //motion
 	aabb = aabb.grow(p_parameters.margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, r_cull_results, GodotSpace2D::INTERSECTION_QUERY_MAX, r_cull_subindex_results);
 
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue; //ignore excluded
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject2D *col_obj = r_cull_results[i];
+		int shape_idx = r_cull_subindex_results[i];
 
 		Transform2D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
-		if (!GodotCollisionSolver2D::solve(shape, p_parameters.transform, p_parameters.motion, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
+		if (!GodotCollisionSolver2D::solve(shape, p_transform, p_motion, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
 			continue;
 		}
 
 		//test initial overlap, ignore objects it's inside of.
-		if (GodotCollisionSolver2D::solve(shape, p_parameters.transform, Vector2(), col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
+		if (GodotCollisionSolver2D::solve(shape, p_transform, Vector2(), col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
 			continue;
 		}
 
-		Vector2 mnormal = p_parameters.motion.normalized();
+		Vector2 mnormal = p_motion.normalized();
 
 		//just do kinematic solving
 		real_t low = 0.0;
@@ -300,7 +316,7 @@ bool GodotPhysicsDirectSpaceState2D::cast_motion(const PS2DT::ShapeParameters &p
 			real_t fraction = low + (hi - low) * fraction_coeff;
 
 			Vector2 sep = mnormal; //important optimization for this to work fast enough
-			bool collided = GodotCollisionSolver2D::solve(shape, p_parameters.transform, p_parameters.motion * fraction, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, &sep, p_parameters.margin);
+			bool collided = GodotCollisionSolver2D::solve(shape, p_transform, p_motion * fraction, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, &sep, p_parameters.margin);
 
 			if (collided) {
 				hi = fraction;
@@ -337,7 +353,142 @@ bool GodotPhysicsDirectSpaceState2D::cast_motion(const PS2DT::ShapeParameters &p
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState2D::cast_motion(const PS2DT::ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) {
+	space->add_query_count(1);
+	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+
+	return _cast_motion(p_parameters, shape, p_parameters.transform, p_parameters.motion, p_closest_safe, p_closest_unsafe, space->intersection_query_results, space->intersection_query_subindex_results);
+}
+
+struct GodotPhysicsDirectSpaceState2D::QueryBatch {
+	enum Type {
+		TYPE_RAY,
+		TYPE_POINT,
+		TYPE_MOTION,
+	};
+
+	Type type = TYPE_RAY;
+	const PS2DT::RayParameters *ray_parameters = nullptr;
+	const PS2DT::PointParameters *point_parameters = nullptr;
+	const PS2DT::ShapeParameters *shape_parameters = nullptr;
+	GodotShape2D *shape = nullptr;
+
+	const Vector2 *points = nullptr; // Ray origins, point positions or shape origins.
+	const Vector2 *vectors = nullptr; // Ray ends or shape motions.
+	LocalVector<uint32_t> order;
+
+	PS2DT::RayResult *ray_results = nullptr;
+	PS2DT::ShapeResult *point_results = nullptr;
+	real_t *closest_safe = nullptr;
+	real_t *closest_unsafe = nullptr;
+
+	SafeNumeric<uint32_t> hit_count;
+};
+
+bool GodotPhysicsDirectSpaceState2D::_run_query(QueryBatch &p_batch, uint32_t p_index, GodotCollisionObject2D **r_cull_results, int *r_cull_subindex_results) {
+	switch (p_batch.type) {
+		case QueryBatch::TYPE_RAY: {
+			p_batch.ray_results[p_index] = PS2DT::RayResult();
+			return _intersect_ray(*p_batch.ray_parameters, p_batch.points[p_index], p_batch.vectors[p_index], p_batch.ray_results[p_index], r_cull_results, r_cull_subindex_results);
+		}
+		case QueryBatch::TYPE_POINT: {
+			p_batch.point_results[p_index] = PS2DT::ShapeResult();
+			return _intersect_point(*p_batch.point_parameters, p_batch.points[p_index], &p_batch.point_results[p_index], 1, r_cull_results, r_cull_subindex_results) > 0;
+		}
+		case QueryBatch::TYPE_MOTION: {
+			Transform2D transform = p_batch.shape_parameters->transform;
+			transform.columns[2] = p_batch.points[p_index];
+			p_batch.closest_safe[p_index] = 1.0;
+			p_batch.closest_unsafe[p_index] = 1.0;
+			return _cast_motion(*p_batch.shape_parameters, p_batch.shape, transform, p_batch.vectors[p_index], p_batch.closest_safe[p_index], p_batch.closest_unsafe[p_index], r_cull_results, r_cull_subindex_results);
+		}
+	}
+	return false;
+}
+
+void GodotPhysicsDirectSpaceState2D::_run_query_batch_chunk(uint32_t p_chunk_index, QueryBatch *p_batch) {
+	// The cull buffers of the space belong to the calling thread, each chunk uses its own.
+	LocalVector<GodotCollisionObject2D *> cull_results;
+	cull_results.resize(GodotSpace2D::INTERSECTION_QUERY_MAX);
+	LocalVector<int> cull_subindex_results;
+	cull_subindex_results.resize(GodotSpace2D::INTERSECTION_QUERY_MAX);
+
+	const uint32_t begin = p_chunk_index * QUERY_BATCH_CHUNK_SIZE;
+	const uint32_t end = MIN(begin + QUERY_BATCH_CHUNK_SIZE, p_batch->order.size());
+	uint32_t hit_count = 0;
+	for (uint32_t i = begin; i < end; i++) {
+		if (_run_query(*p_batch, p_batch->order[i], cull_results.ptr(), cull_subindex_results.ptr())) {
+			hit_count++;
+		}
+	}
+	p_batch->hit_count.add(hit_count);
+}
+
+int GodotPhysicsDirectSpaceState2D::_run_query_batch(QueryBatch &p_batch, int p_count) {
+	_sort_queries_spatially(p_batch.points, p_count, p_batch.order);
+
+	if (p_count <= QUERY_BATCH_CHUNK_SIZE || WorkerThreadPool::get_singleton()->get_thread_count() < 2) {
+		int hit_count = 0;
+		for (uint32_t index : p_batch.order) {
+			if (_run_query(p_batch, index, space->intersection_query_results, space->intersection_query_subindex_results)) {
+				hit_count++;
+			}
+		}
+		return hit_count;
+	}
+
+	const uint32_t chunk_count = (p_count + QUERY_BATCH_CHUNK_SIZE - 1) / QUERY_BATCH_CHUNK_SIZE;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState2D::_run_query_batch_chunk, &p_batch, chunk_count, -1, true, SNAME("Physics2DQueryBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	return p_batch.hit_count.get();
+}
+
+int GodotPhysicsDirectSpaceState2D::intersect_rays(const PS2DT::RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, PS2DT::RayResult *r_results) {
+	space->add_query_count(p_count);
+	ERR_FAIL_COND_V(space->locked, 0);
+
+	QueryBatch batch;
+	batch.type = QueryBatch::TYPE_RAY;
+	batch.ray_parameters = &p_parameters;
+	batch.points = p_from;
+	batch.vectors = p_to;
+	batch.ray_results = r_results;
+	return _run_query_batch(batch, p_count);
+}
+
+int GodotPhysicsDirectSpaceState2D::intersect_points(const PS2DT::PointParameters &p_parameters, const Vector2 *p_positions, int p_count, PS2DT::ShapeResult *r_results) {
+	space->add_query_count(p_count);
+	ERR_FAIL_COND_V(space->locked, 0);
+
+	QueryBatch batch;
+	batch.type = QueryBatch::TYPE_POINT;
+	batch.point_parameters = &p_parameters;
+	batch.points = p_positions;
+	batch.point_results = r_results;
+	return _run_query_batch(batch, p_count);
+}
+
+bool GodotPhysicsDirectSpaceState2D::cast_motions(const PS2DT::ShapeParameters &p_parameters, const Vector2 *p_origins, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	space->add_query_count(p_count);
+	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+
+	QueryBatch batch;
+	batch.type = QueryBatch::TYPE_MOTION;
+	batch.shape_parameters = &p_parameters;
+	batch.shape = shape;
+	batch.points = p_origins;
+	batch.vectors = p_motions;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+	_run_query_batch(batch, p_count);
+	return true;
+}
+
 bool GodotPhysicsDirectSpaceState2D::collide_shape(const PS2DT::ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) {
+	space->add_query_count(1);
 	if (p_result_max <= 0) {
 		return false;
 	}
@@ -439,6 +590,7 @@ static void _rest_cbk_result(const Vector2 &p_point_A, const Vector2 &p_point_B,
 }
 
 bool GodotPhysicsDirectSpaceState2D::rest_info(const PS2DT::ShapeParameters &p_parameters, PS2DT::ShapeRestInfo *r_info) {
+	space->add_query_count(1);
 	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
 	ERR_FAIL_NULL_V(shape, false);
 
@@ -1021,6 +1173,7 @@ void *GodotSpace2D::_broadphase_pair(GodotCollisionObject2D *A, int p_subindex_A
 
 	GodotSpace2D *self = static_cast<GodotSpace2D *>(p_self);
 	self->collision_pairs++;
+	self->pairs_added++;
 
 	if (type_A == GodotCollisionObject2D::TYPE_AREA) {
 		GodotArea2D *area = static_cast<GodotArea2D *>(A);
@@ -1035,7 +1188,22 @@ void *GodotSpace2D::_broadphase_pair(GodotCollisionObject2D *A, int p_subindex_A
 		}
 
 	} else {
+		if (A->get_sequence() > B->get_sequence()) {
+			// Keep the same body first however the broadphase reports the pair, so snapshots can find its contacts again.
+			SWAP(A, B);
+			SWAP(p_subindex_A, p_subindex_B);
+		}
 		GodotBodyPair2D *b = memnew(GodotBodyPair2D(static_cast<GodotBody2D *>(A), p_subindex_A, static_cast<GodotBody2D *>(B), p_subindex_B));
+
+		if (!self->pending_pair_states.is_empty()) {
+			HashMap<PairKey, uint32_t, PairKeyHasher>::Iterator E = self->pending_pair_states.find(_get_pair_key(b));
+			if (E) {
+				GodotBodyPair2D::SnapshotState state;
+				memcpy(&state, self->pending_pair_state_data.ptr() + E->value, sizeof(GodotBodyPair2D::SnapshotState));
+				b->restore_snapshot_state(state);
+				self->pending_pair_states.remove(E);
+			}
+		}
 		return b;
 	}
 }
@@ -1047,10 +1215,38 @@ void GodotSpace2D::_broadphase_unpair(GodotCollisionObject2D *A, int p_subindex_
 
 	GodotSpace2D *self = static_cast<GodotSpace2D *>(p_self);
 	self->collision_pairs--;
+	self->pairs_removed++;
 	GodotConstraint2D *c = static_cast<GodotConstraint2D *>(p_data);
 	memdelete(c);
 }
 
+int GodotSpace2D::get_contact_count() const {
+	int count = 0;
+	for (const SelfList<GodotBodyPair2D> *E = body_pair_list.first(); E; E = E->next()) {
+		count += E->self()->get_contact_count();
+	}
+	return count;
+}
+
+int GodotSpace2D::get_sleeping_objects() const {
+	int count = 0;
+	for (const GodotCollisionObject2D *E : objects) {
+		if (E->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			const GodotBody2D *body = static_cast<const GodotBody2D *>(E);
+			if (body->get_mode() >= PS2DE::BODY_MODE_RIGID && !body->is_active()) {
+				count++;
+			}
+		}
+	}
+	return count;
+}
+
+uint32_t GodotSpace2D::take_query_count() {
+	const uint32_t count = query_count.get();
+	query_count.sub(count);
+	return count;
+}
+
 const SelfList<GodotBody2D>::List &GodotSpace2D::get_active_body_list() const {
 	return active_list;
 }
@@ -1078,11 +1274,14 @@ GodotBroadPhase2D *GodotSpace2D::get_broadphase() {
 void GodotSpace2D::add_object(GodotCollisionObject2D *p_object) {
 	ERR_FAIL_COND(objects.has(p_object));
 	objects.insert(p_object);
+	p_object->set_sequence(next_object_sequence++);
+	sorted_bodies_dirty = true;
 }
 
 void GodotSpace2D::remove_object(GodotCollisionObject2D *p_object) {
 	ERR_FAIL_COND(!objects.has(p_object));
 	objects.erase(p_object);
+	sorted_bodies_dirty = true;
 }
 
 const HashSet<GodotCollisionObject2D *> &GodotSpace2D::get_objects() const {
@@ -1117,6 +1316,274 @@ const SelfList<GodotArea2D>::List &GodotSpace2D::get_moved_area_list() const {
 	return area_moved_list;
 }
 
+void GodotSpace2D::body_pair_add_to_list(SelfList<GodotBodyPair2D> *p_pair) {
+	body_pair_list.add(p_pair);
+}
+
+void GodotSpace2D::_update_sorted_bodies() {
+	sorted_bodies.clear();
+	for (GodotCollisionObject2D *E : objects) {
+		if (E->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			sorted_bodies.push_back(static_cast<GodotBody2D *>(E));
+		}
+	}
+
+	struct BodySequenceCompare {
+		_FORCE_INLINE_ bool operator()(const GodotBody2D *p_a, const GodotBody2D *p_b) const { return p_a->get_sequence() < p_b->get_sequence(); }
+	};
+	sorted_bodies.sort_custom<BodySequenceCompare>();
+	sorted_bodies_dirty = false;
+}
+
+const LocalVector<GodotBody2D *> &GodotSpace2D::get_sorted_bodies() {
+	if (sorted_bodies_dirty) {
+		_update_sorted_bodies();
+	}
+	return sorted_bodies;
+}
+
+GodotSpace2D::PairKey GodotSpace2D::_get_pair_key(const GodotBodyPair2D *p_pair) {
+	PairKey key;
+	key.sequence_A = p_pair->get_body_A()->get_sequence();
+	key.sequence_B = p_pair->get_body_B()->get_sequence();
+	key.shape_A = p_pair->get_shape_A();
+	key.shape_B = p_pair->get_shape_B();
+	return key;
+}
+
+namespace {
+
+constexpr uint32_t SNAPSHOT_MAGIC = 0x53325350; // "PS2S"
+constexpr uint32_t SNAPSHOT_VERSION = 2;
+
+struct SnapshotHeader {
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t real_size = 0;
+	uint32_t body_count = 0;
+	uint32_t pair_count = 0;
+	uint32_t joint_count = 0;
+	uint32_t checksum = 0; // Of the records after the header.
+};
+
+struct SnapshotBody {
+	uint64_t sequence = 0;
+	GodotBody2D::SnapshotState state;
+};
+
+struct SnapshotPair {
+	uint64_t sequence_A = 0;
+	uint64_t sequence_B = 0;
+	int32_t shape_A = 0;
+	int32_t shape_B = 0;
+	GodotBodyPair2D::SnapshotState state;
+};
+
+// Joint order keys come from a global counter, so joints are matched by their rank among the joints of the space.
+struct SnapshotJoint {
+	uint32_t type = 0;
+	GodotJoint2D::SnapshotState state;
+};
+
+// Joints aren't tracked by the space, they're found through the constraints of its bodies.
+void _get_sorted_joints(const LocalVector<GodotBody2D *> &p_bodies, LocalVector<GodotJoint2D *> &r_joints) {
+	for (const GodotBody2D *body : p_bodies) {
+		for (const Pair<GodotConstraint2D *, int> &E : body->get_constraint_list()) {
+			if (E.first->is_joint()) {
+				r_joints.push_back(static_cast<GodotJoint2D *>(E.first));
+			}
+		}
+	}
+
+	struct JointOrderCompare {
+		_FORCE_INLINE_ bool operator()(const GodotJoint2D *p_a, const GodotJoint2D *p_b) const { return p_a->get_order_key() < p_b->get_order_key(); }
+	};
+	r_joints.sort_custom<JointOrderCompare>();
+
+	// Joints between two bodies of the space were found twice.
+	uint32_t unique_count = 0;
+	for (uint32_t i = 0; i < r_joints.size(); i++) {
+		if (unique_count == 0 || r_joints[unique_count - 1] != r_joints[i]) {
+			r_joints[unique_count++] = r_joints[i];
+		}
+	}
+	r_joints.resize(unique_count);
+}
+
+} // namespace
+
+Vector<uint8_t> GodotSpace2D::save_state() {
+	ERR_FAIL_COND_V_MSG(locked, Vector<uint8_t>(), "Space state can't be saved while the space is being stepped.");
+
+	const LocalVector<GodotBody2D *> &bodies = get_sorted_bodies();
+
+	// Pairs are sorted by key, so that the same world always gives the same bytes.
+	struct SortedPair {
+		PairKey key;
+		const GodotBodyPair2D *pair = nullptr;
+
+		bool operator<(const SortedPair &p_other) const {
+			if (key.sequence_A != p_other.key.sequence_A) {
+				return key.sequence_A < p_other.key.sequence_A;
+			}
+			if (key.sequence_B != p_other.key.sequence_B) {
+				return key.sequence_B < p_other.key.sequence_B;
+			}
+			if (key.shape_A != p_other.key.shape_A) {
+				return key.shape_A < p_other.key.shape_A;
+			}
+			return key.shape_B < p_other.key.shape_B;
+		}
+	};
+
+	LocalVector<SortedPair> pairs;
+	for (const SelfList<GodotBodyPair2D> *E = body_pair_list.first(); E; E = E->next()) {
+		SortedPair sorted_pair;
+		sorted_pair.key = _get_pair_key(E->self());
+		sorted_pair.pair = E->self();
+		pairs.push_back(sorted_pair);
+	}
+	pairs.sort();
+
+	LocalVector<GodotJoint2D *> joints;
+	_get_sorted_joints(bodies, joints);
+
+	Vector<uint8_t> data;
+	data.resize(sizeof(SnapshotHeader) + bodies.size() * sizeof(SnapshotBody) + pairs.size() * sizeof(SnapshotPair) + joints.size() * sizeof(SnapshotJoint));
+	uint8_t *w = data.ptrw();
+
+	// The header is written last, once the checksum of the records is known.
+	w += sizeof(SnapshotHeader);
+
+	// Records are built in zeroed memory, so that padding bytes don't leak into the snapshot.
+	SnapshotBody body_record;
+	for (const GodotBody2D *body : bodies) {
+		memset((void *)&body_record, 0, sizeof(SnapshotBody));
+		body_record.sequence = body->get_sequence();
+		body->save_snapshot_state(body_record.state);
+		memcpy(w, &body_record, sizeof(SnapshotBody));
+		w += sizeof(SnapshotBody);
+	}
+
+	SnapshotPair pair_record;
+	for (const SortedPair &sorted_pair : pairs) {
+		memset((void *)&pair_record, 0, sizeof(SnapshotPair));
+		pair_record.sequence_A = sorted_pair.key.sequence_A;
+		pair_record.sequence_B = sorted_pair.key.sequence_B;
+		pair_record.shape_A = sorted_pair.key.shape_A;
+		pair_record.shape_B = sorted_pair.key.shape_B;
+		sorted_pair.pair->save_snapshot_state(pair_record.state);
+		memcpy(w, &pair_record, sizeof(SnapshotPair));
+		w += sizeof(SnapshotPair);
+	}
+
+	SnapshotJoint joint_record;
+	for (const GodotJoint2D *joint : joints) {
+		memset((void *)&joint_record, 0, sizeof(SnapshotJoint));
+		joint_record.type = joint->get_type();
+		joint->save_snapshot_state(joint_record.state);
+		memcpy(w, &joint_record, sizeof(SnapshotJoint));
+		w += sizeof(SnapshotJoint);
+	}
+
+	SnapshotHeader header;
+	memset((void *)&header, 0, sizeof(SnapshotHeader));
+	header.magic = SNAPSHOT_MAGIC;
+	header.version = SNAPSHOT_VERSION;
+	header.real_size = sizeof(real_t);
+	header.body_count = bodies.size();
+	header.pair_count = pairs.size();
+	header.joint_count = joints.size();
+	header.checksum = hash_murmur3_buffer(data.ptr() + sizeof(SnapshotHeader), data.size() - sizeof(SnapshotHeader));
+	memcpy(data.ptrw(), &header, sizeof(SnapshotHeader));
+
+	return data;
+}
+
+bool GodotSpace2D::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_V_MSG(locked, false, "Space state can't be restored while the space is being stepped.");
+	ERR_FAIL_COND_V(p_state.size() < (int64_t)sizeof(SnapshotHeader), false);
+
+	const uint8_t *r = p_state.ptr();
+
+	SnapshotHeader header;
+	memcpy(&header, r, sizeof(SnapshotHeader));
+	ERR_FAIL_COND_V_MSG(header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION, false, "Invalid space state.");
+	ERR_FAIL_COND_V_MSG(header.real_size != sizeof(real_t), false, "Space state was saved with a different floating-point precision.");
+	ERR_FAIL_COND_V(uint64_t(p_state.size()) != sizeof(SnapshotHeader) + uint64_t(header.body_count) * sizeof(SnapshotBody) + uint64_t(header.pair_count) * sizeof(SnapshotPair) + uint64_t(header.joint_count) * sizeof(SnapshotJoint), false);
+	ERR_FAIL_COND_V_MSG(header.checksum != hash_murmur3_buffer(r + sizeof(SnapshotHeader), p_state.size() - sizeof(SnapshotHeader)), false, "Space state is corrupted.");
+	r += sizeof(SnapshotHeader);
+
+	// Both the records and the bodies are sorted by sequence, and the joint records by rank. They're checked
+	// before anything is restored, so that a state saved with other bodies or joints leaves the space untouched.
+	const LocalVector<GodotBody2D *> &bodies = get_sorted_bodies();
+	ERR_FAIL_COND_V_MSG(header.body_count != bodies.size(), false, "Space state doesn't match the bodies of the space.");
+	SnapshotBody body_record;
+	for (uint32_t i = 0; i < header.body_count; i++) {
+		memcpy(&body_record, r + i * sizeof(SnapshotBody), sizeof(SnapshotBody));
+		ERR_FAIL_COND_V_MSG(bodies[i]->get_sequence() != body_record.sequence, false, "Space state doesn't match the bodies of the space.");
+	}
+
+	LocalVector<GodotJoint2D *> joints;
+	_get_sorted_joints(bodies, joints);
+	ERR_FAIL_COND_V_MSG(header.joint_count != joints.size(), false, "Space state doesn't match the joints of the space.");
+	const uint8_t *joint_records = r + uint64_t(header.body_count) * sizeof(SnapshotBody) + uint64_t(header.pair_count) * sizeof(SnapshotPair);
+	SnapshotJoint joint_record;
+	for (uint32_t i = 0; i < header.joint_count; i++) {
+		memcpy(&joint_record, joint_records + i * sizeof(SnapshotJoint), sizeof(SnapshotJoint));
+		ERR_FAIL_COND_V_MSG(uint32_t(joints[i]->get_type()) != joint_record.type, false, "Space state doesn't match the joints of the space.");
+	}
+
+	for (uint32_t i = 0; i < header.body_count; i++) {
+		memcpy(&body_record, r, sizeof(SnapshotBody));
+		r += sizeof(SnapshotBody);
+		bodies[i]->restore_snapshot_state(body_record.state);
+	}
+
+	// Pairs the broadphase still has get their contacts back right away, the others once they're created again.
+	pending_pair_states.clear();
+	pending_pair_state_data = p_state;
+
+	PairKey key;
+	SnapshotPair pair_record;
+	for (uint32_t i = 0; i < header.pair_count; i++) {
+		const uint32_t offset = r - p_state.ptr();
+		memcpy(&pair_record, r, sizeof(SnapshotPair));
+		r += sizeof(SnapshotPair);
+
+		key.sequence_A = pair_record.sequence_A;
+		key.sequence_B = pair_record.sequence_B;
+		key.shape_A = pair_record.shape_A;
+		key.shape_B = pair_record.shape_B;
+		pending_pair_states.insert(key, offset + offsetof(SnapshotPair, state));
+	}
+
+	for (SelfList<GodotBodyPair2D> *E = body_pair_list.first(); E; E = E->next()) {
+		GodotBodyPair2D *pair = E->self();
+		HashMap<PairKey, uint32_t, PairKeyHasher>::Iterator F = pending_pair_states.find(_get_pair_key(pair));
+		if (F) {
+			GodotBodyPair2D::SnapshotState state;
+			memcpy(&state, pending_pair_state_data.ptr() + F->value, sizeof(GodotBodyPair2D::SnapshotState));
+			pair->restore_snapshot_state(state);
+			pending_pair_states.remove(F);
+		} else {
+			pair->clear_contacts();
+		}
+	}
+
+	if (pending_pair_states.is_empty()) {
+		pending_pair_state_data.clear();
+	}
+
+	for (uint32_t i = 0; i < header.joint_count; i++) {
+		memcpy(&joint_record, r, sizeof(SnapshotJoint));
+		r += sizeof(SnapshotJoint);
+		joints[i]->restore_snapshot_state(joint_record.state);
+	}
+
+	return true;
+}
+
 void GodotSpace2D::call_queries() {
 	while (state_query_list.first()) {
 		GodotBody2D *b = state_query_list.first()->self();
@@ -1141,7 +1608,12 @@ void GodotSpace2D::setup() {
 }
 
 void GodotSpace2D::update() {
+	GodotProfileZone("GodotSpace2D::update");
 	broadphase->update();
+
+	// Pairs from a restored snapshot that weren't created again are out of contact now.
+	pending_pair_states.clear();
+	pending_pair_state_data.clear();
 }
 
 void GodotSpace2D::set_param(PS2DE::SpaceParameter p_param, real_t p_value) {
@@ -1227,7 +1699,14 @@ GodotSpace2D::GodotSpace2D() {
 	contact_bias = GLOBAL_GET("physics/2d/solver/default_contact_bias");
 	constraint_bias = GLOBAL_GET("physics/2d/solver/default_constraint_bias");
 
-	broadphase = GodotBroadPhase2D::create_func();
+	deterministic = GLOBAL_GET("physics/godot_physics_2d/deterministic");
+
+	if (deterministic) {
+		// The hash grid's pairs only depend on the current bounds, not on the order objects were moved in.
+		broadphase = GodotBroadPhase2DHashGrid::_create();
+	} else {
+		broadphase = GodotBroadPhase2D::create_func();
+	}
 	broadphase->set_pair_callback(_broadphase_pair, this);
 	broadphase->set_unpair_callback(_broadphase_unpair, this);
 
@@ -35,12 +35,26 @@
 #include "godot_broad_phase_2d.h"
 #include "godot_collision_object_2d.h"
 
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "core/typedefs.h"
 #include "servers/physics_2d/direct_states/physics_direct_space_state_2d.h"
 
 class GodotPhysicsDirectSpaceState2D : public PhysicsDirectSpaceState2D {
 	GDCLASS(GodotPhysicsDirectSpaceState2D, PhysicsDirectSpaceState2D);
 
+	struct QueryBatch;
+
+	// Query implementations culling into the given buffers, so that batches can run them from several threads.
+	int _intersect_point(const PS2DT::PointParameters &p_parameters, const Vector2 &p_position, PS2DT::ShapeResult *r_results, int p_result_max, GodotCollisionObject2D **r_cull_results, int *r_cull_subindex_results);
+	bool _intersect_ray(const PS2DT::RayParameters &p_parameters, const Vector2 &p_from, const Vector2 &p_to, PS2DT::RayResult &r_result, GodotCollisionObject2D **r_cull_results, int *r_cull_subindex_results);
+	bool _cast_motion(const PS2DT::ShapeParameters &p_parameters, GodotShape2D *p_shape, const Transform2D &p_transform, const Vector2 &p_motion, real_t &p_closest_safe, real_t &p_closest_unsafe, GodotCollisionObject2D **r_cull_results, int *r_cull_subindex_results);
+
+	bool _run_query(QueryBatch &p_batch, uint32_t p_index, GodotCollisionObject2D **r_cull_results, int *r_cull_subindex_results);
+	void _run_query_batch_chunk(uint32_t p_chunk_index, QueryBatch *p_batch);
+	int _run_query_batch(QueryBatch &p_batch, int p_count);
+
 public:
 	GodotSpace2D *space = nullptr;
 
@@ -51,9 +65,15 @@ public:
 	virtual bool collide_shape(const PS2DT::ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) override;
 	virtual bool rest_info(const PS2DT::ShapeParameters &p_parameters, PS2DT::ShapeRestInfo *r_info) override;
 
+	virtual int intersect_rays(const PS2DT::RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, PS2DT::RayResult *r_results) override;
+	virtual int intersect_points(const PS2DT::PointParameters &p_parameters, const Vector2 *p_positions, int p_count, PS2DT::ShapeResult *r_results) override;
+	virtual bool cast_motions(const PS2DT::ShapeParameters &p_parameters, const Vector2 *p_origins, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) override;
+
 	GodotPhysicsDirectSpaceState2D() {}
 };
 
+class GodotBodyPair2D;
+
 class GodotSpace2D {
 public:
 	enum ElapsedTime {
@@ -84,12 +104,48 @@ private:
 	SelfList<GodotBody2D>::List state_query_list;
 	SelfList<GodotArea2D>::List monitor_query_list;
 	SelfList<GodotArea2D>::List area_moved_list;
+	SelfList<GodotBodyPair2D>::List body_pair_list;
 
 	static void *_broadphase_pair(GodotCollisionObject2D *A, int p_subindex_A, GodotCollisionObject2D *B, int p_subindex_B, void *p_self);
 	static void _broadphase_unpair(GodotCollisionObject2D *A, int p_subindex_A, GodotCollisionObject2D *B, int p_subindex_B, void *p_data, void *p_self);
 
 	HashSet<GodotCollisionObject2D *> objects;
 
+	// In deterministic mode, bodies are stepped and pairs are solved in the order they were added to the space
+	// instead of the order of pointers, hashes and broadphase callbacks.
+	bool deterministic = false;
+
+	LocalVector<GodotBody2D *> sorted_bodies;
+	bool sorted_bodies_dirty = true;
+	uint64_t next_object_sequence = 1;
+
+	struct PairKey {
+		uint64_t sequence_A = 0;
+		uint64_t sequence_B = 0;
+		int32_t shape_A = 0;
+		int32_t shape_B = 0;
+
+		bool operator==(const PairKey &p_key) const { return sequence_A == p_key.sequence_A && sequence_B == p_key.sequence_B && shape_A == p_key.shape_A && shape_B == p_key.shape_B; }
+	};
+
+	struct PairKeyHasher {
+		static _FORCE_INLINE_ uint32_t hash(const PairKey &p_key) {
+			uint32_t h = hash_murmur3_one_64(p_key.sequence_A);
+			h = hash_murmur3_one_64(p_key.sequence_B, h);
+			h = hash_murmur3_one_32(p_key.shape_A, h);
+			h = hash_murmur3_one_32(p_key.shape_B, h);
+			return hash_fmix32(h);
+		}
+	};
+
+	// Contact caches from a restored snapshot for pairs the broadphase hasn't created yet,
+	// as offsets of their records in the snapshot.
+	HashMap<PairKey, uint32_t, PairKeyHasher> pending_pair_states;
+	Vector<uint8_t> pending_pair_state_data;
+
+	static PairKey _get_pair_key(const GodotBodyPair2D *p_pair);
+	void _update_sorted_bodies();
+
 	GodotArea2D *area = nullptr;
 
 	int solver_iterations = 0;
@@ -118,6 +174,11 @@ private:
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	int pairs_added = 0;
+	int pairs_removed = 0;
+	uint64_t slowest_island_time = 0;
+	// Direct space state queries can run from any thread.
+	SafeNumeric<uint32_t> query_count;
 
 	int _cull_aabb_for_body(GodotBody2D *p_body, const Rect2 &p_aabb);
 
@@ -148,12 +209,21 @@ public:
 	void area_add_to_monitor_query_list(SelfList<GodotArea2D> *p_area);
 	void area_remove_from_monitor_query_list(SelfList<GodotArea2D> *p_area);
 
+	void body_pair_add_to_list(SelfList<GodotBodyPair2D> *p_pair);
+	const SelfList<GodotBodyPair2D>::List &get_body_pair_list() const { return body_pair_list; }
+
 	GodotBroadPhase2D *get_broadphase();
 
 	void add_object(GodotCollisionObject2D *p_object);
 	void remove_object(GodotCollisionObject2D *p_object);
 	const HashSet<GodotCollisionObject2D *> &get_objects() const;
 
+	_FORCE_INLINE_ bool is_deterministic() const { return deterministic; }
+	const LocalVector<GodotBody2D *> &get_sorted_bodies();
+
+	Vector<uint8_t> save_state();
+	bool restore_state(const Vector<uint8_t> &p_state);
+
 	_FORCE_INLINE_ int get_solver_iterations() const { return solver_iterations; }
 	_FORCE_INLINE_ real_t get_contact_recycle_radius() const { return contact_recycle_radius; }
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
@@ -185,6 +255,23 @@ public:
 	int get_active_objects() const { return active_objects; }
 
 	int get_collision_pairs() const { return collision_pairs; }
+	int get_contact_count() const;
+	int get_sleeping_objects() const;
+
+	// Broadphase pairs created and removed since the start of the step.
+	void reset_pair_churn() {
+		pairs_added = 0;
+		pairs_removed = 0;
+	}
+	int get_pairs_added() const { return pairs_added; }
+	int get_pairs_removed() const { return pairs_removed; }
+
+	void set_slowest_island_time(uint64_t p_usec) { slowest_island_time = p_usec; }
+	uint64_t get_slowest_island_time() const { return slowest_island_time; }
+
+	_FORCE_INLINE_ void add_query_count(uint32_t p_count) { query_count.add(p_count); }
+	// Returns the number of queries made since the last call.
+	uint32_t take_query_count();
 
 	bool test_body_motion(GodotBody2D *p_body, const PS2DT::MotionParameters &p_parameters, PS2DT::MotionResult *r_result);
 
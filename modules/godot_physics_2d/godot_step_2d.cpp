@@ -34,6 +34,7 @@
 
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/profiling/profiling.h"
 
 #define BODY_ISLAND_COUNT_RESERVE 128
 #define BODY_ISLAND_SIZE_RESERVE 512
@@ -41,6 +42,21 @@
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
+void GodotStep2D::_gather_active_bodies(GodotSpace2D *p_space) {
+	active_bodies.clear();
+	for (const SelfList<GodotBody2D> *b = p_space->get_active_body_list().first(); b; b = b->next()) {
+		active_bodies.push_back(b->self());
+	}
+
+	if (p_space->is_deterministic()) {
+		// The active list is in activation order, which depends on how bodies were woken up.
+		struct BodySequenceCompare {
+			_FORCE_INLINE_ bool operator()(const GodotBody2D *p_a, const GodotBody2D *p_b) const { return p_a->get_sequence() < p_b->get_sequence(); }
+		};
+		active_bodies.sort_custom<BodySequenceCompare>();
+	}
+}
+
 void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
 
@@ -92,7 +108,10 @@ void GodotStep2D::_pre_solve_island(LocalVector<GodotConstraint2D *> &p_constrai
 	p_constraint_island.resize(valid_constraint_count);
 }
 
-void GodotStep2D::_solve_island(uint32_t p_island_index, void *p_userdata) const {
+void GodotStep2D::_solve_island(uint32_t p_island_index, void *p_userdata) {
+	GodotProfileZone("GodotStep2D::_solve_island");
+	const uint64_t begin_time = OS::get_singleton()->get_ticks_usec();
+
 	const LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[p_island_index];
 
 	for (int i = 0; i < iterations; i++) {
@@ -101,6 +120,8 @@ void GodotStep2D::_solve_island(uint32_t p_island_index, void *p_userdata) const
 			constraint_island[constraint_index]->solve(delta);
 		}
 	}
+
+	island_solve_times[p_island_index] = OS::get_singleton()->get_ticks_usec() - begin_time;
 }
 
 void GodotStep2D::_check_suspend(LocalVector<GodotBody2D *> &p_body_island) const {
@@ -128,8 +149,13 @@ void GodotStep2D::_check_suspend(LocalVector<GodotBody2D *> &p_body_island) cons
 }
 
 void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
+	GodotProfileZone("GodotStep2D::step");
+	GodotProfileZoneGroupedFirst(_profile_zone, "integrate_forces");
+
 	p_space->lock(); // can't access space during this
 
+	p_space->reset_pair_churn();
+
 	p_space->setup(); //update inertias, etc
 
 	p_space->set_last_step(p_delta);
@@ -137,23 +163,18 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	iterations = p_space->get_solver_iterations();
 	delta = p_delta;
 
-	const SelfList<GodotBody2D>::List *body_list = &p_space->get_active_body_list();
-
 	/* INTEGRATE FORCES */
 
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	_gather_active_bodies(p_space);
 
-	const SelfList<GodotBody2D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	for (GodotBody2D *body : active_bodies) {
+		body->integrate_forces(p_delta);
 	}
 
-	p_space->set_active_objects(active_count);
+	p_space->set_active_objects(active_bodies.size());
 
 	// Update the broadphase to register collision pairs.
 	p_space->update();
@@ -164,6 +185,8 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
+	GodotProfileZoneGrouped(_profile_zone, "generate_islands");
+
 	/* GENERATE CONSTRAINT ISLANDS FOR MOVING AREAS */
 
 	uint32_t island_count = 0;
@@ -194,13 +217,12 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
+	// Pairing may have woken up kinematic bodies.
+	_gather_active_bodies(p_space);
 
 	uint32_t body_island_count = 0;
 
-	while (b) {
-		GodotBody2D *body = b->self();
-
+	for (GodotBody2D *body : active_bodies) {
 		if (body->get_island_step() != _step) {
 			++body_island_count;
 			if (body_islands.size() < body_island_count) {
@@ -228,7 +250,32 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 				--island_count;
 			}
 		}
-		b = b->next();
+	}
+
+	if (p_space->is_deterministic()) {
+		// Islands are built by walking each body's constraints, which are in pairing order.
+		// Solve them in an order that only depends on the bodies involved instead.
+		struct ConstraintCompare {
+			_FORCE_INLINE_ bool operator()(const GodotConstraint2D *p_a, const GodotConstraint2D *p_b) const {
+				const int count_a = p_a->get_body_count();
+				const int count_b = p_b->get_body_count();
+				for (int i = 0; i < MIN(count_a, count_b); i++) {
+					const uint64_t sequence_a = p_a->get_body_ptr()[i]->get_sequence();
+					const uint64_t sequence_b = p_b->get_body_ptr()[i]->get_sequence();
+					if (sequence_a != sequence_b) {
+						return sequence_a < sequence_b;
+					}
+				}
+				if (count_a != count_b) {
+					return count_a < count_b;
+				}
+				return p_a->get_order_key() < p_b->get_order_key();
+			}
+		};
+
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			constraint_islands[island_index].sort_custom<ConstraintCompare>();
+		}
 	}
 
 	p_space->set_island_count((int)island_count);
@@ -239,6 +286,8 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
+	GodotProfileZoneGrouped(_profile_zone, "setup_constraints");
+
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
@@ -251,6 +300,8 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
+	GodotProfileZoneGrouped(_profile_zone, "solve_constraints");
+
 	/* PRE-SOLVE CONSTRAINT ISLANDS */
 
 	// WARNING: This doesn't run on threads, because it involves thread-unsafe processing.
@@ -262,22 +313,31 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
+	island_solve_times.resize(island_count);
 	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSolveIslands"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
+	uint64_t slowest_island_time = 0;
+	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+		slowest_island_time = MAX(slowest_island_time, island_solve_times[island_index]);
+	}
+	p_space->set_slowest_island_time(slowest_island_time);
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
 		profile_begtime = profile_endtime;
 	}
 
+	GodotProfileZoneGrouped(_profile_zone, "integrate_velocities");
+
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody2D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n; // in case it shuts itself down
+	// Solving may have woken up bodies.
+	_gather_active_bodies(p_space);
+
+	for (GodotBody2D *body : active_bodies) {
+		body->integrate_velocities(p_delta);
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
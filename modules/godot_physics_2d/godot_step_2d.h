@@ -43,11 +43,15 @@ class GodotStep2D {
 	LocalVector<LocalVector<GodotBody2D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint2D *>> constraint_islands;
 	LocalVector<GodotConstraint2D *> all_constraints;
+	LocalVector<GodotBody2D *> active_bodies;
+	// Time spent solving each island in the current step, in microseconds.
+	LocalVector<uint64_t> island_solve_times;
 
+	void _gather_active_bodies(GodotSpace2D *p_space);
 	void _populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint2D *> &p_constraint_island) const;
-	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr) const;
+	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
 	void _check_suspend(LocalVector<GodotBody2D *> &p_body_island) const;
 
 public:
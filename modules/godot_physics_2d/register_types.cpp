@@ -54,6 +54,12 @@ void initialize_godot_physics_2d_module(ModuleInitializationLevel p_level) {
 	if (p_level != MODULE_INITIALIZATION_LEVEL_SERVERS) {
 		return;
 	}
+
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/godot_physics_2d/broadphase", PROPERTY_HINT_ENUM, "BVH,Hash Grid"), 0);
+	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/godot_physics_2d/hash_grid/cell_size", PROPERTY_HINT_RANGE, "1,1024,1,or_greater,suffix:px"), 128.0);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/godot_physics_2d/hash_grid/max_object_cells", PROPERTY_HINT_RANGE, "1,4096,1,or_greater"), 512);
+	GLOBAL_DEF("physics/godot_physics_2d/deterministic", false);
+
 	PhysicsServer2DManager::get_singleton()->register_server("GodotPhysics2D", callable_mp_static(_createGodotPhysics2DCallback));
 	PhysicsServer2DManager::get_singleton()->set_default_server("GodotPhysics2D");
 }
@@ -0,0 +1,316 @@
+/**************************************************************************/
+/*  test_broad_phase_2d.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_body_2d.h"
+#include "../godot_broad_phase_2d_bvh.h"
+#include "../godot_broad_phase_2d_hash_grid.h"
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/templates/hash_set.h"
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+namespace TestBroadPhase2D {
+
+// Tracks the pairs reported by a broadphase, keyed by the instance IDs of the bodies.
+struct PairTracker {
+	HashSet<uint64_t> pairs;
+	int errors = 0;
+
+	static uint64_t make_key(const GodotCollisionObject2D *p_a, const GodotCollisionObject2D *p_b) {
+		const uint64_t a = uint64_t(p_a->get_instance_id());
+		const uint64_t b = uint64_t(p_b->get_instance_id());
+		return a < b ? (a << 32) | b : (b << 32) | a;
+	}
+
+	static void *pair_callback(GodotCollisionObject2D *p_a, int p_subindex_a, GodotCollisionObject2D *p_b, int p_subindex_b, void *p_userdata) {
+		PairTracker *tracker = static_cast<PairTracker *>(p_userdata);
+		const uint64_t key = make_key(p_a, p_b);
+		if (tracker->pairs.has(key)) {
+			tracker->errors++;
+		}
+		tracker->pairs.insert(key);
+		return p_userdata;
+	}
+
+	static void unpair_callback(GodotCollisionObject2D *p_a, int p_subindex_a, GodotCollisionObject2D *p_b, int p_subindex_b, void *p_data, void *p_userdata) {
+		PairTracker *tracker = static_cast<PairTracker *>(p_userdata);
+		const uint64_t key = make_key(p_a, p_b);
+		if (!tracker->pairs.has(key) || p_data != p_userdata) {
+			tracker->errors++;
+		}
+		tracker->pairs.erase(key);
+	}
+
+	void attach(GodotBroadPhase2D *p_broadphase) {
+		p_broadphase->set_pair_callback(pair_callback, this);
+		p_broadphase->set_unpair_callback(unpair_callback, this);
+	}
+};
+
+struct TestScene {
+	LocalVector<GodotBody2D *> bodies;
+	LocalVector<Rect2> aabbs;
+	LocalVector<bool> statics;
+	LocalVector<GodotBroadPhase2D::ID> ids;
+
+	TestScene(int p_count, RandomPCG &r_rng) {
+		for (int i = 0; i < p_count; i++) {
+			GodotBody2D *body = memnew(GodotBody2D);
+			body->set_instance_id(ObjectID(uint64_t(i + 1)));
+			if (i % 7 == 0) {
+				// Some bodies that nothing else interacts with.
+				body->set_collision_layer(2);
+				body->set_collision_mask(2);
+			}
+			bodies.push_back(body);
+			aabbs.push_back(random_aabb(r_rng, i));
+			statics.push_back(i % 5 == 1);
+		}
+	}
+
+	~TestScene() {
+		for (GodotBody2D *body : bodies) {
+			memdelete(body);
+		}
+	}
+
+	static Rect2 random_aabb(RandomPCG &r_rng, int p_index) {
+		if (p_index % 50 == 0) {
+			// A few large objects, bigger than the grid's large object threshold.
+			return Rect2(r_rng.random(-1000.0f, 1000.0f), r_rng.random(-1000.0f, 1000.0f), 3000, 2000);
+		}
+		const Vector2 size(r_rng.random(4.0f, 80.0f), r_rng.random(4.0f, 80.0f));
+		return Rect2(Vector2(r_rng.random(-1000.0f, 1000.0f), r_rng.random(-1000.0f, 1000.0f)), size);
+	}
+
+	bool should_pair(int p_a, int p_b) const {
+		return !(statics[p_a] && statics[p_b]) && aabbs[p_a].intersects(aabbs[p_b], true) && bodies[p_a]->interacts_with(bodies[p_b]);
+	}
+
+	HashSet<uint64_t> expected_pairs() const {
+		HashSet<uint64_t> pairs;
+		for (uint32_t i = 0; i < bodies.size(); i++) {
+			if (!ids[i]) {
+				continue;
+			}
+			for (uint32_t j = i + 1; j < bodies.size(); j++) {
+				if (ids[j] && should_pair(i, j)) {
+					pairs.insert(PairTracker::make_key(bodies[i], bodies[j]));
+				}
+			}
+		}
+		return pairs;
+	}
+};
+
+static bool same_pairs(const HashSet<uint64_t> &p_a, const HashSet<uint64_t> &p_b) {
+	if (p_a.size() != p_b.size()) {
+		return false;
+	}
+	for (const uint64_t key : p_a) {
+		if (!p_b.has(key)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static HashSet<uint64_t> cull_result_set(GodotCollisionObject2D **p_results, int p_count) {
+	HashSet<uint64_t> set;
+	for (int i = 0; i < p_count; i++) {
+		set.insert(uint64_t(p_results[i]->get_instance_id()));
+	}
+	return set;
+}
+
+TEST_CASE("[Physics2D][BroadPhase] Hash grid matches brute force pairs and culls") {
+	constexpr int BODY_COUNT = 300;
+	RandomPCG rng(12345);
+	TestScene scene(BODY_COUNT, rng);
+
+	GodotBroadPhase2DHashGrid grid(64.0, 256);
+	PairTracker tracker;
+	tracker.attach(&grid);
+
+	for (int i = 0; i < BODY_COUNT; i++) {
+		scene.ids.push_back(grid.create(scene.bodies[i], 0, scene.aabbs[i], scene.statics[i]));
+	}
+	grid.update();
+	CHECK(same_pairs(tracker.pairs, scene.expected_pairs()));
+
+	for (int frame = 0; frame < 20; frame++) {
+		for (int i = 0; i < BODY_COUNT; i++) {
+			if (!scene.ids[i] || scene.statics[i] || rng.randf() < 0.3f) {
+				continue;
+			}
+			scene.aabbs[i].position += Vector2(rng.random(-60.0f, 60.0f), rng.random(-60.0f, 60.0f));
+			grid.move(scene.ids[i], scene.aabbs[i]);
+		}
+		if (frame % 5 == 4) {
+			// Swap a body between static and dynamic, remove one and re-add another.
+			const int flip = rng.random(0, BODY_COUNT - 1);
+			scene.statics[flip] = !scene.statics[flip];
+			if (scene.ids[flip]) {
+				grid.set_static(scene.ids[flip], scene.statics[flip]);
+			}
+
+			const int removed = rng.random(0, BODY_COUNT - 1);
+			if (scene.ids[removed]) {
+				grid.remove(scene.ids[removed]);
+				scene.ids[removed] = 0;
+			} else {
+				scene.ids[removed] = grid.create(scene.bodies[removed], 0, scene.aabbs[removed], scene.statics[removed]);
+			}
+		}
+		grid.update();
+		CHECK_MESSAGE(same_pairs(tracker.pairs, scene.expected_pairs()), vformat("Pairs differ from brute force after frame %d.", frame));
+	}
+	CHECK(tracker.errors == 0);
+
+	GodotCollisionObject2D *results[BODY_COUNT];
+	for (int i = 0; i < 50; i++) {
+		const Rect2 query(rng.random(-1200.0f, 1200.0f), rng.random(-1200.0f, 1200.0f), rng.random(1.0f, 400.0f), rng.random(1.0f, 400.0f));
+		const Vector2 from(rng.random(-1200.0f, 1200.0f), rng.random(-1200.0f, 1200.0f));
+		const Vector2 to = i % 10 == 0 ? from : Vector2(rng.random(-1200.0f, 1200.0f), rng.random(-1200.0f, 1200.0f));
+
+		HashSet<uint64_t> expected_aabb;
+		HashSet<uint64_t> expected_segment;
+		for (int j = 0; j < BODY_COUNT; j++) {
+			if (!scene.ids[j]) {
+				continue;
+			}
+			if (scene.aabbs[j].intersects(query, true)) {
+				expected_aabb.insert(j + 1);
+			}
+			if (scene.aabbs[j].intersects_segment(from, to)) {
+				expected_segment.insert(j + 1);
+			}
+		}
+
+		int count = grid.cull_aabb(query, results, BODY_COUNT);
+		CHECK_MESSAGE(same_pairs(cull_result_set(results, count), expected_aabb), "AABB cull results differ from brute force.");
+		CHECK(count == int(expected_aabb.size()));
+
+		count = grid.cull_segment(from, to, results, BODY_COUNT);
+		CHECK_MESSAGE(same_pairs(cull_result_set(results, count), expected_segment), "Segment cull results differ from brute force.");
+		CHECK(count == int(expected_segment.size()));
+	}
+
+	// Removing everything unpairs everything.
+	for (int i = 0; i < BODY_COUNT; i++) {
+		if (scene.ids[i]) {
+			grid.remove(scene.ids[i]);
+		}
+	}
+	CHECK(tracker.pairs.is_empty());
+	CHECK(tracker.errors == 0);
+}
+
+TEST_CASE("[Physics2D][BroadPhase] Hash grid handles objects outside of the grid range") {
+	RandomPCG rng(1);
+	TestScene scene(2, rng);
+	GodotBroadPhase2DHashGrid grid(128.0, 512);
+	PairTracker tracker;
+	tracker.attach(&grid);
+
+	GodotBroadPhase2D::ID a = grid.create(scene.bodies[0], 0, Rect2(-1e20, -1e20, 2e20, 2e20));
+	GodotBroadPhase2D::ID b = grid.create(scene.bodies[1], 0, Rect2(1e12, 1e12, 10, 10));
+	CHECK(a != 0);
+	CHECK(b != 0);
+
+	GodotCollisionObject2D *results[2];
+	CHECK(grid.cull_aabb(Rect2(1e12, 1e12, 1, 1), results, 2) == 2);
+
+	grid.move(b, Rect2(0, 0, 10, 10));
+	grid.update();
+	CHECK(grid.cull_segment(Vector2(-5, 5), Vector2(20, 5), results, 2) == 2);
+
+	grid.remove(a);
+	grid.remove(b);
+	CHECK(tracker.errors == 0);
+}
+
+TEST_CASE("[Physics2D][BroadPhase][Benchmark] BVH and hash grid pair updates" * doctest::skip()) {
+	constexpr int BODY_COUNT = 5000;
+	constexpr int FRAME_COUNT = 120;
+
+	RandomPCG rng(4321);
+	TestScene scene(BODY_COUNT, rng);
+	// Similarly sized objects, as with bullets or particles.
+	LocalVector<Rect2> start_aabbs;
+	LocalVector<Vector2> velocities;
+	for (int i = 0; i < BODY_COUNT; i++) {
+		start_aabbs.push_back(Rect2(rng.random(-4000.0f, 4000.0f), rng.random(-4000.0f, 4000.0f), 16, 16));
+		velocities.push_back(Vector2(rng.random(-8.0f, 8.0f), rng.random(-8.0f, 8.0f)));
+	}
+
+	GodotBroadPhase2D *broadphases[2] = { memnew(GodotBroadPhase2DBVH), memnew(GodotBroadPhase2DHashGrid(32.0, 512)) };
+	const char *names[2] = { "broadphase_2d_bvh", "broadphase_2d_hash_grid" };
+
+	for (int b = 0; b < 2; b++) {
+		GodotBroadPhase2D *broadphase = broadphases[b];
+		PairTracker tracker;
+		tracker.attach(broadphase);
+		scene.ids.clear();
+
+		{
+			TestBenchmark::PhaseTimer timer(names[b], "create");
+			for (int i = 0; i < BODY_COUNT; i++) {
+				scene.ids.push_back(broadphase->create(scene.bodies[i], 0, start_aabbs[i]));
+			}
+			broadphase->update();
+		}
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int frame = 0; frame < FRAME_COUNT; frame++) {
+			for (int i = 0; i < BODY_COUNT; i++) {
+				broadphase->move(scene.ids[i], Rect2(start_aabbs[i].position + velocities[i] * (frame + 1), start_aabbs[i].size));
+			}
+			broadphase->update();
+		}
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+		TestBenchmark::add_result(names[b], "move_and_update", usec, FRAME_COUNT);
+		MESSAGE(vformat("%s: %.3f ms per frame, %d pairs.", names[b], usec / 1000.0 / FRAME_COUNT, tracker.pairs.size()));
+
+		{
+			TestBenchmark::PhaseTimer timer(names[b], "remove");
+			for (int i = 0; i < BODY_COUNT; i++) {
+				broadphase->remove(scene.ids[i]);
+			}
+		}
+		memdelete(broadphase);
+	}
+}
+
+} // namespace TestBroadPhase2D
@@ -0,0 +1,111 @@
+/**************************************************************************/
+/*  test_process_info_2d.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/local_vector.h"
+#include "servers/physics_2d/physics_server_2d.h"
+#include "tests/test_macros.h"
+
+namespace TestProcessInfo2D {
+
+TEST_CASE("[SceneTree][Physics2D] Process info counts contacts, pair churn, sleeping bodies and queries") {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	const real_t delta = 1.0 / 60.0;
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+	ps->area_set_param(space, PS2DE::AREA_PARAM_GRAVITY, 980.0);
+	ps->area_set_param(space, PS2DE::AREA_PARAM_GRAVITY_VECTOR, Vector2(0, 1));
+
+	RID ground_shape = ps->rectangle_shape_create();
+	ps->shape_set_data(ground_shape, Vector2(500, 10));
+	RID ground = ps->body_create();
+	ps->body_set_mode(ground, PS2DE::BODY_MODE_STATIC);
+	ps->body_add_shape(ground, ground_shape);
+	ps->body_set_space(ground, space);
+
+	RID ball_shape = ps->circle_shape_create();
+	ps->shape_set_data(ball_shape, 8.0);
+	LocalVector<RID> balls;
+	for (int i = 0; i < 3; i++) {
+		RID ball = ps->body_create();
+		ps->body_add_shape(ball, ball_shape);
+		ps->body_set_space(ball, space);
+		ps->body_set_state(ball, PS2DE::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(i * 40 - 40, -30)));
+		balls.push_back(ball);
+	}
+
+	int pairs_added = 0;
+	for (int i = 0; i < 60; i++) {
+		ps->step(delta);
+		pairs_added += ps->get_process_info(PS2DE::INFO_PAIRS_ADDED);
+	}
+	CHECK_MESSAGE(pairs_added >= 3, "Each ball landing on the ground should add a pair.");
+	CHECK(ps->get_process_info(PS2DE::INFO_CONTACT_COUNT) >= 3);
+	CHECK(ps->get_process_info(PS2DE::INFO_STEP_TIME) >= ps->get_process_info(PS2DE::INFO_SLOWEST_ISLAND_TIME));
+
+	PhysicsDirectSpaceState2D *direct_state = ps->space_get_direct_state(space);
+	REQUIRE(direct_state);
+	PS2DT::RayParameters ray;
+	ray.from = Vector2(0, -100);
+	ray.to = Vector2(0, 100);
+	PS2DT::RayResult ray_result;
+	for (int i = 0; i < 4; i++) {
+		direct_state->intersect_ray(ray, ray_result);
+	}
+	ps->step(delta);
+	CHECK(ps->get_process_info(PS2DE::INFO_QUERY_COUNT) >= 4);
+	ps->step(delta);
+	CHECK_MESSAGE(ps->get_process_info(PS2DE::INFO_QUERY_COUNT) < 4, "Queries should only be counted for the step that follows them.");
+
+	for (int i = 0; i < 120; i++) {
+		ps->step(delta);
+	}
+	const int sleeping_objects = ps->get_process_info(PS2DE::INFO_SLEEPING_OBJECTS);
+	const int contact_count = ps->get_process_info(PS2DE::INFO_CONTACT_COUNT);
+	CHECK_MESSAGE(sleeping_objects >= 3, "Balls resting on the ground should fall asleep.");
+
+	for (const RID &ball : balls) {
+		ps->free_rid(ball);
+	}
+	// Reading the counts must not walk the space, they keep the values of the last step.
+	CHECK(ps->get_process_info(PS2DE::INFO_SLEEPING_OBJECTS) == sleeping_objects);
+	CHECK(ps->get_process_info(PS2DE::INFO_CONTACT_COUNT) == contact_count);
+	ps->step(delta);
+	CHECK(ps->get_process_info(PS2DE::INFO_SLEEPING_OBJECTS) == 0);
+	CHECK(ps->get_process_info(PS2DE::INFO_CONTACT_COUNT) == 0);
+	ps->free_rid(ground);
+	ps->free_rid(ball_shape);
+	ps->free_rid(ground_shape);
+	ps->free_rid(space);
+}
+
+} // namespace TestProcessInfo2D
@@ -0,0 +1,189 @@
+/**************************************************************************/
+/*  test_query_batch_2d.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/local_vector.h"
+#include "servers/physics_2d/physics_server_2d.h"
+#include "servers/physics_2d/queries/physics_ray_query_parameters_2d.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestQueryBatch2D {
+
+// More than one chunk of the batch, so the queries are split over worker threads.
+static constexpr int QUERY_COUNT = 300;
+
+// Every fifth query aims between the bodies, the others at one body each.
+static bool aims_between(int p_query) {
+	return p_query % 5 == 4;
+}
+
+TEST_CASE("[SceneTree][Physics2D] Batched queries write each result at the index of its query") {
+	TestUtils::ScopedWorkerThreadCount thread_count(4);
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	// A grid of separate circles, 40 apart.
+	RID circle_shape = ps->circle_shape_create();
+	ps->shape_set_data(circle_shape, 10.0);
+	LocalVector<RID> bodies;
+	for (int i = 0; i < QUERY_COUNT; i++) {
+		RID body = ps->body_create();
+		ps->body_set_mode(body, PS2DE::BODY_MODE_STATIC);
+		ps->body_add_shape(body, circle_shape);
+		ps->body_set_state(body, PS2DE::BODY_STATE_TRANSFORM, Transform2D(0, Vector2((i % 20) * 40, (i / 20) * 40)));
+		ps->body_set_space(body, space);
+		bodies.push_back(body);
+	}
+	RID query_shape = ps->circle_shape_create();
+	ps->shape_set_data(query_shape, 3.0);
+	ps->step(1.0 / 60.0);
+
+	PhysicsDirectSpaceState2D *space_state = ps->space_get_direct_state(space);
+	REQUIRE(space_state);
+
+	// The queries go through the bodies backwards, so they're run in another order than they're given in.
+	// Each one starts 25 above the center of its body, or of the gap to the right of it.
+	LocalVector<Vector2> starts;
+	Vector<RID> expected_rids;
+	for (int i = 0; i < QUERY_COUNT; i++) {
+		const int body = QUERY_COUNT - 1 - i;
+		const Vector2 center((body % 20) * 40, (body / 20) * 40);
+		starts.push_back(center + Vector2(aims_between(i) ? 20 : 0, -25));
+		expected_rids.push_back(aims_between(i) ? RID() : bodies[body]);
+	}
+	const int expected_hit_count = QUERY_COUNT - QUERY_COUNT / 5;
+
+	SUBCASE("intersect_rays") {
+		LocalVector<Vector2> ends;
+		for (const Vector2 &start : starts) {
+			ends.push_back(start + Vector2(0, 25));
+		}
+		LocalVector<PS2DT::RayResult> results;
+		results.resize(QUERY_COUNT);
+		CHECK(space_state->intersect_rays(PS2DT::RayParameters(), starts.ptr(), ends.ptr(), QUERY_COUNT, results.ptr()) == expected_hit_count);
+
+		Vector<RID> rids;
+		for (const PS2DT::RayResult &result : results) {
+			rids.push_back(result.rid);
+		}
+		CHECK_MESSAGE(rids == expected_rids, "Each ray should hit the body it aims at, at its own index.");
+		CHECK(results[0].position.is_equal_approx(starts[0] + Vector2(0, 15)));
+		CHECK(results[0].normal.is_equal_approx(Vector2(0, -1)));
+	}
+
+	SUBCASE("intersect_points") {
+		LocalVector<Vector2> centers;
+		for (const Vector2 &start : starts) {
+			centers.push_back(start + Vector2(0, 25));
+		}
+		LocalVector<PS2DT::ShapeResult> results;
+		results.resize(QUERY_COUNT);
+		CHECK(space_state->intersect_points(PS2DT::PointParameters(), centers.ptr(), QUERY_COUNT, results.ptr()) == expected_hit_count);
+
+		Vector<RID> rids;
+		for (const PS2DT::ShapeResult &result : results) {
+			rids.push_back(result.rid);
+		}
+		CHECK_MESSAGE(rids == expected_rids, "Each point should be inside the body it aims at, at its own index.");
+	}
+
+	SUBCASE("cast_motions") {
+		LocalVector<Vector2> motions;
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			motions.push_back(Vector2(0, 60));
+		}
+		PS2DT::ShapeParameters parameters;
+		parameters.shape_rid = query_shape;
+		LocalVector<real_t> closest_safe;
+		closest_safe.resize(QUERY_COUNT);
+		LocalVector<real_t> closest_unsafe;
+		closest_unsafe.resize(QUERY_COUNT);
+		REQUIRE(space_state->cast_motions(parameters, starts.ptr(), motions.ptr(), QUERY_COUNT, closest_safe.ptr(), closest_unsafe.ptr()));
+
+		// The query circle touches its body after moving 25 - 10 - 3.
+		Vector<bool> blocked;
+		Vector<bool> expected_blocked;
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			blocked.push_back(closest_safe[i] < 1.0);
+			expected_blocked.push_back(!aims_between(i));
+		}
+		CHECK_MESSAGE(blocked == expected_blocked, "Each motion should be stopped by the body it aims at, at its own index.");
+		CHECK(closest_safe[0] == doctest::Approx(12.0 / 60.0).epsilon(0.05));
+	}
+
+	for (const RID &body : bodies) {
+		ps->free_rid(body);
+	}
+	ps->free_rid(query_shape);
+	ps->free_rid(circle_shape);
+	ps->free_rid(space);
+}
+
+TEST_CASE("[SceneTree][Physics2D] Batched queries reject arrays of different sizes") {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+	RID shape = ps->circle_shape_create();
+	ps->shape_set_data(shape, 3.0);
+	PhysicsDirectSpaceState2D *space_state = ps->space_get_direct_state(space);
+	REQUIRE(space_state);
+
+	PackedVector2Array three;
+	three.resize(3);
+	PackedVector2Array two;
+	two.resize(2);
+
+	Ref<PhysicsRayQueryParameters2D> ray_query;
+	ray_query.instantiate();
+	Ref<PhysicsShapeQueryParameters2D> shape_query;
+	shape_query.instantiate();
+	shape_query->set_shape_rid(shape);
+
+	ERR_PRINT_OFF;
+	const Dictionary rays = space_state->call(SNAME("intersect_rays"), ray_query, three, two);
+	const Dictionary motions = space_state->call(SNAME("cast_motions"), shape_query, two, three);
+	ERR_PRINT_ON;
+	CHECK(rays.is_empty());
+	CHECK(motions.is_empty());
+
+	// Matching sizes give one result per query.
+	const Dictionary matching_rays = space_state->call(SNAME("intersect_rays"), ray_query, three, three);
+	CHECK(PackedVector2Array(matching_rays["position"]).size() == 3);
+	const Dictionary matching_motions = space_state->call(SNAME("cast_motions"), shape_query, two, two);
+	CHECK(Vector<real_t>(matching_motions["safe_fraction"]).size() == 2);
+
+	ps->free_rid(shape);
+	ps->free_rid(space);
+}
+
+} // namespace TestQueryBatch2D
@@ -0,0 +1,177 @@
+/**************************************************************************/
+/*  test_space_state_2d.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/config/project_settings.h"
+#include "core/templates/local_vector.h"
+#include "servers/physics_2d/physics_server_2d.h"
+#include "tests/test_macros.h"
+
+namespace TestSpaceState2D {
+
+static constexpr real_t DELTA = 1.0 / 60.0;
+
+// Adds a pile of balls that lands on the ground and keeps its contacts across steps, and returns the balls.
+// Pinning the first two balls adds a joint, which warm starts from the impulses of the previous step.
+// Everything created is added to r_created, to be freed in reverse order.
+static LocalVector<RID> add_pile(RID p_space, bool p_pinned, LocalVector<RID> &r_created) {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	ps->area_set_param(p_space, PS2DE::AREA_PARAM_GRAVITY, 980.0);
+	ps->area_set_param(p_space, PS2DE::AREA_PARAM_GRAVITY_VECTOR, Vector2(0, 1));
+
+	RID ground_shape = ps->rectangle_shape_create();
+	ps->shape_set_data(ground_shape, Vector2(500, 10));
+	RID ground = ps->body_create();
+	ps->body_set_mode(ground, PS2DE::BODY_MODE_STATIC);
+	ps->body_add_shape(ground, ground_shape);
+	ps->body_set_space(ground, p_space);
+	r_created.push_back(ground_shape);
+	r_created.push_back(ground);
+
+	RID ball_shape = ps->circle_shape_create();
+	ps->shape_set_data(ball_shape, 8.0);
+	r_created.push_back(ball_shape);
+	LocalVector<RID> balls;
+	for (int i = 0; i < 40; i++) {
+		RID ball = ps->body_create();
+		ps->body_add_shape(ball, ball_shape);
+		ps->body_set_space(ball, p_space);
+		ps->body_set_state(ball, PS2DE::BODY_STATE_TRANSFORM, Transform2D(0, Vector2((i % 8) * 17 - 60 + (i / 8) * 3, -20 - (i / 8) * 17)));
+		balls.push_back(ball);
+		r_created.push_back(ball);
+	}
+
+	if (p_pinned) {
+		RID joint = ps->joint_create();
+		ps->joint_make_pin(joint, Vector2(-51, -20), balls[0], balls[1]);
+		r_created.push_back(joint);
+	}
+	return balls;
+}
+
+static void free_in_reverse(const LocalVector<RID> &p_rids) {
+	for (int i = int(p_rids.size()) - 1; i >= 0; i--) {
+		PhysicsServer2D::get_singleton()->free_rid(p_rids[i]);
+	}
+}
+
+// Transforms of the balls after each of the given number of steps.
+static Vector<Transform2D> record_steps(const LocalVector<RID> &p_balls, int p_count) {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	Vector<Transform2D> transforms;
+	for (int i = 0; i < p_count; i++) {
+		ps->step(DELTA);
+		for (const RID &ball : p_balls) {
+			transforms.push_back(ps->body_get_state(ball, PS2DE::BODY_STATE_TRANSFORM));
+		}
+	}
+	return transforms;
+}
+
+TEST_CASE("[SceneTree][Physics2D] Restoring a saved space state replays the same steps") {
+	const String setting = "physics/godot_physics_2d/deterministic";
+	const Variant was_deterministic = GLOBAL_GET(setting);
+	ProjectSettings::get_singleton()->set_setting(setting, true);
+
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+	LocalVector<RID> created;
+	const LocalVector<RID> balls = add_pile(space, true, created);
+	record_steps(balls, 30);
+
+	const Vector<uint8_t> state = ps->space_save_state(space);
+	REQUIRE_FALSE(state.is_empty());
+	const Vector<Transform2D> expected = record_steps(balls, 60);
+	const Vector<uint8_t> expected_end_state = ps->space_save_state(space);
+
+	CHECK(ps->space_restore_state(space, state));
+	CHECK_MESSAGE(record_steps(balls, 60) == expected, "Replayed steps should give bit-identical transforms.");
+	CHECK_MESSAGE(ps->space_save_state(space) == expected_end_state, "Replayed steps should end in the same state, contacts included.");
+
+	Vector<uint8_t> corrupted = state;
+	corrupted.write[0] ^= 0xFF;
+	ERR_PRINT_OFF;
+	CHECK_FALSE(ps->space_restore_state(space, corrupted));
+	CHECK_FALSE(ps->space_restore_state(space, Vector<uint8_t>()));
+	ERR_PRINT_ON;
+
+	free_in_reverse(created);
+	ps->free_rid(space);
+	ProjectSettings::get_singleton()->set_setting(setting, was_deterministic);
+}
+
+TEST_CASE("[SceneTree][Physics2D] A saved space state can be restored into a space built the same way") {
+	const String setting = "physics/godot_physics_2d/deterministic";
+	const Variant was_deterministic = GLOBAL_GET(setting);
+	ProjectSettings::get_singleton()->set_setting(setting, true);
+
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	Vector<uint8_t> state;
+	Vector<Transform2D> expected;
+	{
+		RID space = ps->space_create();
+		ps->space_set_active(space, true);
+		LocalVector<RID> created;
+		const LocalVector<RID> balls = add_pile(space, true, created);
+		record_steps(balls, 30);
+		state = ps->space_save_state(space);
+		expected = record_steps(balls, 30);
+		free_in_reverse(created);
+		ps->free_rid(space);
+	}
+	REQUIRE_FALSE(state.is_empty());
+
+	// Objects are numbered by the order they were added to their space, like they would be in another process.
+	RID copy = ps->space_create();
+	ps->space_set_active(copy, true);
+	LocalVector<RID> created;
+	const LocalVector<RID> balls = add_pile(copy, true, created);
+	CHECK(ps->space_restore_state(copy, state));
+	CHECK_MESSAGE(record_steps(balls, 30) == expected, "The balls should move as they did in the space the state was saved from.");
+
+	// The joint impulses can't be restored without the joint, so nothing is.
+	RID unpinned = ps->space_create();
+	ps->space_set_active(unpinned, true);
+	add_pile(unpinned, false, created);
+	const Vector<uint8_t> unpinned_state = ps->space_save_state(unpinned);
+	ERR_PRINT_OFF;
+	CHECK_FALSE(ps->space_restore_state(unpinned, state));
+	ERR_PRINT_ON;
+	CHECK(ps->space_save_state(unpinned) == unpinned_state);
+
+	free_in_reverse(created);
+	ps->free_rid(unpinned);
+	ps->free_rid(copy);
+	ProjectSettings::get_singleton()->set_setting(setting, was_deterministic);
+}
+
+} // namespace TestSpaceState2D
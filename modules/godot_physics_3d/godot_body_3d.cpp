@@ -664,13 +664,19 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	biased_angular_velocity = Vector3();
 	biased_linear_velocity = Vector3();
 
-	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
-	}
+	integrated_motion = motion;
+	integrated_motion_pending = do_motion;
 
 	contact_count = 0;
 }
 
+void GodotBody3D::update_space_after_integrate_forces() {
+	if (integrated_motion_pending) { //shapes temporarily extend for raycast
+		_update_shapes_with_motion(integrated_motion);
+		integrated_motion_pending = false;
+	}
+}
+
 void GodotBody3D::integrate_velocities(real_t p_step) {
 	if (mode == PS3DE::BODY_MODE_STATIC) {
 		return;
@@ -678,10 +684,6 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 
 	ERR_FAIL_NULL(get_space());
 
-	if (fi_callback_data || body_state_callback.is_valid()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
-	}
-
 	//apply axis lock linear
 	for (int i = 0; i < 3; i++) {
 		if (is_axis_locked((PS3DE::BodyAxis)(1 << i))) {
@@ -701,9 +703,7 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 	if (mode == PS3DE::BODY_MODE_KINEMATIC) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
-		if (contacts.is_empty() && linear_velocity == Vector3() && angular_velocity == Vector3()) {
-			set_active(false); //stopped moving, deactivate
-		}
+		integrated_stopped = contacts.is_empty() && linear_velocity == Vector3() && angular_velocity == Vector3();
 
 		return;
 	}
@@ -731,12 +731,35 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 
 	transform_new.origin += total_linear_velocity * p_step;
 
-	_set_transform(transform_new);
+	_set_transform(transform_new, false);
 	_set_inv_transform(get_transform().inverse());
+	integrated_shapes_pending = true;
 
 	_update_transform_dependent();
 }
 
+void GodotBody3D::update_space_after_integrate_velocities() {
+	if (mode == PS3DE::BODY_MODE_STATIC) {
+		return;
+	}
+
+	ERR_FAIL_NULL(get_space());
+
+	if (fi_callback_data || body_state_callback.is_valid()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	if (integrated_shapes_pending) {
+		_set_transform(get_transform()); // Updates the shapes in the broadphase.
+		integrated_shapes_pending = false;
+	}
+
+	if (integrated_stopped) {
+		set_active(false); //stopped moving, deactivate
+		integrated_stopped = false;
+	}
+}
+
 void GodotBody3D::wakeup_neighbours() {
 	for (const KeyValue<GodotConstraint3D *, int> &E : constraint_map) {
 		const GodotConstraint3D *c = E.key;
@@ -799,6 +822,45 @@ bool GodotBody3D::sleep_test(real_t p_step) {
 	}
 }
 
+void GodotBody3D::save_snapshot_state(SnapshotState &r_state) const {
+	r_state.transform = get_transform();
+	r_state.inv_transform = get_inv_transform();
+	r_state.new_transform = new_transform;
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.prev_linear_velocity = prev_linear_velocity;
+	r_state.prev_angular_velocity = prev_angular_velocity;
+	r_state.constant_linear_velocity = constant_linear_velocity;
+	r_state.constant_angular_velocity = constant_angular_velocity;
+	r_state.applied_force = applied_force;
+	r_state.applied_torque = applied_torque;
+	r_state.constant_force = constant_force;
+	r_state.constant_torque = constant_torque;
+	r_state.still_time = still_time;
+	r_state.active = active;
+	r_state.first_time_kinematic = first_time_kinematic;
+}
+
+void GodotBody3D::restore_snapshot_state(const SnapshotState &p_state) {
+	_set_transform(p_state.transform);
+	_set_inv_transform(p_state.inv_transform);
+	_update_transform_dependent();
+	new_transform = p_state.new_transform;
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	prev_linear_velocity = p_state.prev_linear_velocity;
+	prev_angular_velocity = p_state.prev_angular_velocity;
+	constant_linear_velocity = p_state.constant_linear_velocity;
+	constant_angular_velocity = p_state.constant_angular_velocity;
+	applied_force = p_state.applied_force;
+	applied_torque = p_state.applied_torque;
+	constant_force = p_state.constant_force;
+	constant_torque = p_state.constant_torque;
+	still_time = p_state.still_time;
+	first_time_kinematic = p_state.first_time_kinematic;
+	set_active(p_state.active);
+}
+
 void GodotBody3D::set_state_sync_callback(const Callable &p_callable) {
 	body_state_callback = p_callable;
 }
@@ -108,6 +108,12 @@ class GodotBody3D : public GodotCollisionObject3D {
 	bool can_sleep = true;
 	bool first_time_kinematic = false;
 
+	// Space updates left by integrate_forces() and integrate_velocities(), done by the update_space_after_*() methods.
+	Vector3 integrated_motion;
+	bool integrated_motion_pending = false;
+	bool integrated_shapes_pending = false;
+	bool integrated_stopped = false;
+
 	void _mass_properties_changed();
 	virtual void _shapes_changed() override;
 	Transform3D new_transform;
@@ -218,7 +224,9 @@ public:
 	_FORCE_INLINE_ Vector3 get_prev_linear_velocity() const { return prev_linear_velocity; }
 	_FORCE_INLINE_ Vector3 get_prev_angular_velocity() const { return prev_angular_velocity; }
 
+	_FORCE_INLINE_ void set_biased_linear_velocity(const Vector3 &p_velocity) { biased_linear_velocity = p_velocity; }
 	_FORCE_INLINE_ const Vector3 &get_biased_linear_velocity() const { return biased_linear_velocity; }
+	_FORCE_INLINE_ void set_biased_angular_velocity(const Vector3 &p_velocity) { biased_angular_velocity = p_velocity; }
 	_FORCE_INLINE_ const Vector3 &get_biased_angular_velocity() const { return biased_angular_velocity; }
 
 	_FORCE_INLINE_ void apply_central_impulse(const Vector3 &p_impulse) {
@@ -317,8 +325,12 @@ public:
 	void set_axis_lock(PS3DE::BodyAxis p_axis, bool lock);
 	bool is_axis_locked(PS3DE::BodyAxis p_axis) const;
 
+	// These only change the body, so different bodies can be integrated in parallel.
+	// Changes to the space are applied afterwards by the matching update_space_after_*() method, called serially.
 	void integrate_forces(real_t p_step);
+	void update_space_after_integrate_forces();
 	void integrate_velocities(real_t p_step);
+	void update_space_after_integrate_velocities();
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
@@ -344,6 +356,29 @@ public:
 
 	bool sleep_test(real_t p_step);
 
+	// Simulation state copied by space snapshots.
+	struct SnapshotState {
+		Transform3D transform;
+		Transform3D inv_transform;
+		Transform3D new_transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		Vector3 prev_linear_velocity;
+		Vector3 prev_angular_velocity;
+		Vector3 constant_linear_velocity;
+		Vector3 constant_angular_velocity;
+		Vector3 applied_force;
+		Vector3 applied_torque;
+		Vector3 constant_force;
+		Vector3 constant_torque;
+		real_t still_time = 0.0;
+		bool active = false;
+		bool first_time_kinematic = false;
+	};
+
+	void save_snapshot_state(SnapshotState &r_state) const;
+	void restore_snapshot_state(const SnapshotState &p_state);
+
 	GodotBody3D();
 	~GodotBody3D();
 };
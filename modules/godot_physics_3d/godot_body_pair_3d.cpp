@@ -37,6 +37,11 @@
 
 #define MIN_VELOCITY 0.0001
 #define MAX_BIAS_ROTATION (Math::PI / 8)
+// Contacts are kept without running the narrowphase while the relative motion stays below these.
+#define MANIFOLD_REUSE_DISTANCE_RATIO 0.1 // of the contact recycle radius
+#define MANIFOLD_REUSE_BASIS_DELTA 0.001
+// Contacts with normals further apart than this are never matched to each other.
+#define CONTACT_MATCH_MIN_NORMAL_DOT 0.95
 
 void GodotBodyPair3D::_contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
 	GodotBodyPair3D *pair = static_cast<GodotBodyPair3D *>(p_userdata);
@@ -60,21 +65,41 @@ void GodotBodyPair3D::contact_added_callback(const Vector3 &p_point_A, int p_ind
 	contact.used = true;
 
 	// Attempt to determine if the contact will be reused.
+	// The closest previous contact on the same features with a similar normal is picked, so that
+	// its accumulated impulses warm start the new one.
 	real_t contact_recycle_radius = space->get_contact_recycle_radius();
+	real_t recycle_radius2 = contact_recycle_radius * contact_recycle_radius;
+
+	int recycle_index = -1;
+	real_t recycle_distance2 = 0.0;
 
 	for (int i = 0; i < contact_count; i++) {
-		Contact &c = contacts[i];
-		if (c.local_A.distance_squared_to(local_A) < (contact_recycle_radius * contact_recycle_radius) &&
-				c.local_B.distance_squared_to(local_B) < (contact_recycle_radius * contact_recycle_radius)) {
-			contact.acc_normal_impulse = c.acc_normal_impulse;
-			contact.acc_bias_impulse = c.acc_bias_impulse;
-			contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
-			contact.acc_tangent_impulse = c.acc_tangent_impulse;
-			c = contact;
-			return;
+		const Contact &c = contacts[i];
+		if (c.index_A != p_index_A || c.index_B != p_index_B || c.normal.dot(contact.normal) < CONTACT_MATCH_MIN_NORMAL_DOT) {
+			continue;
+		}
+
+		real_t distance_A2 = c.local_A.distance_squared_to(local_A);
+		real_t distance_B2 = c.local_B.distance_squared_to(local_B);
+		if (distance_A2 < recycle_radius2 && distance_B2 < recycle_radius2) {
+			real_t distance2 = distance_A2 + distance_B2;
+			if (recycle_index == -1 || distance2 < recycle_distance2) {
+				recycle_index = i;
+				recycle_distance2 = distance2;
+			}
 		}
 	}
 
+	if (recycle_index != -1) {
+		Contact &c = contacts[recycle_index];
+		contact.acc_normal_impulse = c.acc_normal_impulse;
+		contact.acc_bias_impulse = c.acc_bias_impulse;
+		contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
+		contact.acc_tangent_impulse = c.acc_tangent_impulse;
+		c = contact;
+		return;
+	}
+
 	// Figure out if the contact amount must be reduced to fit the new contact.
 	if (new_index == MAX_CONTACTS) {
 		// Remove the contact with the minimum depth.
@@ -161,6 +186,33 @@ void GodotBodyPair3D::validate_contacts() {
 	}
 }
 
+bool GodotBodyPair3D::_can_reuse_contacts(const Transform3D &p_xform_A, const GodotShape3D *p_shape_A, const Transform3D &p_xform_B, const GodotShape3D *p_shape_B) const {
+	const ManifoldCache &cache = manifold_cache;
+	if (!cache.valid || contact_count == 0) {
+		return false;
+	}
+
+	if (cache.shape_A != p_shape_A || cache.shape_B != p_shape_B || cache.shapes_version_A != A->get_shapes_version() || cache.shapes_version_B != B->get_shapes_version()) {
+		return false;
+	}
+
+	real_t max_distance = space->get_contact_recycle_radius() * MANIFOLD_REUSE_DISTANCE_RATIO;
+	if (cache.xform_B.origin.distance_squared_to(p_xform_B.origin) > max_distance * max_distance) {
+		return false;
+	}
+
+	// Both bases are compared, since contact normals are kept in world orientation.
+	const real_t max_basis_delta2 = MANIFOLD_REUSE_BASIS_DELTA * MANIFOLD_REUSE_BASIS_DELTA;
+	for (int i = 0; i < 3; i++) {
+		if ((cache.xform_A.basis.rows[i] - p_xform_A.basis.rows[i]).length_squared() > max_basis_delta2 ||
+				(cache.xform_B.basis.rows[i] - p_xform_B.basis.rows[i]).length_squared() > max_basis_delta2) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 // `_test_ccd` prevents tunneling by slowing down a high velocity body that is about to collide so
 // that next frame it will be at an appropriate location to collide (i.e. slight overlap).
 // WARNING: The way velocity is adjusted down to cause a collision means the momentum will be
@@ -262,9 +314,11 @@ real_t combine_friction(GodotBody3D *A, GodotBody3D *B) {
 
 bool GodotBodyPair3D::setup(real_t p_step) {
 	check_ccd = false;
+	manifold_reused = false;
 
 	if (!A->interacts_with(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self())) {
 		collided = false;
+		manifold_cache.valid = false;
 		return false;
 	}
 
@@ -277,6 +331,7 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 			report_contacts_only = true;
 		} else {
 			collided = false;
+			manifold_cache.valid = false;
 			return false;
 		}
 	}
@@ -296,8 +351,28 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 	GodotShape3D *shape_A_ptr = A->get_shape(shape_A);
 	GodotShape3D *shape_B_ptr = B->get_shape(shape_B);
 
+	if (_can_reuse_contacts(xform_A, shape_A_ptr, xform_B, shape_B_ptr)) {
+		// Nothing moved enough to change the contacts, keep the ones found last time.
+		for (int i = 0; i < contact_count; i++) {
+			contacts[i].used = true;
+		}
+		manifold_reused = true;
+		collided = true;
+		return true;
+	}
+
 	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
 
+	manifold_cache.valid = collided;
+	if (collided) {
+		manifold_cache.xform_A = xform_A;
+		manifold_cache.xform_B = xform_B;
+		manifold_cache.shape_A = shape_A_ptr;
+		manifold_cache.shape_B = shape_B_ptr;
+		manifold_cache.shapes_version_A = A->get_shapes_version();
+		manifold_cache.shapes_version_B = B->get_shapes_version();
+	}
+
 	if (!collided) {
 		if (A->is_continuous_collision_detection_enabled() && collide_A) {
 			check_ccd = true;
@@ -316,6 +391,12 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 }
 
 bool GodotBodyPair3D::pre_solve(real_t p_step) {
+	solver_contacts.count = 0;
+
+	if (manifold_reused) {
+		space->add_reused_manifold();
+	}
+
 	if (!collided) {
 		if (check_ccd) {
 			const Vector3 &offset_A = A->get_transform().get_origin();
@@ -373,6 +454,8 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 	real_t inv_mass_A = collide_A ? A->get_inv_mass() : 0.0;
 	real_t inv_mass_B = collide_B ? B->get_inv_mass() : 0.0;
 
+	friction = combine_friction(A, B);
+
 	for (int i = 0; i < contact_count; i++) {
 		Contact &c = contacts[i];
 		c.active = false;
@@ -448,16 +531,37 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 			Vector3 dv = B->get_prev_linear_velocity() + crB - A->get_prev_linear_velocity() - crA;
 			c.bounce = c.bounce * dv.dot(c.normal);
 		}
+
+		const int k = solver_contacts.count++;
+		solver_contacts.index[k] = i;
+		solver_contacts.active[k] = true;
+		solver_contacts.normal[k] = c.normal;
+		solver_contacts.rA[k] = c.rA;
+		solver_contacts.rB[k] = c.rB;
+		solver_contacts.angular_A[k] = inertia_A;
+		solver_contacts.angular_B[k] = inertia_B;
+		solver_contacts.mass_normal[k] = c.mass_normal;
+		solver_contacts.bias[k] = c.bias;
+		solver_contacts.bounce[k] = c.bounce;
 	}
 
 	return do_process;
 }
 
+static _FORCE_INLINE_ Vector3 _limit_bias_rotation(const Vector3 &p_delta_av, real_t p_max_delta_av) {
+	if (p_max_delta_av > 0 && p_delta_av.length() > p_max_delta_av) {
+		return p_delta_av.normalized() * p_max_delta_av;
+	}
+	return p_delta_av;
+}
+
 void GodotBodyPair3D::solve(real_t p_step) {
-	if (!collided) {
+	if (!collided || solver_contacts.count == 0) {
 		return;
 	}
 
+	SolverContacts &sc = solver_contacts;
+
 	const real_t max_bias_av = MAX_BIAS_ROTATION / p_step;
 
 	Basis zero_basis;
@@ -469,106 +573,100 @@ void GodotBodyPair3D::solve(real_t p_step) {
 	real_t inv_mass_A = collide_A ? A->get_inv_mass() : 0.0;
 	real_t inv_mass_B = collide_B ? B->get_inv_mass() : 0.0;
 
-	for (int i = 0; i < contact_count; i++) {
-		Contact &c = contacts[i];
-		if (!c.active) {
+	// Contacts are solved against local copies of the velocities, written back once at the end.
+	// A body that doesn't collide has zero inverse mass and inertia here, so it's never changed.
+	Vector3 lv_A = A->get_linear_velocity();
+	Vector3 av_A = A->get_angular_velocity();
+	Vector3 blv_A = A->get_biased_linear_velocity();
+	Vector3 bav_A = A->get_biased_angular_velocity();
+	Vector3 lv_B = B->get_linear_velocity();
+	Vector3 av_B = B->get_angular_velocity();
+	Vector3 blv_B = B->get_biased_linear_velocity();
+	Vector3 bav_B = B->get_biased_angular_velocity();
+
+	for (int k = 0; k < sc.count; k++) {
+		if (!sc.active[k]) {
 			continue;
 		}
 
-		c.active = false; //try to deactivate, will activate itself if still needed
+		sc.active[k] = false; //try to deactivate, will activate itself if still needed
 
-		//bias impulse
+		Contact &c = contacts[sc.index[k]];
+		const Vector3 &normal = sc.normal[k];
+		const Vector3 &rA = sc.rA[k];
+		const Vector3 &rB = sc.rB[k];
 
-		Vector3 crbA = A->get_biased_angular_velocity().cross(c.rA);
-		Vector3 crbB = B->get_biased_angular_velocity().cross(c.rB);
-		Vector3 dbv = B->get_biased_linear_velocity() + crbB - A->get_biased_linear_velocity() - crbA;
+		//bias impulse
 
-		real_t vbn = dbv.dot(c.normal);
+		Vector3 dbv = blv_B + bav_B.cross(rB) - blv_A - bav_A.cross(rA);
+		real_t vbn = dbv.dot(normal);
 
-		if (Math::abs(-vbn + c.bias) > MIN_VELOCITY) {
-			real_t jbn = (-vbn + c.bias) * c.mass_normal;
+		if (Math::abs(-vbn + sc.bias[k]) > MIN_VELOCITY) {
+			real_t jbn = (-vbn + sc.bias[k]) * sc.mass_normal[k];
 			real_t jbnOld = c.acc_bias_impulse;
 			c.acc_bias_impulse = MAX(jbnOld + jbn, 0.0f);
 
-			Vector3 jb = c.normal * (c.acc_bias_impulse - jbnOld);
-
-			if (collide_A) {
-				A->apply_bias_impulse(-jb, c.rA + A->get_center_of_mass(), max_bias_av);
-			}
-			if (collide_B) {
-				B->apply_bias_impulse(jb, c.rB + B->get_center_of_mass(), max_bias_av);
-			}
+			real_t jb = c.acc_bias_impulse - jbnOld;
 
-			crbA = A->get_biased_angular_velocity().cross(c.rA);
-			crbB = B->get_biased_angular_velocity().cross(c.rB);
-			dbv = B->get_biased_linear_velocity() + crbB - A->get_biased_linear_velocity() - crbA;
+			blv_A -= normal * (jb * inv_mass_A);
+			bav_A -= _limit_bias_rotation(sc.angular_A[k] * jb, max_bias_av);
+			blv_B += normal * (jb * inv_mass_B);
+			bav_B += _limit_bias_rotation(sc.angular_B[k] * jb, max_bias_av);
 
-			vbn = dbv.dot(c.normal);
+			dbv = blv_B + bav_B.cross(rB) - blv_A - bav_A.cross(rA);
+			vbn = dbv.dot(normal);
 
-			if (Math::abs(-vbn + c.bias) > MIN_VELOCITY) {
-				real_t jbn_com = (-vbn + c.bias) / (inv_mass_A + inv_mass_B);
+			if (Math::abs(-vbn + sc.bias[k]) > MIN_VELOCITY) {
+				real_t jbn_com = (-vbn + sc.bias[k]) / (inv_mass_A + inv_mass_B);
 				real_t jbnOld_com = c.acc_bias_impulse_center_of_mass;
 				c.acc_bias_impulse_center_of_mass = MAX(jbnOld_com + jbn_com, 0.0f);
 
-				Vector3 jb_com = c.normal * (c.acc_bias_impulse_center_of_mass - jbnOld_com);
+				real_t jb_com = c.acc_bias_impulse_center_of_mass - jbnOld_com;
 
-				if (collide_A) {
-					A->apply_bias_impulse(-jb_com, A->get_center_of_mass(), 0.0f);
-				}
-				if (collide_B) {
-					B->apply_bias_impulse(jb_com, B->get_center_of_mass(), 0.0f);
-				}
+				blv_A -= normal * (jb_com * inv_mass_A);
+				blv_B += normal * (jb_com * inv_mass_B);
 			}
 
-			c.active = true;
+			sc.active[k] = true;
 		}
 
-		Vector3 crA = A->get_angular_velocity().cross(c.rA);
-		Vector3 crB = B->get_angular_velocity().cross(c.rB);
-		Vector3 dv = B->get_linear_velocity() + crB - A->get_linear_velocity() - crA;
-
 		//normal impulse
-		real_t vn = dv.dot(c.normal);
+
+		Vector3 dv = lv_B + av_B.cross(rB) - lv_A - av_A.cross(rA);
+		real_t vn = dv.dot(normal);
 
 		if (Math::abs(vn) > MIN_VELOCITY) {
-			real_t jn = -(c.bounce + vn) * c.mass_normal;
+			real_t jn = -(sc.bounce[k] + vn) * sc.mass_normal[k];
 			real_t jnOld = c.acc_normal_impulse;
 			c.acc_normal_impulse = MAX(jnOld + jn, 0.0f);
 
-			Vector3 j = c.normal * (c.acc_normal_impulse - jnOld);
+			real_t j = c.acc_normal_impulse - jnOld;
 
-			if (collide_A) {
-				A->apply_impulse(-j, c.rA + A->get_center_of_mass());
-			}
-			if (collide_B) {
-				B->apply_impulse(j, c.rB + B->get_center_of_mass());
-			}
-			c.acc_impulse -= j;
+			lv_A -= normal * (j * inv_mass_A);
+			av_A -= sc.angular_A[k] * j;
+			lv_B += normal * (j * inv_mass_B);
+			av_B += sc.angular_B[k] * j;
+			c.acc_impulse -= normal * j;
 
-			c.active = true;
+			sc.active[k] = true;
 		}
 
 		//friction impulse
 
-		real_t friction = combine_friction(A, B);
-
-		Vector3 lvA = A->get_linear_velocity() + A->get_angular_velocity().cross(c.rA);
-		Vector3 lvB = B->get_linear_velocity() + B->get_angular_velocity().cross(c.rB);
-
-		Vector3 dtv = lvB - lvA;
-		real_t tn = c.normal.dot(dtv);
+		Vector3 dtv = lv_B + av_B.cross(rB) - lv_A - av_A.cross(rA);
+		real_t tn = normal.dot(dtv);
 
 		// tangential velocity
-		Vector3 tv = dtv - c.normal * tn;
+		Vector3 tv = dtv - normal * tn;
 		real_t tvl = tv.length();
 
 		if (tvl > MIN_VELOCITY) {
 			tv /= tvl;
 
-			Vector3 temp1 = inv_inertia_tensor_A.xform(c.rA.cross(tv));
-			Vector3 temp2 = inv_inertia_tensor_B.xform(c.rB.cross(tv));
+			Vector3 temp1 = inv_inertia_tensor_A.xform(rA.cross(tv));
+			Vector3 temp2 = inv_inertia_tensor_B.xform(rB.cross(tv));
 
-			real_t t = -tvl / (inv_mass_A + inv_mass_B + tv.dot(temp1.cross(c.rA) + temp2.cross(c.rB)));
+			real_t t = -tvl / (inv_mass_A + inv_mass_B + tv.dot(temp1.cross(rA) + temp2.cross(rB)));
 
 			Vector3 jt = t * tv;
 
@@ -584,21 +682,97 @@ void GodotBodyPair3D::solve(real_t p_step) {
 
 			jt = c.acc_tangent_impulse - jtOld;
 
-			if (collide_A) {
-				A->apply_impulse(-jt, c.rA + A->get_center_of_mass());
-			}
-			if (collide_B) {
-				B->apply_impulse(jt, c.rB + B->get_center_of_mass());
-			}
+			lv_A -= jt * inv_mass_A;
+			av_A -= inv_inertia_tensor_A.xform(rA.cross(jt));
+			lv_B += jt * inv_mass_B;
+			av_B += inv_inertia_tensor_B.xform(rB.cross(jt));
 			c.acc_impulse -= jt;
 
-			c.active = true;
+			sc.active[k] = true;
 		}
 	}
+
+	if (collide_A) {
+		A->set_linear_velocity(lv_A);
+		A->set_angular_velocity(av_A);
+		A->set_biased_linear_velocity(blv_A);
+		A->set_biased_angular_velocity(bav_A);
+	}
+	if (collide_B) {
+		B->set_linear_velocity(lv_B);
+		B->set_angular_velocity(av_B);
+		B->set_biased_linear_velocity(blv_B);
+		B->set_biased_angular_velocity(bav_B);
+	}
+}
+
+void GodotBodyPair3D::save_snapshot_state(SnapshotState &r_state) const {
+	// Copied field by field, so that padding in the snapshot stays zeroed.
+	// Slots past the contact count are stale and left out, they're rebuilt before being used again.
+	for (int i = 0; i < contact_count; i++) {
+		const Contact &c = contacts[i];
+		Contact &s = r_state.contacts[i];
+		s.position = c.position;
+		s.normal = c.normal;
+		s.index_A = c.index_A;
+		s.index_B = c.index_B;
+		s.local_A = c.local_A;
+		s.local_B = c.local_B;
+		s.acc_impulse = c.acc_impulse;
+		s.acc_normal_impulse = c.acc_normal_impulse;
+		s.acc_tangent_impulse = c.acc_tangent_impulse;
+		s.acc_bias_impulse = c.acc_bias_impulse;
+		s.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
+		s.mass_normal = c.mass_normal;
+		s.bias = c.bias;
+		s.bounce = c.bounce;
+		s.depth = c.depth;
+		s.active = c.active;
+		s.used = c.used;
+		s.rA = c.rA;
+		s.rB = c.rB;
+	}
+	if (manifold_cache.valid) {
+		r_state.manifold_xform_A = manifold_cache.xform_A;
+		r_state.manifold_xform_B = manifold_cache.xform_B;
+	}
+	r_state.sep_axis = sep_axis;
+	r_state.offset_B = offset_B;
+	r_state.contact_count = contact_count;
+	r_state.collided = collided;
+	r_state.manifold_valid = manifold_cache.valid;
+}
+
+void GodotBodyPair3D::restore_snapshot_state(const SnapshotState &p_state) {
+	for (int i = 0; i < MAX_CONTACTS; i++) {
+		contacts[i] = p_state.contacts[i];
+	}
+	sep_axis = p_state.sep_axis;
+	offset_B = p_state.offset_B;
+	contact_count = CLAMP(p_state.contact_count, 0, int(MAX_CONTACTS));
+	collided = p_state.collided;
+
+	manifold_cache.valid = p_state.manifold_valid;
+	if (manifold_cache.valid) {
+		manifold_cache.xform_A = p_state.manifold_xform_A;
+		manifold_cache.xform_B = p_state.manifold_xform_B;
+		manifold_cache.shape_A = A->get_shape(shape_A);
+		manifold_cache.shape_B = B->get_shape(shape_B);
+		manifold_cache.shapes_version_A = A->get_shapes_version();
+		manifold_cache.shapes_version_B = B->get_shapes_version();
+	}
+}
+
+void GodotBodyPair3D::clear_contacts() {
+	contact_count = 0;
+	collided = false;
+	sep_axis = Vector3();
+	manifold_cache.valid = false;
 }
 
 GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B) :
-		GodotBodyContact3D(_arr, 2) {
+		GodotBodyContact3D(_arr, 2),
+		space_list(this) {
 	A = p_A;
 	B = p_B;
 	shape_A = p_shape_A;
@@ -606,6 +780,10 @@ GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p
 	space = A->get_space();
 	A->add_constraint(this, 0);
 	B->add_constraint(this, 1);
+
+	if (space) {
+		space->body_pair_add_to_list(&space_list);
+	}
 }
 
 GodotBodyPair3D::~GodotBodyPair3D() {
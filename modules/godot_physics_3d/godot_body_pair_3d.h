@@ -96,14 +96,74 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
+	// Active contacts packed by pre_solve() for solve(), with the angular
+	// velocity response to a unit normal impulse precomputed for each body.
+	struct SolverContacts {
+		int count = 0;
+		int index[MAX_CONTACTS] = {};
+		bool active[MAX_CONTACTS] = {};
+		Vector3 normal[MAX_CONTACTS];
+		Vector3 rA[MAX_CONTACTS];
+		Vector3 rB[MAX_CONTACTS];
+		Vector3 angular_A[MAX_CONTACTS];
+		Vector3 angular_B[MAX_CONTACTS];
+		real_t mass_normal[MAX_CONTACTS] = {};
+		real_t bias[MAX_CONTACTS] = {};
+		real_t bounce[MAX_CONTACTS] = {};
+	};
+
+	SolverContacts solver_contacts;
+	real_t friction = 0.0;
+
+	// Narrowphase inputs that produced the current contacts, so they can be
+	// kept while the bodies don't move relative to each other.
+	struct ManifoldCache {
+		bool valid = false;
+		Transform3D xform_A;
+		Transform3D xform_B;
+		const GodotShape3D *shape_A = nullptr;
+		const GodotShape3D *shape_B = nullptr;
+		uint32_t shapes_version_A = 0;
+		uint32_t shapes_version_B = 0;
+	};
+
+	ManifoldCache manifold_cache;
+	bool manifold_reused = false; // By the last setup(), reported to the space by pre_solve().
+
+	SelfList<GodotBodyPair3D> space_list;
+
 	static void _contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
 
 	void validate_contacts();
+	bool _can_reuse_contacts(const Transform3D &p_xform_A, const GodotShape3D *p_shape_A, const Transform3D &p_xform_B, const GodotShape3D *p_shape_B) const;
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
 
 public:
+	// Contact cache copied by space snapshots. The manifold cache is kept
+	// as transforms only, the shapes are those of the pair when restored.
+	struct SnapshotState {
+		Contact contacts[MAX_CONTACTS];
+		Transform3D manifold_xform_A;
+		Transform3D manifold_xform_B;
+		Vector3 sep_axis;
+		Vector3 offset_B;
+		int32_t contact_count = 0;
+		bool collided = false;
+		bool manifold_valid = false;
+	};
+
+	_FORCE_INLINE_ GodotBody3D *get_body_A() const { return A; }
+	_FORCE_INLINE_ GodotBody3D *get_body_B() const { return B; }
+	_FORCE_INLINE_ int get_shape_A() const { return shape_A; }
+	_FORCE_INLINE_ int get_shape_B() const { return shape_B; }
+	_FORCE_INLINE_ int get_contact_count() const { return contact_count; }
+
+	void save_snapshot_state(SnapshotState &r_state) const;
+	void restore_snapshot_state(const SnapshotState &p_state);
+	void clear_contacts();
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
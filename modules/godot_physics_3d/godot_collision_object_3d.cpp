@@ -232,6 +232,7 @@ void GodotCollisionObject3D::_set_space(GodotSpace3D *p_space) {
 }
 
 void GodotCollisionObject3D::_shape_changed() {
+	shapes_version++;
 	_update_shapes();
 	_shapes_changed();
 }
@@ -55,6 +55,7 @@ private:
 	Type type;
 	RID self;
 	ObjectID instance_id;
+	uint64_t sequence = 0; // Order of addition to the space, used to match objects with their records in space snapshots.
 	uint32_t collision_layer = 1;
 	uint32_t collision_mask = 1;
 	real_t collision_priority = 1.0;
@@ -70,6 +71,7 @@ private:
 	};
 
 	Vector<Shape> shapes;
+	uint32_t shapes_version = 0;
 	GodotSpace3D *space = nullptr;
 	Transform3D transform;
 	Transform3D inv_transform;
@@ -111,6 +113,9 @@ public:
 	_FORCE_INLINE_ void set_instance_id(const ObjectID &p_instance_id) { instance_id = p_instance_id; }
 	_FORCE_INLINE_ ObjectID get_instance_id() const { return instance_id; }
 
+	_FORCE_INLINE_ void set_sequence(uint64_t p_sequence) { sequence = p_sequence; }
+	_FORCE_INLINE_ uint64_t get_sequence() const { return sequence; }
+
 	void _shape_changed() override;
 
 	_FORCE_INLINE_ Type get_type() const { return type; }
@@ -118,6 +123,8 @@ public:
 	void set_shape(int p_index, GodotShape3D *p_shape);
 	void set_shape_transform(int p_index, const Transform3D &p_transform);
 	_FORCE_INLINE_ int get_shape_count() const { return shapes.size(); }
+	// Changes whenever the data of one of the shapes is changed.
+	_FORCE_INLINE_ uint32_t get_shapes_version() const { return shapes_version; }
 	_FORCE_INLINE_ GodotShape3D *get_shape(int p_index) const {
 		CRASH_BAD_INDEX(p_index, shapes.size());
 		return shapes[p_index].shape;
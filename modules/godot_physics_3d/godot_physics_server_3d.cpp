@@ -214,6 +214,18 @@ int GodotPhysicsServer3D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+Vector<uint8_t> GodotPhysicsServer3D::space_save_state(RID p_space) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, Vector<uint8_t>());
+	return space->save_state();
+}
+
+bool GodotPhysicsServer3D::space_restore_state(RID p_space, const Vector<uint8_t> &p_state) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, false);
+	return space->restore_state(p_state);
+}
+
 RID GodotPhysicsServer3D::area_create() {
 	GodotArea3D *area = memnew(GodotArea3D);
 	RID rid = area_owner.make_rid(area);
@@ -1700,11 +1712,30 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	pairs_added = 0;
+	pairs_removed = 0;
+	query_count = 0;
+	slowest_island_time = 0;
+	const uint64_t begin_time = OS::get_singleton()->get_ticks_usec();
 	for (GodotSpace3D *E : active_spaces) {
 		stepper->step(E, p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
+		pairs_added += E->get_pairs_added();
+		pairs_removed += E->get_pairs_removed();
+		query_count += E->take_query_count();
+		slowest_island_time = MAX(slowest_island_time, E->get_slowest_island_time());
+	}
+	step_time = OS::get_singleton()->get_ticks_usec() - begin_time;
+
+	// Gathered here rather than when the monitors are read, since with physics on a separate thread
+	// the pair and object lists can only be walked safely from inside the step.
+	contact_count = 0;
+	sleeping_objects = 0;
+	for (const GodotSpace3D *E : active_spaces) {
+		contact_count += E->get_contact_count();
+		sleeping_objects += E->get_sleeping_objects();
 	}
 }
 
@@ -1781,6 +1812,27 @@ int GodotPhysicsServer3D::get_process_info(PS3DE::ProcessInfo p_info) {
 		case PS3DE::INFO_ISLAND_COUNT: {
 			return island_count;
 		} break;
+		case PS3DE::INFO_CONTACT_COUNT: {
+			return contact_count;
+		} break;
+		case PS3DE::INFO_SLEEPING_OBJECTS: {
+			return sleeping_objects;
+		} break;
+		case PS3DE::INFO_PAIRS_ADDED: {
+			return pairs_added;
+		} break;
+		case PS3DE::INFO_PAIRS_REMOVED: {
+			return pairs_removed;
+		} break;
+		case PS3DE::INFO_QUERY_COUNT: {
+			return query_count;
+		} break;
+		case PS3DE::INFO_STEP_TIME: {
+			return step_time;
+		} break;
+		case PS3DE::INFO_SLOWEST_ISLAND_TIME: {
+			return slowest_island_time;
+		} break;
 	}
 
 	return 0;
@@ -33,9 +33,14 @@
 #include "godot_space_3d.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 #include "servers/physics_3d/physics_server_3d_rendering_server_handler.h"
 #include "servers/rendering/rendering_server.h"
 
+#define PARALLEL_SOLVE_MIN_LINKS 2048
+#define LINK_BATCH_MAX_COLORS 64
+#define LINK_BATCH_CHUNK_SIZE 256
+
 // Based on Bullet soft body.
 
 /*
@@ -427,6 +432,10 @@ uint32_t GodotSoftBody3D::get_node_count() const {
 	return nodes.size();
 }
 
+uint32_t GodotSoftBody3D::get_link_count() const {
+	return links.size();
+}
+
 real_t GodotSoftBody3D::get_node_inv_mass(uint32_t p_node_index) const {
 	ERR_FAIL_UNSIGNED_INDEX_V(p_node_index, nodes.size(), 0.0);
 	return nodes[p_node_index].im;
@@ -612,6 +621,7 @@ bool GodotSoftBody3D::create_from_trimesh(const Vector<int> &p_indices, const Ve
 
 	generate_bending_constraints(2);
 	reoptimize_link_order();
+	_update_link_batches();
 
 	update_constants();
 	update_normals_and_centroids();
@@ -1080,9 +1090,6 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 		node.f = Vector3();
 	}
 
-	// Bounds and tree update.
-	update_bounds();
-
 	// Node tree update.
 	for (const Node &node : nodes) {
 		AABB node_aabb(node.x, Vector3());
@@ -1116,9 +1123,14 @@ void GodotSoftBody3D::solve_constraints(real_t p_delta) {
 	}
 
 	// Solve positions.
+	const bool solve_batches = is_solved_in_parallel();
 	for (int isolve = 0; isolve < iteration_count; ++isolve) {
-		const real_t ti = isolve / (real_t)iteration_count;
-		solve_links(1.0, ti);
+		if (solve_batches) {
+			_solve_link_batches(1.0);
+		} else {
+			const real_t ti = isolve / (real_t)iteration_count;
+			solve_links(1.0, ti);
+		}
 	}
 	const real_t vc = (1.0 - damping_coefficient) * inv_delta;
 	for (Node &node : nodes) {
@@ -1133,20 +1145,135 @@ void GodotSoftBody3D::solve_constraints(real_t p_delta) {
 	update_normals_and_centroids();
 }
 
+void GodotSoftBody3D::_solve_link(Link &p_link, real_t kst) {
+	if (p_link.c0 > 0) {
+		Node &node_a = *p_link.n[0];
+		Node &node_b = *p_link.n[1];
+		const Vector3 del = node_b.x - node_a.x;
+		const real_t len = del.length_squared();
+		if (p_link.c1 + len > CMP_EPSILON) {
+			const real_t k = ((p_link.c1 - len) / (p_link.c0 * (p_link.c1 + len))) * kst;
+			node_a.x -= del * (k * node_a.im);
+			node_b.x += del * (k * node_b.im);
+		}
+	}
+}
+
 void GodotSoftBody3D::solve_links(real_t kst, real_t ti) {
 	for (Link &link : links) {
-		if (link.c0 > 0) {
-			Node &node_a = *link.n[0];
-			Node &node_b = *link.n[1];
-			const Vector3 del = node_b.x - node_a.x;
-			const real_t len = del.length_squared();
-			if (link.c1 + len > CMP_EPSILON) {
-				const real_t k = ((link.c1 - len) / (link.c0 * (link.c1 + len))) * kst;
-				node_a.x -= del * (k * node_a.im);
-				node_b.x += del * (k * node_b.im);
+		_solve_link(link, kst);
+	}
+}
+
+bool GodotSoftBody3D::is_solved_in_parallel() const {
+	return !link_batch_offsets.is_empty();
+}
+
+void GodotSoftBody3D::get_link_batches(LocalVector<LocalVector<Vector2i>> &r_batches, LocalVector<Vector2i> &r_serial_links) const {
+	r_batches.clear();
+	r_serial_links.clear();
+	if (link_batch_offsets.is_empty()) {
+		return;
+	}
+
+	// The last offset is where the serially solved links start.
+	r_batches.resize(link_batch_offsets.size() - 1);
+	for (uint32_t batch = 0; batch < r_batches.size(); batch++) {
+		for (uint32_t i = link_batch_offsets[batch]; i < link_batch_offsets[batch + 1]; i++) {
+			const Link &link = links[link_batch_order[i]];
+			r_batches[batch].push_back(Vector2i(link.n[0]->index, link.n[1]->index));
+		}
+	}
+	for (uint32_t i = link_batch_offsets[link_batch_offsets.size() - 1]; i < link_batch_order.size(); i++) {
+		const Link &link = links[link_batch_order[i]];
+		r_serial_links.push_back(Vector2i(link.n[0]->index, link.n[1]->index));
+	}
+}
+
+void GodotSoftBody3D::_update_link_batches() {
+	link_batch_order.clear();
+	link_batch_offsets.clear();
+
+	const uint32_t link_count = links.size();
+	if (link_count < PARALLEL_SOLVE_MIN_LINKS) {
+		return;
+	}
+
+	// Greedy coloring in link order, the last color holds the links that ran out of colors.
+	LocalVector<uint64_t> node_colors;
+	node_colors.resize(nodes.size());
+	memset(node_colors.ptr(), 0, node_colors.size() * sizeof(uint64_t));
+
+	LocalVector<uint8_t> link_colors;
+	link_colors.resize(link_count);
+	uint32_t color_offsets[LINK_BATCH_MAX_COLORS + 1] = {};
+
+	for (uint32_t i = 0; i < link_count; i++) {
+		const uint32_t node_a = links[i].n[0]->index;
+		const uint32_t node_b = links[i].n[1]->index;
+		const uint64_t used_colors = node_colors[node_a] | node_colors[node_b];
+
+		uint32_t color = 0;
+		while (color < LINK_BATCH_MAX_COLORS && (used_colors & (uint64_t(1) << color))) {
+			color++;
+		}
+		if (color < LINK_BATCH_MAX_COLORS) {
+			node_colors[node_a] |= uint64_t(1) << color;
+			node_colors[node_b] |= uint64_t(1) << color;
+		}
+		link_colors[i] = color;
+		color_offsets[color]++;
+	}
+
+	uint32_t offset = 0;
+	for (uint32_t color = 0; color <= LINK_BATCH_MAX_COLORS; color++) {
+		const uint32_t count = color_offsets[color];
+		color_offsets[color] = offset;
+		if (count > 0 && color < LINK_BATCH_MAX_COLORS) {
+			link_batch_offsets.push_back(offset);
+		}
+		offset += count;
+	}
+	link_batch_offsets.push_back(color_offsets[LINK_BATCH_MAX_COLORS]);
+
+	link_batch_order.resize(link_count);
+	for (uint32_t i = 0; i < link_count; i++) {
+		link_batch_order[color_offsets[link_colors[i]]++] = i;
+	}
+}
+
+void GodotSoftBody3D::_solve_link_batch_chunk(uint32_t p_chunk_index, const LinkBatch *p_batch) {
+	const uint32_t begin = p_batch->begin + p_chunk_index * LINK_BATCH_CHUNK_SIZE;
+	const uint32_t end = MIN(begin + LINK_BATCH_CHUNK_SIZE, p_batch->end);
+	for (uint32_t i = begin; i < end; i++) {
+		_solve_link(links[link_batch_order[i]], p_batch->kst);
+	}
+}
+
+void GodotSoftBody3D::_solve_link_batches(real_t kst) {
+	WorkerThreadPool *thread_pool = WorkerThreadPool::get_singleton();
+	const bool use_threads = thread_pool->get_thread_count() > 1;
+
+	// Links within a batch don't share nodes, so the result doesn't depend on how the batch is split.
+	LinkBatch batch;
+	batch.kst = kst;
+	for (uint32_t i = 0; i + 1 < link_batch_offsets.size(); i++) {
+		batch.begin = link_batch_offsets[i];
+		batch.end = link_batch_offsets[i + 1];
+		const uint32_t chunk_count = (batch.end - batch.begin + LINK_BATCH_CHUNK_SIZE - 1) / LINK_BATCH_CHUNK_SIZE;
+		if (!use_threads || chunk_count == 1) {
+			for (uint32_t chunk = 0; chunk < chunk_count; chunk++) {
+				_solve_link_batch_chunk(chunk, &batch);
 			}
+		} else {
+			WorkerThreadPool::GroupID group_task = thread_pool->add_template_group_task(this, &GodotSoftBody3D::_solve_link_batch_chunk, (const LinkBatch *)&batch, chunk_count, -1, true, SNAME("SoftBody3DSolveLinks"));
+			thread_pool->wait_for_group_task_completion(group_task);
 		}
 	}
+
+	for (uint32_t i = link_batch_offsets[link_batch_offsets.size() - 1]; i < link_batch_order.size(); i++) {
+		_solve_link(links[link_batch_order[i]], kst);
+	}
 }
 
 struct AABBQueryResult {
@@ -1258,6 +1385,9 @@ void GodotSoftBody3D::destroy() {
 	links.clear();
 	faces.clear();
 
+	link_batch_order.clear();
+	link_batch_offsets.clear();
+
 	bounds = AABB();
 	deinitialize_shape();
 }
@@ -35,6 +35,7 @@
 
 #include "core/math/aabb.h"
 #include "core/math/dynamic_bvh.h"
+#include "core/math/vector2i.h"
 #include "core/math/vector3.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/local_vector.h"
@@ -112,6 +113,17 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 
 	uint64_t island_step = 0;
 
+	// Large soft bodies split their links by graph coloring into batches that don't share any node,
+	// so each batch can be solved in parallel. Links that don't fit in a batch are solved serially.
+	LocalVector<uint32_t> link_batch_order;
+	LocalVector<uint32_t> link_batch_offsets;
+
+	struct LinkBatch {
+		uint32_t begin = 0;
+		uint32_t end = 0;
+		real_t kst = 0.0;
+	};
+
 	_FORCE_INLINE_ Vector3 _compute_area_windforce(const GodotArea3D *p_area, const Face *p_face);
 
 public:
@@ -169,6 +181,7 @@ public:
 	bool is_vertex_pinned(int p_index) const;
 
 	uint32_t get_node_count() const;
+	uint32_t get_link_count() const;
 	real_t get_node_inv_mass(uint32_t p_node_index) const;
 	Vector3 get_node_position(uint32_t p_node_index) const;
 	Vector3 get_node_velocity(uint32_t p_node_index) const;
@@ -208,8 +221,14 @@ public:
 	void set_drag_coefficient(real_t p_val);
 	_FORCE_INLINE_ real_t get_drag_coefficient() const { return drag_coefficient; }
 
+	// Can run for several soft bodies in parallel, update_bounds() must be called afterwards.
 	void predict_motion(real_t p_delta);
+	void update_bounds();
+	// Can run for several soft bodies in parallel, except those solved in parallel on their own.
 	void solve_constraints(real_t p_delta);
+	bool is_solved_in_parallel() const;
+	// Node indices of the links in each batch solved in parallel, and of the links solved serially after the batches.
+	void get_link_batches(LocalVector<LocalVector<Vector2i>> &r_batches, LocalVector<Vector2i> &r_serial_links) const;
 
 	_FORCE_INLINE_ uint32_t get_node_index(void *p_node) const { return static_cast<Node *>(p_node)->index; }
 	_FORCE_INLINE_ uint32_t get_face_index(void *p_face) const { return static_cast<Face *>(p_face)->index; }
@@ -226,7 +245,6 @@ protected:
 
 private:
 	void update_normals_and_centroids();
-	void update_bounds();
 	void update_constants();
 	void update_area();
 	void reset_link_rest_lengths();
@@ -245,6 +263,10 @@ private:
 	void append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p_node3);
 
 	void solve_links(real_t kst, real_t ti);
+	_FORCE_INLINE_ void _solve_link(Link &p_link, real_t kst);
+	void _update_link_batches();
+	void _solve_link_batches(real_t kst);
+	void _solve_link_batch_chunk(uint32_t p_chunk_index, const LinkBatch *p_batch);
 
 	void initialize_face_tree();
 	void update_face_tree(real_t p_delta);
@@ -36,10 +36,15 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/profiling/profiling.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
 
+// Amount of queries a worker thread runs at once when a query batch is split.
+#define QUERY_BATCH_CHUNK_SIZE 64
+
 _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject3D *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 	if (!(p_object->get_collision_layer() & p_collision_mask)) {
 		return false;
@@ -60,9 +65,8 @@ _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject3D *p_object, u
 	return true;
 }
 
-int GodotPhysicsDirectSpaceState3D::intersect_point(const PS3DT::PointParameters &p_parameters, PS3DT::ShapeResult *r_results, int p_result_max) {
-	ERR_FAIL_COND_V(space->locked, false);
-	int amount = space->broadphase->cull_point(p_parameters.position, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+int GodotPhysicsDirectSpaceState3D::_intersect_point(const PS3DT::PointParameters &p_parameters, const Vector3 &p_position, PS3DT::ShapeResult *r_results, int p_result_max, GodotCollisionObject3D **r_cull_results, int *r_cull_subindex_results) {
+	int amount = space->broadphase->cull_point(p_position, r_cull_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_cull_subindex_results);
 	int cc = 0;
 
 	//Transform3D ai = p_xform.affine_inverse();
@@ -72,23 +76,23 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PS3DT::PointParameters
 			break;
 		}
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
 		//area can't be picked by ray (default)
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = r_cull_results[i];
+		int shape_idx = r_cull_subindex_results[i];
 
 		Transform3D inv_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		inv_xform.affine_invert();
 
-		if (!col_obj->get_shape(shape_idx)->intersect_point(inv_xform.xform(p_parameters.position))) {
+		if (!col_obj->get_shape(shape_idx)->intersect_point(inv_xform.xform(p_position))) {
 			continue;
 		}
 
@@ -107,16 +111,20 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PS3DT::PointParameters
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const PS3DT::RayParameters &p_parameters, PS3DT::RayResult &r_result) {
+int GodotPhysicsDirectSpaceState3D::intersect_point(const PS3DT::PointParameters &p_parameters, PS3DT::ShapeResult *r_results, int p_result_max) {
+	space->add_query_count(1);
 	ERR_FAIL_COND_V(space->locked, false);
+	return _intersect_point(p_parameters, p_parameters.position, r_results, p_result_max, space->intersection_query_results, space->intersection_query_subindex_results);
+}
 
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray(const PS3DT::RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, PS3DT::RayResult &r_result, GodotCollisionObject3D **r_cull_results, int *r_cull_subindex_results) {
 	Vector3 begin, end;
 	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_segment(begin, end, r_cull_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_cull_subindex_results);
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -128,21 +136,21 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const PS3DT::RayParameters &p
 	real_t min_d = 1e10;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(r_cull_results[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = r_cull_results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = r_cull_subindex_results[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -207,7 +215,14 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const PS3DT::RayParameters &p
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const PS3DT::RayParameters &p_parameters, PS3DT::RayResult &r_result) {
+	space->add_query_count(1);
+	ERR_FAIL_COND_V(space->locked, false);
+	return _intersect_ray(p_parameters, p_parameters.from, p_parameters.to, r_result, space->intersection_query_results, space->intersection_query_subindex_results);
+}
+
 int GodotPhysicsDirectSpaceState3D::intersect_shape(const PS3DT::ShapeParameters &p_parameters, PS3DT::ShapeResult *r_results, int p_result_max) {
+	space->add_query_count(1);
 	if (p_result_max <= 0) {
 		return 0;
 	}
@@ -262,55 +277,54 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const PS3DT::ShapeParameters
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::cast_motion(const PS3DT::ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, PS3DT::ShapeRestInfo *r_info) {
-	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, false);
+bool GodotPhysicsDirectSpaceState3D::_cast_motion(const PS3DT::ShapeParameters &p_parameters, GodotShape3D *p_shape, const Transform3D &p_transform, const Vector3 &p_motion, real_t &p_closest_safe, real_t &p_closest_unsafe, PS3DT::ShapeRestInfo *r_info, GodotCollisionObject3D **r_cull_results, int *r_cull_subindex_results) {
+	GodotShape3D *shape = p_shape;
 
-	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
-	aabb = aabb.merge(AABB(aabb.position + p_parameters.motion, aabb.size)); //motion
+	AABB aabb = p_transform.xform(shape->get_aabb());
+	aabb = aabb.merge(AABB(aabb.position + p_motion, aabb.size)); //motion
 	aabb = aabb.grow(p_parameters.margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, r_cull_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_cull_subindex_results);
 
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
 
-	Transform3D xform_inv = p_parameters.transform.affine_inverse();
+	Transform3D xform_inv = p_transform.affine_inverse();
 	GodotMotionShape3D mshape;
 	mshape.shape = shape;
-	mshape.motion = xform_inv.basis.xform(p_parameters.motion);
+	mshape.motion = xform_inv.basis.xform(p_motion);
 
 	bool best_first = true;
 
-	Vector3 motion_normal = p_parameters.motion.normalized();
+	Vector3 motion_normal = p_motion.normalized();
 
 	Vector3 closest_A, closest_B;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue; //ignore excluded
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = r_cull_results[i];
+		int shape_idx = r_cull_subindex_results[i];
 
 		Vector3 point_A, point_B;
 		Vector3 sep_axis = motion_normal;
 
 		Transform3D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
-		if (GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (GodotCollisionSolver3D::solve_distance(&mshape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
 			continue;
 		}
 
 		//test initial overlap, ignore objects it's inside of.
 		sep_axis = motion_normal;
 
-		if (!GodotCollisionSolver3D::solve_distance(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (!GodotCollisionSolver3D::solve_distance(shape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
 			continue;
 		}
 
@@ -321,11 +335,11 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const PS3DT::ShapeParameters &p
 		for (int j = 0; j < 8; j++) { //steps should be customizable..
 			real_t fraction = low + (hi - low) * fraction_coeff;
 
-			mshape.motion = xform_inv.basis.xform(p_parameters.motion * fraction);
+			mshape.motion = xform_inv.basis.xform(p_motion * fraction);
 
 			Vector3 lA, lB;
 			Vector3 sep = motion_normal; //important optimization for this to work fast enough
-			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, aabb, &sep);
+			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, aabb, &sep);
 
 			if (collided) {
 				hi = fraction;
@@ -381,7 +395,142 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const PS3DT::ShapeParameters &p
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState3D::cast_motion(const PS3DT::ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, PS3DT::ShapeRestInfo *r_info) {
+	space->add_query_count(1);
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+
+	return _cast_motion(p_parameters, shape, p_parameters.transform, p_parameters.motion, p_closest_safe, p_closest_unsafe, r_info, space->intersection_query_results, space->intersection_query_subindex_results);
+}
+
+struct GodotPhysicsDirectSpaceState3D::QueryBatch {
+	enum Type {
+		TYPE_RAY,
+		TYPE_POINT,
+		TYPE_MOTION,
+	};
+
+	Type type = TYPE_RAY;
+	const PS3DT::RayParameters *ray_parameters = nullptr;
+	const PS3DT::PointParameters *point_parameters = nullptr;
+	const PS3DT::ShapeParameters *shape_parameters = nullptr;
+	GodotShape3D *shape = nullptr;
+
+	const Vector3 *points = nullptr; // Ray origins, point positions or shape origins.
+	const Vector3 *vectors = nullptr; // Ray ends or shape motions.
+	LocalVector<uint32_t> order;
+
+	PS3DT::RayResult *ray_results = nullptr;
+	PS3DT::ShapeResult *point_results = nullptr;
+	real_t *closest_safe = nullptr;
+	real_t *closest_unsafe = nullptr;
+
+	SafeNumeric<uint32_t> hit_count;
+};
+
+bool GodotPhysicsDirectSpaceState3D::_run_query(QueryBatch &p_batch, uint32_t p_index, GodotCollisionObject3D **r_cull_results, int *r_cull_subindex_results) {
+	switch (p_batch.type) {
+		case QueryBatch::TYPE_RAY: {
+			p_batch.ray_results[p_index] = PS3DT::RayResult();
+			return _intersect_ray(*p_batch.ray_parameters, p_batch.points[p_index], p_batch.vectors[p_index], p_batch.ray_results[p_index], r_cull_results, r_cull_subindex_results);
+		}
+		case QueryBatch::TYPE_POINT: {
+			p_batch.point_results[p_index] = PS3DT::ShapeResult();
+			return _intersect_point(*p_batch.point_parameters, p_batch.points[p_index], &p_batch.point_results[p_index], 1, r_cull_results, r_cull_subindex_results) > 0;
+		}
+		case QueryBatch::TYPE_MOTION: {
+			Transform3D transform = p_batch.shape_parameters->transform;
+			transform.origin = p_batch.points[p_index];
+			p_batch.closest_safe[p_index] = 1.0;
+			p_batch.closest_unsafe[p_index] = 1.0;
+			return _cast_motion(*p_batch.shape_parameters, p_batch.shape, transform, p_batch.vectors[p_index], p_batch.closest_safe[p_index], p_batch.closest_unsafe[p_index], nullptr, r_cull_results, r_cull_subindex_results);
+		}
+	}
+	return false;
+}
+
+void GodotPhysicsDirectSpaceState3D::_run_query_batch_chunk(uint32_t p_chunk_index, QueryBatch *p_batch) {
+	// The cull buffers of the space belong to the calling thread, each chunk uses its own.
+	LocalVector<GodotCollisionObject3D *> cull_results;
+	cull_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	LocalVector<int> cull_subindex_results;
+	cull_subindex_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+
+	const uint32_t begin = p_chunk_index * QUERY_BATCH_CHUNK_SIZE;
+	const uint32_t end = MIN(begin + QUERY_BATCH_CHUNK_SIZE, p_batch->order.size());
+	uint32_t hit_count = 0;
+	for (uint32_t i = begin; i < end; i++) {
+		if (_run_query(*p_batch, p_batch->order[i], cull_results.ptr(), cull_subindex_results.ptr())) {
+			hit_count++;
+		}
+	}
+	p_batch->hit_count.add(hit_count);
+}
+
+int GodotPhysicsDirectSpaceState3D::_run_query_batch(QueryBatch &p_batch, int p_count) {
+	_sort_queries_spatially(p_batch.points, p_count, p_batch.order);
+
+	if (p_count <= QUERY_BATCH_CHUNK_SIZE || WorkerThreadPool::get_singleton()->get_thread_count() < 2) {
+		int hit_count = 0;
+		for (uint32_t index : p_batch.order) {
+			if (_run_query(p_batch, index, space->intersection_query_results, space->intersection_query_subindex_results)) {
+				hit_count++;
+			}
+		}
+		return hit_count;
+	}
+
+	const uint32_t chunk_count = (p_count + QUERY_BATCH_CHUNK_SIZE - 1) / QUERY_BATCH_CHUNK_SIZE;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_run_query_batch_chunk, &p_batch, chunk_count, -1, true, SNAME("Physics3DQueryBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	return p_batch.hit_count.get();
+}
+
+int GodotPhysicsDirectSpaceState3D::intersect_rays(const PS3DT::RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, PS3DT::RayResult *r_results) {
+	space->add_query_count(p_count);
+	ERR_FAIL_COND_V(space->locked, 0);
+
+	QueryBatch batch;
+	batch.type = QueryBatch::TYPE_RAY;
+	batch.ray_parameters = &p_parameters;
+	batch.points = p_from;
+	batch.vectors = p_to;
+	batch.ray_results = r_results;
+	return _run_query_batch(batch, p_count);
+}
+
+int GodotPhysicsDirectSpaceState3D::intersect_points(const PS3DT::PointParameters &p_parameters, const Vector3 *p_positions, int p_count, PS3DT::ShapeResult *r_results) {
+	space->add_query_count(p_count);
+	ERR_FAIL_COND_V(space->locked, 0);
+
+	QueryBatch batch;
+	batch.type = QueryBatch::TYPE_POINT;
+	batch.point_parameters = &p_parameters;
+	batch.points = p_positions;
+	batch.point_results = r_results;
+	return _run_query_batch(batch, p_count);
+}
+
+bool GodotPhysicsDirectSpaceState3D::cast_motions(const PS3DT::ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	space->add_query_count(p_count);
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+
+	QueryBatch batch;
+	batch.type = QueryBatch::TYPE_MOTION;
+	batch.shape_parameters = &p_parameters;
+	batch.shape = shape;
+	batch.points = p_origins;
+	batch.vectors = p_motions;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+	_run_query_batch(batch, p_count);
+	return true;
+}
+
 bool GodotPhysicsDirectSpaceState3D::collide_shape(const PS3DT::ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) {
+	space->add_query_count(1);
 	if (p_result_max <= 0) {
 		return false;
 	}
@@ -512,6 +661,7 @@ static void _rest_cbk_result(const Vector3 &p_point_A, int p_index_A, const Vect
 }
 
 bool GodotPhysicsDirectSpaceState3D::rest_info(const PS3DT::ShapeParameters &p_parameters, PS3DT::ShapeRestInfo *r_info) {
+	space->add_query_count(1);
 	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
 	ERR_FAIL_NULL_V(shape, false);
 
@@ -1043,6 +1193,7 @@ void *GodotSpace3D::_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A
 	GodotSpace3D *self = static_cast<GodotSpace3D *>(p_self);
 
 	self->collision_pairs++;
+	self->pairs_added++;
 
 	if (type_A == GodotCollisionObject3D::TYPE_AREA) {
 		GodotArea3D *area = static_cast<GodotArea3D *>(A);
@@ -1064,7 +1215,22 @@ void *GodotSpace3D::_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A
 			GodotBodySoftBodyPair3D *soft_pair = memnew(GodotBodySoftBodyPair3D(static_cast<GodotBody3D *>(A), p_subindex_A, static_cast<GodotSoftBody3D *>(B)));
 			return soft_pair;
 		} else {
+			if (A->get_sequence() > B->get_sequence()) {
+				// Keep the same body first however the broadphase reports the pair, so snapshots can find its contacts again.
+				SWAP(A, B);
+				SWAP(p_subindex_A, p_subindex_B);
+			}
 			GodotBodyPair3D *b = memnew(GodotBodyPair3D(static_cast<GodotBody3D *>(A), p_subindex_A, static_cast<GodotBody3D *>(B), p_subindex_B));
+
+			if (!self->pending_pair_states.is_empty()) {
+				HashMap<PairKey, uint32_t, PairKeyHasher>::Iterator E = self->pending_pair_states.find(_get_pair_key(b));
+				if (E) {
+					GodotBodyPair3D::SnapshotState state;
+					memcpy(&state, self->pending_pair_state_data.ptr() + E->value, sizeof(GodotBodyPair3D::SnapshotState));
+					b->restore_snapshot_state(state);
+					self->pending_pair_states.remove(E);
+				}
+			}
 			return b;
 		}
 	} else {
@@ -1081,10 +1247,38 @@ void GodotSpace3D::_broadphase_unpair(GodotCollisionObject3D *A, int p_subindex_
 
 	GodotSpace3D *self = static_cast<GodotSpace3D *>(p_self);
 	self->collision_pairs--;
+	self->pairs_removed++;
 	GodotConstraint3D *c = static_cast<GodotConstraint3D *>(p_data);
 	memdelete(c);
 }
 
+int GodotSpace3D::get_contact_count() const {
+	int count = 0;
+	for (const SelfList<GodotBodyPair3D> *E = body_pair_list.first(); E; E = E->next()) {
+		count += E->self()->get_contact_count();
+	}
+	return count;
+}
+
+int GodotSpace3D::get_sleeping_objects() const {
+	int count = 0;
+	for (const GodotCollisionObject3D *E : objects) {
+		if (E->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			const GodotBody3D *body = static_cast<const GodotBody3D *>(E);
+			if (body->get_mode() >= PS3DE::BODY_MODE_RIGID && !body->is_active()) {
+				count++;
+			}
+		}
+	}
+	return count;
+}
+
+uint32_t GodotSpace3D::take_query_count() {
+	const uint32_t count = query_count.get();
+	query_count.sub(count);
+	return count;
+}
+
 const SelfList<GodotBody3D>::List &GodotSpace3D::get_active_body_list() const {
 	return active_list;
 }
@@ -1112,11 +1306,14 @@ GodotBroadPhase3D *GodotSpace3D::get_broadphase() {
 void GodotSpace3D::add_object(GodotCollisionObject3D *p_object) {
 	ERR_FAIL_COND(objects.has(p_object));
 	objects.insert(p_object);
+	p_object->set_sequence(next_object_sequence++);
+	sorted_bodies_dirty = true;
 }
 
 void GodotSpace3D::remove_object(GodotCollisionObject3D *p_object) {
 	ERR_FAIL_COND(!objects.has(p_object));
 	objects.erase(p_object);
+	sorted_bodies_dirty = true;
 }
 
 const HashSet<GodotCollisionObject3D *> &GodotSpace3D::get_objects() const {
@@ -1163,6 +1360,213 @@ void GodotSpace3D::soft_body_remove_from_active_list(SelfList<GodotSoftBody3D> *
 	active_soft_body_list.remove(p_soft_body);
 }
 
+void GodotSpace3D::body_pair_add_to_list(SelfList<GodotBodyPair3D> *p_pair) {
+	body_pair_list.add(p_pair);
+}
+
+void GodotSpace3D::_update_sorted_bodies() {
+	sorted_bodies.clear();
+	for (GodotCollisionObject3D *E : objects) {
+		if (E->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			sorted_bodies.push_back(static_cast<GodotBody3D *>(E));
+		}
+	}
+
+	struct BodySequenceCompare {
+		_FORCE_INLINE_ bool operator()(const GodotBody3D *p_a, const GodotBody3D *p_b) const { return p_a->get_sequence() < p_b->get_sequence(); }
+	};
+	sorted_bodies.sort_custom<BodySequenceCompare>();
+	sorted_bodies_dirty = false;
+}
+
+const LocalVector<GodotBody3D *> &GodotSpace3D::get_sorted_bodies() {
+	if (sorted_bodies_dirty) {
+		_update_sorted_bodies();
+	}
+	return sorted_bodies;
+}
+
+GodotSpace3D::PairKey GodotSpace3D::_get_pair_key(const GodotBodyPair3D *p_pair) {
+	PairKey key;
+	key.sequence_A = p_pair->get_body_A()->get_sequence();
+	key.sequence_B = p_pair->get_body_B()->get_sequence();
+	key.shape_A = p_pair->get_shape_A();
+	key.shape_B = p_pair->get_shape_B();
+	return key;
+}
+
+namespace {
+
+constexpr uint32_t SNAPSHOT_MAGIC = 0x53335350; // "PS3S"
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+struct SnapshotHeader {
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t real_size = 0;
+	uint32_t body_count = 0;
+	uint32_t pair_count = 0;
+	uint32_t checksum = 0; // Of the records after the header.
+};
+
+struct SnapshotBody {
+	uint64_t sequence = 0;
+	GodotBody3D::SnapshotState state;
+};
+
+struct SnapshotPair {
+	uint64_t sequence_A = 0;
+	uint64_t sequence_B = 0;
+	int32_t shape_A = 0;
+	int32_t shape_B = 0;
+	GodotBodyPair3D::SnapshotState state;
+};
+
+} // namespace
+
+Vector<uint8_t> GodotSpace3D::save_state() {
+	ERR_FAIL_COND_V_MSG(locked, Vector<uint8_t>(), "Space state can't be saved while the space is being stepped.");
+
+	const LocalVector<GodotBody3D *> &bodies = get_sorted_bodies();
+
+	// Pairs are sorted by key, so that the same world always gives the same bytes.
+	struct SortedPair {
+		PairKey key;
+		const GodotBodyPair3D *pair = nullptr;
+
+		bool operator<(const SortedPair &p_other) const {
+			if (key.sequence_A != p_other.key.sequence_A) {
+				return key.sequence_A < p_other.key.sequence_A;
+			}
+			if (key.sequence_B != p_other.key.sequence_B) {
+				return key.sequence_B < p_other.key.sequence_B;
+			}
+			if (key.shape_A != p_other.key.shape_A) {
+				return key.shape_A < p_other.key.shape_A;
+			}
+			return key.shape_B < p_other.key.shape_B;
+		}
+	};
+
+	LocalVector<SortedPair> pairs;
+	for (const SelfList<GodotBodyPair3D> *E = body_pair_list.first(); E; E = E->next()) {
+		SortedPair sorted_pair;
+		sorted_pair.key = _get_pair_key(E->self());
+		sorted_pair.pair = E->self();
+		pairs.push_back(sorted_pair);
+	}
+	pairs.sort();
+
+	Vector<uint8_t> data;
+	data.resize(sizeof(SnapshotHeader) + bodies.size() * sizeof(SnapshotBody) + pairs.size() * sizeof(SnapshotPair));
+	uint8_t *w = data.ptrw();
+
+	// The header is written last, once the checksum of the records is known.
+	w += sizeof(SnapshotHeader);
+
+	// Records are built in zeroed memory, so that padding bytes don't leak into the snapshot.
+	SnapshotBody body_record;
+	for (const GodotBody3D *body : bodies) {
+		memset((void *)&body_record, 0, sizeof(SnapshotBody));
+		body_record.sequence = body->get_sequence();
+		body->save_snapshot_state(body_record.state);
+		memcpy(w, &body_record, sizeof(SnapshotBody));
+		w += sizeof(SnapshotBody);
+	}
+
+	SnapshotPair pair_record;
+	for (const SortedPair &sorted_pair : pairs) {
+		memset((void *)&pair_record, 0, sizeof(SnapshotPair));
+		pair_record.sequence_A = sorted_pair.key.sequence_A;
+		pair_record.sequence_B = sorted_pair.key.sequence_B;
+		pair_record.shape_A = sorted_pair.key.shape_A;
+		pair_record.shape_B = sorted_pair.key.shape_B;
+		sorted_pair.pair->save_snapshot_state(pair_record.state);
+		memcpy(w, &pair_record, sizeof(SnapshotPair));
+		w += sizeof(SnapshotPair);
+	}
+
+	SnapshotHeader header;
+	memset((void *)&header, 0, sizeof(SnapshotHeader));
+	header.magic = SNAPSHOT_MAGIC;
+	header.version = SNAPSHOT_VERSION;
+	header.real_size = sizeof(real_t);
+	header.body_count = bodies.size();
+	header.pair_count = pairs.size();
+	header.checksum = hash_murmur3_buffer(data.ptr() + sizeof(SnapshotHeader), data.size() - sizeof(SnapshotHeader));
+	memcpy(data.ptrw(), &header, sizeof(SnapshotHeader));
+
+	return data;
+}
+
+bool GodotSpace3D::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_V_MSG(locked, false, "Space state can't be restored while the space is being stepped.");
+	ERR_FAIL_COND_V(p_state.size() < (int64_t)sizeof(SnapshotHeader), false);
+
+	const uint8_t *r = p_state.ptr();
+
+	SnapshotHeader header;
+	memcpy(&header, r, sizeof(SnapshotHeader));
+	ERR_FAIL_COND_V_MSG(header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION, false, "Invalid space state.");
+	ERR_FAIL_COND_V_MSG(header.real_size != sizeof(real_t), false, "Space state was saved with a different floating-point precision.");
+	ERR_FAIL_COND_V(uint64_t(p_state.size()) != sizeof(SnapshotHeader) + uint64_t(header.body_count) * sizeof(SnapshotBody) + uint64_t(header.pair_count) * sizeof(SnapshotPair), false);
+	ERR_FAIL_COND_V_MSG(header.checksum != hash_murmur3_buffer(r + sizeof(SnapshotHeader), p_state.size() - sizeof(SnapshotHeader)), false, "Space state is corrupted.");
+	r += sizeof(SnapshotHeader);
+
+	// Both the records and the bodies are sorted by sequence. They're checked before anything is restored,
+	// so that a state saved with other bodies leaves the space untouched.
+	const LocalVector<GodotBody3D *> &bodies = get_sorted_bodies();
+	ERR_FAIL_COND_V_MSG(header.body_count != bodies.size(), false, "Space state doesn't match the bodies of the space.");
+	SnapshotBody body_record;
+	for (uint32_t i = 0; i < header.body_count; i++) {
+		memcpy(&body_record, r + i * sizeof(SnapshotBody), sizeof(SnapshotBody));
+		ERR_FAIL_COND_V_MSG(bodies[i]->get_sequence() != body_record.sequence, false, "Space state doesn't match the bodies of the space.");
+	}
+
+	for (uint32_t i = 0; i < header.body_count; i++) {
+		memcpy(&body_record, r, sizeof(SnapshotBody));
+		r += sizeof(SnapshotBody);
+		bodies[i]->restore_snapshot_state(body_record.state);
+	}
+
+	// Pairs the broadphase still has get their contacts back right away, the others once they're created again.
+	pending_pair_states.clear();
+	pending_pair_state_data = p_state;
+
+	PairKey key;
+	SnapshotPair pair_record;
+	for (uint32_t i = 0; i < header.pair_count; i++) {
+		const uint32_t offset = r - p_state.ptr();
+		memcpy(&pair_record, r, sizeof(SnapshotPair));
+		r += sizeof(SnapshotPair);
+
+		key.sequence_A = pair_record.sequence_A;
+		key.sequence_B = pair_record.sequence_B;
+		key.shape_A = pair_record.shape_A;
+		key.shape_B = pair_record.shape_B;
+		pending_pair_states.insert(key, offset + offsetof(SnapshotPair, state));
+	}
+
+	for (SelfList<GodotBodyPair3D> *E = body_pair_list.first(); E; E = E->next()) {
+		GodotBodyPair3D *pair = E->self();
+		HashMap<PairKey, uint32_t, PairKeyHasher>::Iterator F = pending_pair_states.find(_get_pair_key(pair));
+		if (F) {
+			GodotBodyPair3D::SnapshotState state;
+			memcpy(&state, pending_pair_state_data.ptr() + F->value, sizeof(GodotBodyPair3D::SnapshotState));
+			pair->restore_snapshot_state(state);
+			pending_pair_states.remove(F);
+		} else {
+			pair->clear_contacts();
+		}
+	}
+
+	if (pending_pair_states.is_empty()) {
+		pending_pair_state_data.clear();
+	}
+
+	return true;
+}
+
 void GodotSpace3D::call_queries() {
 	while (state_query_list.first()) {
 		GodotBody3D *b = state_query_list.first()->self();
@@ -1186,7 +1590,12 @@ void GodotSpace3D::setup() {
 }
 
 void GodotSpace3D::update() {
+	GodotProfileZone("GodotSpace3D::update");
 	broadphase->update();
+
+	// Pairs from a restored snapshot that weren't created again are out of contact now.
+	pending_pair_states.clear();
+	pending_pair_state_data.clear();
 }
 
 void GodotSpace3D::set_param(PS3DE::SpaceParameter p_param, real_t p_value) {
@@ -36,12 +36,26 @@
 #include "godot_collision_object_3d.h"
 #include "godot_soft_body_3d.h"
 
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "core/typedefs.h"
 #include "servers/physics_3d/direct_states/physics_direct_space_state_3d.h"
 
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	struct QueryBatch;
+
+	// Query implementations culling into the given buffers, so that batches can run them from several threads.
+	int _intersect_point(const PS3DT::PointParameters &p_parameters, const Vector3 &p_position, PS3DT::ShapeResult *r_results, int p_result_max, GodotCollisionObject3D **r_cull_results, int *r_cull_subindex_results);
+	bool _intersect_ray(const PS3DT::RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, PS3DT::RayResult &r_result, GodotCollisionObject3D **r_cull_results, int *r_cull_subindex_results);
+	bool _cast_motion(const PS3DT::ShapeParameters &p_parameters, GodotShape3D *p_shape, const Transform3D &p_transform, const Vector3 &p_motion, real_t &p_closest_safe, real_t &p_closest_unsafe, PS3DT::ShapeRestInfo *r_info, GodotCollisionObject3D **r_cull_results, int *r_cull_subindex_results);
+
+	bool _run_query(QueryBatch &p_batch, uint32_t p_index, GodotCollisionObject3D **r_cull_results, int *r_cull_subindex_results);
+	void _run_query_batch_chunk(uint32_t p_chunk_index, QueryBatch *p_batch);
+	int _run_query_batch(QueryBatch &p_batch, int p_count);
+
 public:
 	GodotSpace3D *space = nullptr;
 
@@ -53,9 +67,15 @@ public:
 	virtual bool rest_info(const PS3DT::ShapeParameters &p_parameters, PS3DT::ShapeRestInfo *r_info) override;
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const override;
 
+	virtual int intersect_rays(const PS3DT::RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, PS3DT::RayResult *r_results) override;
+	virtual int intersect_points(const PS3DT::PointParameters &p_parameters, const Vector3 *p_positions, int p_count, PS3DT::ShapeResult *r_results) override;
+	virtual bool cast_motions(const PS3DT::ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) override;
+
 	GodotPhysicsDirectSpaceState3D();
 };
 
+class GodotBodyPair3D;
+
 class GodotSpace3D {
 public:
 	enum ElapsedTime {
@@ -81,12 +101,45 @@ private:
 	SelfList<GodotArea3D>::List monitor_query_list;
 	SelfList<GodotArea3D>::List area_moved_list;
 	SelfList<GodotSoftBody3D>::List active_soft_body_list;
+	SelfList<GodotBodyPair3D>::List body_pair_list;
 
 	static void *_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_self);
 	static void _broadphase_unpair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_data, void *p_self);
 
 	HashSet<GodotCollisionObject3D *> objects;
 
+	// Bodies in the order they were added to the space, which is how space snapshots store them.
+	LocalVector<GodotBody3D *> sorted_bodies;
+	bool sorted_bodies_dirty = true;
+	uint64_t next_object_sequence = 1;
+
+	struct PairKey {
+		uint64_t sequence_A = 0;
+		uint64_t sequence_B = 0;
+		int32_t shape_A = 0;
+		int32_t shape_B = 0;
+
+		bool operator==(const PairKey &p_key) const { return sequence_A == p_key.sequence_A && sequence_B == p_key.sequence_B && shape_A == p_key.shape_A && shape_B == p_key.shape_B; }
+	};
+
+	struct PairKeyHasher {
+		static _FORCE_INLINE_ uint32_t hash(const PairKey &p_key) {
+			uint32_t h = hash_murmur3_one_64(p_key.sequence_A);
+			h = hash_murmur3_one_64(p_key.sequence_B, h);
+			h = hash_murmur3_one_32(p_key.shape_A, h);
+			h = hash_murmur3_one_32(p_key.shape_B, h);
+			return hash_fmix32(h);
+		}
+	};
+
+	// Contact caches from a restored snapshot for pairs the broadphase hasn't created yet,
+	// as offsets of their records in the snapshot.
+	HashMap<PairKey, uint32_t, PairKeyHasher> pending_pair_states;
+	Vector<uint8_t> pending_pair_state_data;
+
+	static PairKey _get_pair_key(const GodotBodyPair3D *p_pair);
+	void _update_sorted_bodies();
+
 	GodotArea3D *area = nullptr;
 
 	int solver_iterations = 0;
@@ -114,6 +167,12 @@ private:
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	int pairs_added = 0;
+	int pairs_removed = 0;
+	uint64_t slowest_island_time = 0;
+	// Direct space state queries can run from any thread.
+	SafeNumeric<uint32_t> query_count;
+	int reused_manifold_count = 0;
 
 	RID static_global_body;
 
@@ -150,12 +209,20 @@ public:
 	void soft_body_add_to_active_list(SelfList<GodotSoftBody3D> *p_soft_body);
 	void soft_body_remove_from_active_list(SelfList<GodotSoftBody3D> *p_soft_body);
 
+	void body_pair_add_to_list(SelfList<GodotBodyPair3D> *p_pair);
+	const SelfList<GodotBodyPair3D>::List &get_body_pair_list() const { return body_pair_list; }
+
 	GodotBroadPhase3D *get_broadphase();
 
 	void add_object(GodotCollisionObject3D *p_object);
 	void remove_object(GodotCollisionObject3D *p_object);
 	const HashSet<GodotCollisionObject3D *> &get_objects() const;
 
+	const LocalVector<GodotBody3D *> &get_sorted_bodies();
+
+	Vector<uint8_t> save_state();
+	bool restore_state(const Vector<uint8_t> &p_state);
+
 	_FORCE_INLINE_ int get_solver_iterations() const { return solver_iterations; }
 	_FORCE_INLINE_ real_t get_contact_recycle_radius() const { return contact_recycle_radius; }
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
@@ -186,6 +253,29 @@ public:
 	int get_active_objects() const { return active_objects; }
 
 	int get_collision_pairs() const { return collision_pairs; }
+	int get_contact_count() const;
+	int get_sleeping_objects() const;
+
+	// Broadphase pairs created and removed since the start of the step.
+	void reset_pair_churn() {
+		pairs_added = 0;
+		pairs_removed = 0;
+	}
+	int get_pairs_added() const { return pairs_added; }
+	int get_pairs_removed() const { return pairs_removed; }
+
+	// Body pairs that kept their contacts from the previous step instead of running narrowphase.
+	// Counted while pre-solving, which isn't threaded.
+	void reset_reused_manifold_count() { reused_manifold_count = 0; }
+	_FORCE_INLINE_ void add_reused_manifold() { reused_manifold_count++; }
+	int get_reused_manifold_count() const { return reused_manifold_count; }
+
+	void set_slowest_island_time(uint64_t p_usec) { slowest_island_time = p_usec; }
+	uint64_t get_slowest_island_time() const { return slowest_island_time; }
+
+	_FORCE_INLINE_ void add_query_count(uint32_t p_count) { query_count.add(p_count); }
+	// Returns the number of queries made since the last call.
+	uint32_t take_query_count();
 
 	GodotPhysicsDirectSpaceState3D *get_direct_state();
 
@@ -34,12 +34,16 @@
 
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/profiling/profiling.h"
 
 #define BODY_ISLAND_COUNT_RESERVE 128
 #define BODY_ISLAND_SIZE_RESERVE 512
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+// Islands with at least this many constraints are solved with graph coloring, when there are worker threads.
+#define COLORED_ISLAND_MIN_CONSTRAINTS 512
+#define COLOR_BATCH_CHUNK_SIZE 32
 
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -112,6 +116,22 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
+void GodotStep3D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
+void GodotStep3D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
+void GodotStep3D::_predict_soft_body_motion(uint32_t p_soft_body_index, void *p_userdata) {
+	active_soft_bodies[p_soft_body_index]->predict_motion(delta);
+}
+
+void GodotStep3D::_solve_soft_body_constraints(uint32_t p_soft_body_index, void *p_userdata) {
+	solving_soft_bodies[p_soft_body_index]->solve_constraints(delta);
+}
+
 void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -131,6 +151,13 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 }
 
 void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
+	if (colored_islands[p_island_index]) {
+		return; // Solved afterwards, see _solve_colored_island().
+	}
+
+	GodotProfileZone("GodotStep3D::_solve_island");
+	const uint64_t begin_time = OS::get_singleton()->get_ticks_usec();
+
 	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
 
 	int current_priority = 1;
@@ -156,6 +183,134 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 		}
 		constraint_count = priority_constraint_count;
 	}
+
+	island_solve_times[p_island_index] = OS::get_singleton()->get_ticks_usec() - begin_time;
+}
+
+bool GodotStep3D::_can_color_island(const LocalVector<GodotConstraint3D *> &p_constraint_island) const {
+	// Not depending on the thread count, so large islands are solved in the same order on any machine.
+	if (p_constraint_island.size() < COLORED_ISLAND_MIN_CONSTRAINTS) {
+		return false;
+	}
+	for (const GodotConstraint3D *constraint : p_constraint_island) {
+		if (constraint->get_soft_body_count() > 0) {
+			return false; // Soft body constraints change many nodes, keep them serial.
+		}
+	}
+	return true;
+}
+
+void GodotStep3D::color_constraints(const LocalVector<GodotConstraint3D *> &p_constraint_island, LocalVector<LocalVector<GodotConstraint3D *>> &r_batches, LocalVector<GodotConstraint3D *> &r_uncolored, HashMap<const GodotBody3D *, uint64_t> &r_body_color_masks) {
+	for (LocalVector<GodotConstraint3D *> &batch : r_batches) {
+		batch.clear();
+	}
+	r_uncolored.clear();
+	r_body_color_masks.clear();
+
+	// Greedy coloring in island order, so the batches only depend on the island.
+	// Static and kinematic bodies are only read while solving, so only rigid bodies conflict.
+	for (GodotConstraint3D *constraint : p_constraint_island) {
+		GodotBody3D **bodies = constraint->get_body_ptr();
+		const int body_count = constraint->get_body_count();
+
+		uint64_t used_colors = 0;
+		for (int i = 0; i < body_count; i++) {
+			if (bodies[i]->get_mode() > PS3DE::BODY_MODE_KINEMATIC) {
+				const uint64_t *mask = r_body_color_masks.getptr(bodies[i]);
+				if (mask) {
+					used_colors |= *mask;
+				}
+			}
+		}
+
+		if (used_colors == UINT64_MAX) {
+			// Out of colors, solved serially after the batches.
+			r_uncolored.push_back(constraint);
+			continue;
+		}
+
+		uint32_t color = 0;
+		while (used_colors & (uint64_t(1) << color)) {
+			color++;
+		}
+		if (r_batches.size() <= color) {
+			r_batches.resize(color + 1);
+		}
+		r_batches[color].push_back(constraint);
+
+		for (int i = 0; i < body_count; i++) {
+			if (bodies[i]->get_mode() > PS3DE::BODY_MODE_KINEMATIC) {
+				uint64_t *mask = r_body_color_masks.getptr(bodies[i]);
+				if (mask) {
+					*mask |= uint64_t(1) << color;
+				} else {
+					r_body_color_masks.insert(bodies[i], uint64_t(1) << color);
+				}
+			}
+		}
+	}
+}
+
+void GodotStep3D::_solve_batch_chunk(uint32_t p_chunk_index, void *p_userdata) {
+	const uint32_t begin = p_chunk_index * COLOR_BATCH_CHUNK_SIZE;
+	const uint32_t end = MIN(begin + COLOR_BATCH_CHUNK_SIZE, solving_batch->size());
+	for (uint32_t constraint_index = begin; constraint_index < end; ++constraint_index) {
+		(*solving_batch)[constraint_index]->solve(delta);
+	}
+}
+
+void GodotStep3D::_solve_colored_island(LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	color_constraints(p_constraint_island, color_batches, uncolored_constraints, body_color_masks);
+
+	// Same as _solve_island(), with each iteration going through the batches in order.
+	// Constraints within a batch don't share rigid bodies, so the result doesn't depend on how the batch is split.
+	const bool use_threads = WorkerThreadPool::get_singleton()->get_thread_count() > 1;
+	int current_priority = 1;
+
+	uint32_t constraint_count = p_constraint_island.size();
+	while (constraint_count > 0) {
+		for (int i = 0; i < iterations; i++) {
+			for (const LocalVector<GodotConstraint3D *> &batch : color_batches) {
+				if (!use_threads || batch.size() <= COLOR_BATCH_CHUNK_SIZE) {
+					for (GodotConstraint3D *constraint : batch) {
+						constraint->solve(delta);
+					}
+					continue;
+				}
+				solving_batch = &batch;
+				const uint32_t chunk_count = (batch.size() + COLOR_BATCH_CHUNK_SIZE - 1) / COLOR_BATCH_CHUNK_SIZE;
+				WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_batch_chunk, nullptr, chunk_count, -1, true, SNAME("Physics3DConstraintSolveBatch"));
+				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			}
+			for (GodotConstraint3D *constraint : uncolored_constraints) {
+				constraint->solve(delta);
+			}
+		}
+
+		// Check priority to keep only higher priority constraints.
+		++current_priority;
+		constraint_count = 0;
+		for (LocalVector<GodotConstraint3D *> &batch : color_batches) {
+			uint32_t priority_constraint_count = 0;
+			for (GodotConstraint3D *constraint : batch) {
+				if (constraint->get_priority() >= current_priority) {
+					// Keep this constraint for the next iteration.
+					batch[priority_constraint_count++] = constraint;
+				}
+			}
+			batch.resize(priority_constraint_count);
+			constraint_count += priority_constraint_count;
+		}
+		uint32_t priority_constraint_count = 0;
+		for (GodotConstraint3D *constraint : uncolored_constraints) {
+			if (constraint->get_priority() >= current_priority) {
+				uncolored_constraints[priority_constraint_count++] = constraint;
+			}
+		}
+		uncolored_constraints.resize(priority_constraint_count);
+		constraint_count += priority_constraint_count;
+	}
+	solving_batch = nullptr;
 }
 
 void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
@@ -183,8 +338,14 @@ void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island
 }
 
 void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
+	GodotProfileZone("GodotStep3D::step");
+	GodotProfileZoneGroupedFirst(_profile_zone, "integrate_forces");
+
 	p_space->lock(); // can't access space during this
 
+	p_space->reset_pair_churn();
+	p_space->reset_reused_manifold_count();
+
 	p_space->setup(); //update inertias, etc
 
 	p_space->set_last_step(p_delta);
@@ -201,22 +362,40 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
-
+	// Bodies are integrated in parallel, then update the space serially in list order, so the result stays deterministic.
+	active_bodies.clear();
 	const SelfList<GodotBody3D> *b = body_list->first();
 	while (b) {
-		b->self()->integrate_forces(p_delta);
+		active_bodies.push_back(b->self());
 		b = b->next();
-		active_count++;
+	}
+	int active_count = active_bodies.size();
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_forces, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateForces"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (GodotBody3D *body : active_bodies) {
+		body->update_space_after_integrate_forces();
 	}
 
 	/* UPDATE SOFT BODY MOTION */
 
+	// Soft bodies only touch their own nodes while predicting, updating their shape in the space is done serially.
+	active_soft_bodies.clear();
 	const SelfList<GodotSoftBody3D> *sb = soft_body_list->first();
 	while (sb) {
-		sb->self()->predict_motion(p_delta);
+		active_soft_bodies.push_back(sb->self());
 		sb = sb->next();
-		active_count++;
+	}
+	active_count += active_soft_bodies.size();
+
+	if (active_soft_bodies.size()) {
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_predict_soft_body_motion, nullptr, active_soft_bodies.size(), -1, true, SNAME("Physics3DPredictSoftBodyMotion"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (GodotSoftBody3D *soft_body : active_soft_bodies) {
+			soft_body->update_bounds();
+		}
 	}
 
 	p_space->set_active_objects(active_count);
@@ -230,6 +409,8 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
+	GodotProfileZoneGrouped(_profile_zone, "generate_islands");
+
 	/* GENERATE CONSTRAINT ISLANDS FOR MOVING AREAS */
 
 	uint32_t island_count = 0;
@@ -341,10 +522,12 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
+	GodotProfileZoneGrouped(_profile_zone, "setup_constraints");
+
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -353,11 +536,16 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
+	GodotProfileZoneGrouped(_profile_zone, "solve_constraints");
+
 	/* PRE-SOLVE CONSTRAINT ISLANDS */
 
 	// WARNING: This doesn't run on threads, because it involves thread-unsafe processing.
+	colored_islands.resize(island_count);
+	island_solve_times.resize(island_count);
 	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
 		_pre_solve_island(constraint_islands[island_index]);
+		colored_islands[island_index] = _can_color_island(constraint_islands[island_index]);
 	}
 
 	/* SOLVE CONSTRAINT ISLANDS */
@@ -367,19 +555,41 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
+	uint64_t slowest_island_time = 0;
+	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+		if (colored_islands[island_index]) {
+			const uint64_t begin_time = OS::get_singleton()->get_ticks_usec();
+			_solve_colored_island(constraint_islands[island_index]);
+			island_solve_times[island_index] = OS::get_singleton()->get_ticks_usec() - begin_time;
+		}
+		slowest_island_time = MAX(slowest_island_time, island_solve_times[island_index]);
+	}
+	p_space->set_slowest_island_time(slowest_island_time);
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
 		profile_begtime = profile_endtime;
 	}
 
+	GodotProfileZoneGrouped(_profile_zone, "integrate_velocities");
+
 	/* INTEGRATE VELOCITIES */
 
+	// Bodies woken up by contacts are integrated too.
+	active_bodies.clear();
 	b = body_list->first();
 	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
+
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_velocities, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateVelocities"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Deactivating bodies removes them from the active list, so it's done from the array.
+	for (GodotBody3D *body : active_bodies) {
+		body->update_space_after_integrate_velocities();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
@@ -390,10 +600,19 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* UPDATE SOFT BODY CONSTRAINTS */
 
-	sb = soft_body_list->first();
-	while (sb) {
-		sb->self()->solve_constraints(p_delta);
-		sb = sb->next();
+	// Large soft bodies solve their links in parallel on their own, the others are solved in parallel with each other.
+	solving_soft_bodies.clear();
+	for (GodotSoftBody3D *soft_body : active_soft_bodies) {
+		if (soft_body->is_solved_in_parallel()) {
+			soft_body->solve_constraints(p_delta);
+		} else {
+			solving_soft_bodies.push_back(soft_body);
+		}
+	}
+
+	if (solving_soft_bodies.size()) {
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_soft_body_constraints, nullptr, solving_soft_bodies.size(), -1, true, SNAME("Physics3DSolveSoftBodyConstraints"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 	}
 
 	{ //profile
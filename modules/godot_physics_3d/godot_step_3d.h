@@ -32,6 +32,7 @@
 
 #include "godot_space_3d.h"
 
+#include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
 
 class GodotStep3D {
@@ -43,15 +44,39 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotBody3D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
+	LocalVector<GodotBody3D *> active_bodies;
+	LocalVector<GodotSoftBody3D *> active_soft_bodies;
+	LocalVector<GodotSoftBody3D *> solving_soft_bodies;
+
+	// Large islands are solved one at a time, with their constraints split by graph coloring into batches
+	// that don't share any rigid body, so each batch can be solved in parallel.
+	LocalVector<bool> colored_islands;
+	// Time spent solving each island in the current step, in microseconds.
+	LocalVector<uint64_t> island_solve_times;
+	LocalVector<LocalVector<GodotConstraint3D *>> color_batches;
+	LocalVector<GodotConstraint3D *> uncolored_constraints;
+	HashMap<const GodotBody3D *, uint64_t> body_color_masks;
+	const LocalVector<GodotConstraint3D *> *solving_batch = nullptr;
 
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _integrate_forces(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _integrate_velocities(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _predict_soft_body_motion(uint32_t p_soft_body_index, void *p_userdata = nullptr);
+	void _solve_soft_body_constraints(uint32_t p_soft_body_index, void *p_userdata = nullptr);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	bool _can_color_island(const LocalVector<GodotConstraint3D *> &p_constraint_island) const;
+	void _solve_colored_island(LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _solve_batch_chunk(uint32_t p_chunk_index, void *p_userdata = nullptr);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
+	// Splits the constraints into batches that don't share any rigid body, greedily in island order.
+	// Constraints that would need more than 64 batches are put in r_uncolored, to be solved after the batches.
+	static void color_constraints(const LocalVector<GodotConstraint3D *> &p_constraint_island, LocalVector<LocalVector<GodotConstraint3D *>> &r_batches, LocalVector<GodotConstraint3D *> &r_uncolored, HashMap<const GodotBody3D *, uint64_t> &r_body_color_masks);
+
 	void step(GodotSpace3D *p_space, real_t p_delta);
 	GodotStep3D();
 	~GodotStep3D();
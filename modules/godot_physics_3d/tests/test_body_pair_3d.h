@@ -0,0 +1,226 @@
+/**************************************************************************/
+/*  test_body_pair_3d.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_body_3d.h"
+#include "../godot_body_direct_state_3d.h"
+#include "../godot_space_3d.h"
+
+#include "servers/physics_3d/physics_server_3d.h"
+#include "tests/physics_test_space_3d.h"
+#include "tests/test_macros.h"
+
+namespace TestBodyPair3D {
+
+// Outcomes of the contact solver that follow from the physics rather than from its implementation,
+// so they hold for any arrangement of the solver's data.
+
+using TestUtils::PhysicsTestSpace3D;
+
+// Gravity along -Y and no damping, over a ground whose top is at y = 0.5.
+static RID add_ground(PhysicsTestSpace3D &r_world, real_t p_gravity) {
+	PhysicsServer3D *ps = r_world.ps;
+	ps->area_set_param(r_world.space, PS3DE::AREA_PARAM_GRAVITY, p_gravity);
+	ps->area_set_param(r_world.space, PS3DE::AREA_PARAM_GRAVITY_VECTOR, Vector3(0, -1, 0));
+	ps->area_set_param(r_world.space, PS3DE::AREA_PARAM_LINEAR_DAMP, 0.0);
+	ps->area_set_param(r_world.space, PS3DE::AREA_PARAM_ANGULAR_DAMP, 0.0);
+	return r_world.add_static_body(r_world.create_box_shape(Vector3(20, 0.5, 20)), Vector3());
+}
+
+static Transform3D get_transform(RID p_body) {
+	return PhysicsServer3D::get_singleton()->body_get_state(p_body, PS3DE::BODY_STATE_TRANSFORM);
+}
+
+static Vector3 get_linear_velocity(RID p_body) {
+	return PhysicsServer3D::get_singleton()->body_get_state(p_body, PS3DE::BODY_STATE_LINEAR_VELOCITY);
+}
+
+static Vector3 get_angular_velocity(RID p_body) {
+	return PhysicsServer3D::get_singleton()->body_get_state(p_body, PS3DE::BODY_STATE_ANGULAR_VELOCITY);
+}
+
+// Body pairs in the body's space that kept their contacts during the last step.
+static int get_reused_manifold_count(RID p_body) {
+	GodotPhysicsDirectBodyState3D *state = Object::cast_to<GodotPhysicsDirectBodyState3D>(PhysicsServer3D::get_singleton()->body_get_direct_state(p_body));
+	REQUIRE(state != nullptr);
+	return state->body->get_space()->get_reused_manifold_count();
+}
+
+static bool is_upright(const Transform3D &p_transform) {
+	return p_transform.basis.get_column(1).dot(Vector3(0, 1, 0)) > 0.999;
+}
+
+TEST_CASE("[SceneTree][Physics3D] Contact solver settles a stack of boxes") {
+	PhysicsTestSpace3D world;
+	add_ground(world, 9.8);
+	const RID box_shape = world.create_box_shape(Vector3(0.5, 0.5, 0.5));
+	RID boxes[3];
+	for (int i = 0; i < 3; i++) {
+		boxes[i] = world.add_body(box_shape, Vector3(0, 1.05 + i * 1.05, 0));
+	}
+
+	world.step(180);
+
+	for (int i = 0; i < 3; i++) {
+		const Transform3D transform = get_transform(boxes[i]);
+		CHECK_MESSAGE(transform.origin.y == doctest::Approx(1.0 + i).epsilon(0.02), vformat("Box %d should rest on the one below.", i));
+		CHECK(Vector2(transform.origin.x, transform.origin.z).length() < 0.02);
+		CHECK(is_upright(transform));
+		CHECK(get_linear_velocity(boxes[i]).length() < 0.05);
+		CHECK(get_angular_velocity(boxes[i]).length() < 0.05);
+	}
+}
+
+TEST_CASE("[SceneTree][Physics3D] Contact solver applies Coulomb friction to a sliding box") {
+	const real_t gravity = 9.8;
+	const real_t friction = 0.5;
+	const real_t speed = 4.0;
+
+	PhysicsTestSpace3D world;
+	PhysicsServer3D *ps = world.ps;
+	RID ground = add_ground(world, gravity);
+	ps->body_set_param(ground, PS3DE::BODY_PARAM_FRICTION, friction);
+	RID box = world.add_body(world.create_box_shape(Vector3(0.5, 0.5, 0.5)), Vector3(0, 1.0, 0));
+	ps->body_set_param(box, PS3DE::BODY_PARAM_FRICTION, friction);
+
+	// Let the contacts settle before pushing the box.
+	world.step(10);
+	const real_t start_x = get_transform(box).origin.x;
+	ps->body_set_state(box, PS3DE::BODY_STATE_LINEAR_VELOCITY, Vector3(speed, 0, 0));
+
+	// Friction decelerates the box by friction * gravity until it stops.
+	const real_t deceleration = friction * gravity;
+	world.step(30);
+	CHECK(get_linear_velocity(box).x == doctest::Approx(speed - deceleration * 0.5).epsilon(0.1));
+
+	world.step(90);
+	const Transform3D transform = get_transform(box);
+	CHECK(get_linear_velocity(box).length() < 0.05);
+	CHECK(transform.origin.x - start_x == doctest::Approx(speed * speed / (2 * deceleration)).epsilon(0.1));
+	CHECK(transform.origin.y == doctest::Approx(1.0).epsilon(0.02));
+	CHECK(Math::abs(transform.origin.z) < 0.01);
+	CHECK(is_upright(transform));
+}
+
+TEST_CASE("[SceneTree][Physics3D] Contact solver keeps momentum in an elastic head-on collision") {
+	PhysicsTestSpace3D world;
+	PhysicsServer3D *ps = world.ps;
+	add_ground(world, 0.0);
+	const RID sphere_shape = world.create_sphere_shape(0.5);
+	RID left = world.add_body(sphere_shape, Vector3(-2, 5, 0));
+	RID right = world.add_body(sphere_shape, Vector3(2, 5, 0));
+	ps->body_set_param(left, PS3DE::BODY_PARAM_BOUNCE, 0.5); // Combined into a restitution of 1.
+	ps->body_set_param(right, PS3DE::BODY_PARAM_BOUNCE, 0.5);
+	ps->body_set_state(left, PS3DE::BODY_STATE_LINEAR_VELOCITY, Vector3(3, 0, 0));
+	ps->body_set_state(right, PS3DE::BODY_STATE_LINEAR_VELOCITY, Vector3(-3, 0, 0));
+
+	world.step(60);
+
+	const Vector3 left_velocity = get_linear_velocity(left);
+	const Vector3 right_velocity = get_linear_velocity(right);
+	CHECK(left_velocity.x == doctest::Approx(-3.0).epsilon(0.05));
+	CHECK(right_velocity.x == doctest::Approx(3.0).epsilon(0.05));
+	CHECK((left_velocity + right_velocity).length() < 0.001);
+	CHECK(get_angular_velocity(left).length() < 0.001);
+	CHECK(get_angular_velocity(right).length() < 0.001);
+	CHECK(get_transform(left).origin.x < -1.0);
+	CHECK(get_transform(right).origin.x > 1.0);
+}
+
+TEST_CASE("[SceneTree][Physics3D] Contact solver reuses the contacts of resting bodies") {
+	PhysicsTestSpace3D world;
+	PhysicsServer3D *ps = world.ps;
+	add_ground(world, 9.8);
+	const RID box_shape = world.create_box_shape(Vector3(0.5, 0.5, 0.5));
+	RID bottom = world.add_body(box_shape, Vector3(0, 1.0, 0));
+	RID top = world.add_body(box_shape, Vector3(0, 2.0, 0));
+	for (const RID &box : { bottom, top }) {
+		ps->body_set_state(box, PS3DE::BODY_STATE_CAN_SLEEP, false);
+		ps->body_set_max_contacts_reported(box, 8);
+	}
+
+	// Let the stack come to rest so both pairs have cached contacts.
+	world.step(120);
+
+	for (int i = 0; i < 30; i++) {
+		world.step(1);
+		CHECK_MESSAGE(get_reused_manifold_count(bottom) == 2, vformat("Both pairs should keep their contacts in step %d.", i));
+	}
+	CHECK(ps->body_get_direct_state(bottom)->get_contact_count() > 0);
+	CHECK(ps->body_get_direct_state(top)->get_contact_count() > 0);
+	const Transform3D resting_transform = get_transform(top);
+	CHECK(resting_transform.origin.y == doctest::Approx(2.0).epsilon(0.02));
+
+	SUBCASE("Changing a shape recomputes the contacts of its bodies") {
+		// Setting the same extents still counts as a change, the shape is configured again.
+		ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+		world.step(1);
+		CHECK(get_reused_manifold_count(bottom) == 0);
+		world.step(1);
+		CHECK(get_reused_manifold_count(bottom) == 2);
+	}
+
+	SUBCASE("Moving a body past the reuse distance recomputes its contacts") {
+		// A tenth of the default contact recycle radius of 0.01.
+		Transform3D moved = resting_transform;
+		moved.origin.x += 0.005;
+		ps->body_set_state(top, PS3DE::BODY_STATE_TRANSFORM, moved);
+		world.step(1);
+		CHECK_MESSAGE(get_reused_manifold_count(bottom) == 1, "Only the pair of the moved box should be recomputed.");
+		world.step(1);
+		CHECK(get_reused_manifold_count(bottom) == 2);
+	}
+
+	SUBCASE("Moving a body within the reuse distance keeps its contacts") {
+		Transform3D moved = resting_transform;
+		moved.origin.x += 0.0001;
+		ps->body_set_state(top, PS3DE::BODY_STATE_TRANSFORM, moved);
+		world.step(1);
+		CHECK(get_reused_manifold_count(bottom) == 2);
+	}
+
+	SUBCASE("Rotating a body past the reuse threshold recomputes its contacts") {
+		Transform3D rotated = resting_transform;
+		rotated.basis = Basis(Vector3(0, 1, 0), 0.01) * rotated.basis;
+		ps->body_set_state(top, PS3DE::BODY_STATE_TRANSFORM, rotated);
+		world.step(1);
+		CHECK(get_reused_manifold_count(bottom) == 1);
+		world.step(1);
+		CHECK(get_reused_manifold_count(bottom) == 2);
+	}
+
+	// The recomputed contacts still hold the stack.
+	world.step(60);
+	CHECK(get_transform(top).origin.y == doctest::Approx(2.0).epsilon(0.02));
+	CHECK(is_upright(get_transform(top)));
+}
+
+} // namespace TestBodyPair3D
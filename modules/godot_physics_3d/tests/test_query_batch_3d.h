@@ -0,0 +1,158 @@
+/**************************************************************************/
+/*  test_query_batch_3d.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/random_pcg.h"
+#include "servers/physics_3d/physics_server_3d.h"
+#include "servers/physics_3d/queries/physics_ray_query_parameters_3d.h"
+#include "tests/physics_test_space_3d.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestQueryBatch3D {
+
+using TestUtils::PhysicsTestSpace3D;
+
+// Several chunks of the batch, so the queries are split over worker threads when there are any.
+static constexpr int QUERY_COUNT = 300;
+
+struct BatchResults {
+	int ray_hit_count = 0;
+	// Bodies are given by their index, since each run creates its own.
+	Vector<int> ray_bodies;
+	Vector<Vector3> ray_positions;
+	int point_hit_count = 0;
+	Vector<int> point_bodies;
+	Vector<real_t> closest_safe;
+	Vector<real_t> closest_unsafe;
+};
+
+// Runs the same batches over overlapping spheres, so that each query culls several bodies
+// into the buffers of the thread running it.
+static BatchResults run_batches(int p_thread_count) {
+	TestUtils::ScopedWorkerThreadCount thread_count(p_thread_count);
+
+	PhysicsTestSpace3D world;
+	const RID sphere_shape = world.create_sphere_shape(10.0);
+	RandomPCG rng(12345);
+	for (int i = 0; i < 64; i++) {
+		world.add_static_body(sphere_shape, Vector3(rng.random(0.0f, 100.0f), rng.random(0.0f, 100.0f), rng.random(0.0f, 100.0f)));
+	}
+	const RID query_shape = world.create_sphere_shape(3.0);
+	world.step(1);
+
+	Vector<Vector3> points;
+	Vector<Vector3> ends;
+	Vector<Vector3> motions;
+	for (int i = 0; i < QUERY_COUNT; i++) {
+		points.push_back(Vector3(rng.random(-20.0f, 120.0f), rng.random(-20.0f, 120.0f), rng.random(-20.0f, 120.0f)));
+		motions.push_back(Vector3(rng.random(-60.0f, 60.0f), rng.random(-60.0f, 60.0f), rng.random(-60.0f, 60.0f)));
+		ends.push_back(points[i] + motions[i]);
+	}
+
+	PhysicsDirectSpaceState3D *space_state = world.ps->space_get_direct_state(world.space);
+	REQUIRE(space_state);
+	BatchResults results;
+
+	LocalVector<PS3DT::RayResult> ray_results;
+	ray_results.resize(QUERY_COUNT);
+	results.ray_hit_count = space_state->intersect_rays(PS3DT::RayParameters(), points.ptr(), ends.ptr(), QUERY_COUNT, ray_results.ptr());
+	for (const PS3DT::RayResult &result : ray_results) {
+		results.ray_bodies.push_back(world.bodies.find(result.rid));
+		results.ray_positions.push_back(result.position);
+	}
+
+	LocalVector<PS3DT::ShapeResult> point_results;
+	point_results.resize(QUERY_COUNT);
+	results.point_hit_count = space_state->intersect_points(PS3DT::PointParameters(), points.ptr(), QUERY_COUNT, point_results.ptr());
+	for (const PS3DT::ShapeResult &result : point_results) {
+		results.point_bodies.push_back(world.bodies.find(result.rid));
+	}
+
+	PS3DT::ShapeParameters shape_parameters;
+	shape_parameters.shape_rid = query_shape;
+	results.closest_safe.resize(QUERY_COUNT);
+	results.closest_unsafe.resize(QUERY_COUNT);
+	CHECK(space_state->cast_motions(shape_parameters, points.ptr(), motions.ptr(), QUERY_COUNT, results.closest_safe.ptrw(), results.closest_unsafe.ptrw()));
+
+	return results;
+}
+
+TEST_CASE("[SceneTree][Physics3D] Batched queries give the same results with any number of threads") {
+	const BatchResults serial = run_batches(1);
+	const BatchResults threaded = run_batches(4);
+
+	// Some queries hit and some miss, otherwise the comparison would prove little.
+	CHECK(serial.ray_hit_count > 0);
+	CHECK(serial.ray_hit_count < QUERY_COUNT);
+	CHECK(serial.point_hit_count > 0);
+	CHECK(serial.point_hit_count < QUERY_COUNT);
+
+	CHECK(threaded.ray_hit_count == serial.ray_hit_count);
+	CHECK(threaded.ray_bodies == serial.ray_bodies);
+	CHECK(threaded.ray_positions == serial.ray_positions);
+	CHECK(threaded.point_hit_count == serial.point_hit_count);
+	CHECK(threaded.point_bodies == serial.point_bodies);
+	CHECK(threaded.closest_safe == serial.closest_safe);
+	CHECK(threaded.closest_unsafe == serial.closest_unsafe);
+}
+
+TEST_CASE("[SceneTree][Physics3D] Batched queries reject arrays of different sizes") {
+	PhysicsTestSpace3D world;
+	PhysicsDirectSpaceState3D *space_state = world.ps->space_get_direct_state(world.space);
+	REQUIRE(space_state);
+
+	PackedVector3Array three;
+	three.resize(3);
+	PackedVector3Array two;
+	two.resize(2);
+
+	Ref<PhysicsRayQueryParameters3D> ray_query;
+	ray_query.instantiate();
+	Ref<PhysicsShapeQueryParameters3D> shape_query;
+	shape_query.instantiate();
+	shape_query->set_shape_rid(world.create_sphere_shape(1.0));
+
+	ERR_PRINT_OFF;
+	const Dictionary rays = space_state->call(SNAME("intersect_rays"), ray_query, three, two);
+	const Dictionary motions = space_state->call(SNAME("cast_motions"), shape_query, two, three);
+	ERR_PRINT_ON;
+	CHECK(rays.is_empty());
+	CHECK(motions.is_empty());
+
+	// Matching sizes give one result per query.
+	const Dictionary matching_rays = space_state->call(SNAME("intersect_rays"), ray_query, three, three);
+	CHECK(PackedVector3Array(matching_rays["position"]).size() == 3);
+	const Dictionary matching_motions = space_state->call(SNAME("cast_motions"), shape_query, two, two);
+	CHECK(Vector<real_t>(matching_motions["safe_fraction"]).size() == 2);
+}
+
+} // namespace TestQueryBatch3D
@@ -0,0 +1,176 @@
+/**************************************************************************/
+/*  test_soft_body_3d.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_soft_body_3d.h"
+
+#include "core/templates/hash_set.h"
+#include "servers/physics_3d/physics_server_3d.h"
+#include "servers/rendering/rendering_server.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestSoftBody3D {
+
+const int SHEET_SIZE = 30;
+const int FAN_SIZE = 100;
+
+// A square sheet of 31x31 vertices, pinned at vertex 0, and a fan whose center has more links than there are colors.
+static RID create_mesh() {
+	Vector<Vector3> vertices;
+	Vector<int> indices;
+	for (int z = 0; z <= SHEET_SIZE; z++) {
+		for (int x = 0; x <= SHEET_SIZE; x++) {
+			vertices.push_back(Vector3(x * 0.2, 0, z * 0.2));
+		}
+	}
+	for (int z = 0; z < SHEET_SIZE; z++) {
+		for (int x = 0; x < SHEET_SIZE; x++) {
+			const int corner = z * (SHEET_SIZE + 1) + x;
+			indices.append_array({ corner, corner + 1, corner + SHEET_SIZE + 1 });
+			indices.append_array({ corner + 1, corner + SHEET_SIZE + 2, corner + SHEET_SIZE + 1 });
+		}
+	}
+
+	const int center = vertices.size();
+	vertices.push_back(Vector3(10, 0, 0));
+	for (int i = 0; i < FAN_SIZE; i++) {
+		vertices.push_back(Vector3(10, 0, 0) + Vector3(3, 0, 0).rotated(Vector3(0, 1, 0), Math::TAU * i / FAN_SIZE));
+		indices.append_array({ center, center + 1 + i, center + 1 + (i + 1) % FAN_SIZE });
+	}
+
+	Array arrays;
+	arrays.resize(RSE::ARRAY_MAX);
+	arrays[RSE::ARRAY_VERTEX] = vertices;
+	arrays[RSE::ARRAY_INDEX] = indices;
+	RID mesh = RenderingServer::get_singleton()->mesh_create();
+	RenderingServer::get_singleton()->mesh_add_surface_from_arrays(mesh, RSE::PRIMITIVE_TRIANGLES, arrays);
+	return mesh;
+}
+
+TEST_CASE("[SceneTree][Physics3D] Large soft bodies split their links into batches that don't share nodes") {
+	RID mesh = create_mesh();
+	GodotSoftBody3D *soft_body = memnew(GodotSoftBody3D);
+	soft_body->set_mesh(mesh);
+	REQUIRE(soft_body->is_solved_in_parallel());
+
+	LocalVector<LocalVector<Vector2i>> batches;
+	LocalVector<Vector2i> serial_links;
+	soft_body->get_link_batches(batches, serial_links);
+
+	CHECK(batches.size() == 64);
+	uint32_t link_count = serial_links.size();
+	HashSet<int> batch_nodes;
+	for (uint32_t batch = 0; batch < batches.size(); batch++) {
+		batch_nodes.clear();
+		for (const Vector2i &link : batches[batch]) {
+			if (batch_nodes.has(link.x) || batch_nodes.has(link.y)) {
+				FAIL_CHECK(vformat("Batch %d has two links on the same node.", batch));
+				break;
+			}
+			batch_nodes.insert(link.x);
+			batch_nodes.insert(link.y);
+		}
+		link_count += batches[batch].size();
+	}
+	CHECK(soft_body->get_link_count() >= 2048);
+	CHECK_MESSAGE(link_count == soft_body->get_link_count(), "Each link should be in a batch or solved serially.");
+	CHECK_MESSAGE(!serial_links.is_empty(), "The fan's links past the last color should be solved serially.");
+
+	soft_body->set_mesh(RID());
+	CHECK_FALSE(soft_body->is_solved_in_parallel());
+	memdelete(soft_body);
+	RenderingServer::get_singleton()->free_rid(mesh);
+}
+
+static LocalVector<Vector3> simulate_soft_body(RID p_mesh, int p_steps, AABB &r_bounds) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+	RID soft_body = ps->soft_body_create();
+	ps->soft_body_set_mesh(soft_body, p_mesh);
+	ps->soft_body_set_space(soft_body, space);
+	ps->soft_body_pin_point(soft_body, 0, true);
+
+	for (int i = 0; i < p_steps; i++) {
+		ps->step(1.0 / 60.0);
+	}
+
+	LocalVector<Vector3> positions;
+	const int point_count = (SHEET_SIZE + 1) * (SHEET_SIZE + 1) + FAN_SIZE + 1;
+	for (int i = 0; i < point_count; i++) {
+		positions.push_back(ps->soft_body_get_point_global_position(soft_body, i));
+	}
+	r_bounds = ps->soft_body_get_bounds(soft_body);
+
+	ps->free_rid(soft_body);
+	ps->free_rid(space);
+	return positions;
+}
+
+TEST_CASE("[SceneTree][Physics3D] Large soft bodies move the same way with any number of threads") {
+	const int steps = 30;
+	RID mesh = create_mesh();
+
+	AABB serial_bounds;
+	LocalVector<Vector3> serial;
+	{
+		TestUtils::ScopedWorkerThreadCount thread_count(1);
+		serial = simulate_soft_body(mesh, steps, serial_bounds);
+	}
+	AABB threaded_bounds;
+	LocalVector<Vector3> threaded;
+	{
+		TestUtils::ScopedWorkerThreadCount thread_count(4);
+		threaded = simulate_soft_body(mesh, steps, threaded_bounds);
+	}
+
+	REQUIRE(serial.size() == threaded.size());
+	for (uint32_t i = 0; i < serial.size(); i++) {
+		if (serial[i] != threaded[i]) {
+			FAIL_CHECK(vformat("Point %d should end up at a bit-identical position.", i));
+			break;
+		}
+	}
+	CHECK(serial_bounds == threaded_bounds);
+
+	// The sheet swings down from its pinned corner and the fan falls, the bounds follow them.
+	CHECK(threaded[0] == Vector3());
+	CHECK(threaded[threaded.size() - 1].y < -0.5);
+	AABB grown_bounds = threaded_bounds.grow(CMP_EPSILON);
+	for (const Vector3 &position : threaded) {
+		CHECK(grown_bounds.has_point(position));
+	}
+
+	RenderingServer::get_singleton()->free_rid(mesh);
+}
+
+} // namespace TestSoftBody3D
@@ -0,0 +1,393 @@
+/**************************************************************************/
+/*  test_step_3d.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_body_3d.h"
+#include "../godot_constraint_3d.h"
+#include "../godot_step_3d.h"
+
+#include "core/math/random_pcg.h"
+#include "core/object/callable_mp.h"
+#include "core/templates/hash_set.h"
+#include "servers/physics_3d/physics_server_3d.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestStep3D {
+
+// Only the bodies of a constraint matter for coloring.
+class LinkConstraint : public GodotConstraint3D {
+	GodotBody3D *bodies[2] = {};
+
+public:
+	virtual bool setup(real_t p_step) override { return true; }
+	virtual bool pre_solve(real_t p_step) override { return true; }
+	virtual void solve(real_t p_step) override {}
+
+	LinkConstraint(GodotBody3D *p_body_A, GodotBody3D *p_body_B) :
+			GodotConstraint3D(bodies, 2) {
+		bodies[0] = p_body_A;
+		bodies[1] = p_body_B;
+	}
+};
+
+TEST_CASE("[Physics3D] Island coloring keeps rigid bodies out of shared batches") {
+	const int grid_size = 20;
+	const int satellite_count = 100;
+
+	LocalVector<GodotBody3D *> bodies;
+	GodotBody3D *ground = memnew(GodotBody3D);
+	ground->set_mode(PS3DE::BODY_MODE_STATIC);
+	bodies.push_back(ground);
+	for (int i = 0; i < grid_size * grid_size + satellite_count + 1; i++) {
+		bodies.push_back(memnew(GodotBody3D));
+	}
+	GodotBody3D *hub = bodies[bodies.size() - 1];
+
+	// A grid linked to its neighbors and to the static ground, plus a hub linked to more bodies than there are colors.
+	LocalVector<GodotConstraint3D *> constraints;
+	for (int y = 0; y < grid_size; y++) {
+		for (int x = 0; x < grid_size; x++) {
+			GodotBody3D *body = bodies[1 + y * grid_size + x];
+			constraints.push_back(memnew(LinkConstraint(body, ground)));
+			if (x + 1 < grid_size) {
+				constraints.push_back(memnew(LinkConstraint(body, bodies[1 + y * grid_size + x + 1])));
+			}
+			if (y + 1 < grid_size) {
+				constraints.push_back(memnew(LinkConstraint(body, bodies[1 + (y + 1) * grid_size + x])));
+			}
+		}
+	}
+	for (int i = 0; i < satellite_count; i++) {
+		constraints.push_back(memnew(LinkConstraint(hub, bodies[1 + grid_size * grid_size + i])));
+	}
+
+	LocalVector<LocalVector<GodotConstraint3D *>> batches;
+	LocalVector<GodotConstraint3D *> uncolored;
+	HashMap<const GodotBody3D *, uint64_t> body_color_masks;
+	GodotStep3D::color_constraints(constraints, batches, uncolored, body_color_masks);
+
+	CHECK(batches.size() == 64);
+	uint32_t colored_count = 0;
+	int batches_sharing_ground = 0;
+	for (const LocalVector<GodotConstraint3D *> &batch : batches) {
+		HashSet<const GodotBody3D *> batch_bodies;
+		int ground_constraints = 0;
+		for (const GodotConstraint3D *constraint : batch) {
+			for (int i = 0; i < constraint->get_body_count(); i++) {
+				const GodotBody3D *body = constraint->get_body_ptr()[i];
+				if (body == ground) {
+					ground_constraints++;
+					continue;
+				}
+				CHECK_MESSAGE(!batch_bodies.has(body), "A rigid body should be in at most one constraint of a batch.");
+				batch_bodies.insert(body);
+			}
+		}
+		batches_sharing_ground += ground_constraints > 1 ? 1 : 0;
+		colored_count += batch.size();
+	}
+	CHECK_MESSAGE(batches_sharing_ground > 0, "Static bodies shouldn't take colors.");
+
+	// Each hub link takes the next color, the ones past the last color are left to be solved serially.
+	CHECK(uncolored.size() == satellite_count - 64);
+	for (const GodotConstraint3D *constraint : uncolored) {
+		CHECK(constraint->get_body_ptr()[0] == hub);
+	}
+	CHECK(colored_count + uncolored.size() == constraints.size());
+
+	for (GodotConstraint3D *constraint : constraints) {
+		memdelete(constraint);
+	}
+	for (GodotBody3D *body : bodies) {
+		memdelete(body);
+	}
+}
+
+// A spinning hub pinned to the world, holding a ring of satellites and a hanging sheet.
+// The hub has more joints than there are colors, and the sheet's batches are large enough to be split.
+static LocalVector<Transform3D> simulate_pinned_hub(int p_steps) {
+	const int satellite_count = 100;
+	const int sheet_size = 20;
+	const real_t spacing = 0.5;
+	const Vector3 hub_position(0, 10, 0);
+
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+	RID shape = ps->sphere_shape_create();
+	ps->shape_set_data(shape, 0.05);
+
+	LocalVector<RID> bodies;
+	LocalVector<RID> joints;
+	auto add_body = [&](const Vector3 &p_position) {
+		RID body = ps->body_create();
+		ps->body_add_shape(body, shape);
+		ps->body_set_collision_layer(body, 0);
+		ps->body_set_collision_mask(body, 0);
+		ps->body_set_space(body, space);
+		ps->body_set_state(body, PS3DE::BODY_STATE_TRANSFORM, Transform3D(Basis(), p_position));
+		ps->body_set_state(body, PS3DE::BODY_STATE_CAN_SLEEP, false);
+		bodies.push_back(body);
+		return body;
+	};
+	auto pin = [&](RID p_body_A, const Vector3 &p_local_A, RID p_body_B, const Vector3 &p_local_B) {
+		RID joint = ps->joint_create();
+		ps->joint_make_pin(joint, p_body_A, p_local_A, p_body_B, p_local_B);
+		joints.push_back(joint);
+	};
+
+	RID hub = add_body(hub_position);
+	pin(hub, Vector3(), RID(), hub_position);
+	ps->body_set_state(hub, PS3DE::BODY_STATE_ANGULAR_VELOCITY, Vector3(0, 1, 0));
+	for (int i = 0; i < satellite_count; i++) {
+		const Vector3 offset = Vector3(3, 0, 0).rotated(Vector3(0, 1, 0), Math::TAU * i / satellite_count);
+		pin(hub, offset, add_body(hub_position + offset), Vector3());
+	}
+	for (int y = 0; y < sheet_size; y++) {
+		for (int x = 0; x < sheet_size; x++) {
+			const Vector3 offset((x - (sheet_size - 1) * 0.5) * spacing, -(y + 1) * spacing, 0);
+			RID body = add_body(hub_position + offset);
+			if (y == 0) {
+				pin(hub, offset, body, Vector3());
+			} else {
+				pin(bodies[bodies.size() - 1 - sheet_size], Vector3(0, -spacing, 0), body, Vector3());
+			}
+			if (x > 0) {
+				pin(bodies[bodies.size() - 2], Vector3(spacing, 0, 0), body, Vector3());
+			}
+		}
+	}
+
+	for (int i = 0; i < p_steps; i++) {
+		ps->step(1.0 / 60.0);
+	}
+
+	LocalVector<Transform3D> transforms;
+	for (const RID &body : bodies) {
+		transforms.push_back(ps->body_get_state(body, PS3DE::BODY_STATE_TRANSFORM));
+	}
+
+	for (const RID &joint : joints) {
+		ps->free_rid(joint);
+	}
+	for (const RID &body : bodies) {
+		ps->free_rid(body);
+	}
+	ps->free_rid(shape);
+	ps->free_rid(space);
+	return transforms;
+}
+
+TEST_CASE("[SceneTree][Physics3D] Large islands are solved the same way with any number of threads") {
+	const int steps = 60;
+	const int satellite_count = 100;
+
+	LocalVector<Transform3D> serial;
+	{
+		TestUtils::ScopedWorkerThreadCount thread_count(1);
+		serial = simulate_pinned_hub(steps);
+	}
+	LocalVector<Transform3D> threaded;
+	LocalVector<Transform3D> threaded_again;
+	{
+		TestUtils::ScopedWorkerThreadCount thread_count(4);
+		threaded = simulate_pinned_hub(steps);
+		threaded_again = simulate_pinned_hub(steps);
+	}
+
+	REQUIRE(serial.size() == threaded.size());
+	REQUIRE(serial.size() == threaded_again.size());
+	for (uint32_t i = 0; i < serial.size(); i++) {
+		if (serial[i] != threaded[i] || threaded[i] != threaded_again[i]) {
+			FAIL_CHECK(vformat("Body %d should end up at a bit-identical transform.", i));
+			break;
+		}
+	}
+
+	// Hub joints past the last color are solved after the batches, so no satellite falls off.
+	const Transform3D &hub = threaded[0];
+	for (int i = 0; i < satellite_count; i++) {
+		const Vector3 offset = Vector3(3, 0, 0).rotated(Vector3(0, 1, 0), Math::TAU * i / satellite_count);
+		CHECK_MESSAGE(hub.xform(offset).distance_to(threaded[1 + i].origin) < 0.25, vformat("Satellite %d should stay pinned to the hub.", i));
+	}
+}
+
+struct BodyMotion {
+	Transform3D transform;
+	Vector3 linear_velocity;
+	Vector3 angular_velocity;
+
+	bool operator==(const BodyMotion &p_other) const {
+		return transform == p_other.transform && linear_velocity == p_other.linear_velocity && angular_velocity == p_other.angular_velocity;
+	}
+	bool operator!=(const BodyMotion &p_other) const { return !(*this == p_other); }
+};
+
+// Boxes thrown at random onto the ground and into each other.
+static LocalVector<BodyMotion> simulate_thrown_boxes(int p_steps) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+	RID ground_shape = ps->world_boundary_shape_create();
+	ps->shape_set_data(ground_shape, Plane(Vector3(0, 1, 0), 0));
+	RID ground = ps->body_create();
+	ps->body_set_mode(ground, PS3DE::BODY_MODE_STATIC);
+	ps->body_add_shape(ground, ground_shape);
+	ps->body_set_space(ground, space);
+	RID box_shape = ps->box_shape_create();
+	ps->shape_set_data(box_shape, Vector3(0.25, 0.25, 0.25));
+
+	RandomPCG rng(12345);
+	LocalVector<RID> boxes;
+	for (int i = 0; i < 200; i++) {
+		RID box = ps->body_create();
+		ps->body_add_shape(box, box_shape);
+		ps->body_set_space(box, space);
+		ps->body_set_state(box, PS3DE::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3((i % 10) * 0.8, 1 + (i / 10) * 0.6, 0)));
+		ps->body_set_state(box, PS3DE::BODY_STATE_LINEAR_VELOCITY, Vector3(rng.random(-2.0, 2.0), rng.random(-2.0, 2.0), rng.random(-2.0, 2.0)));
+		ps->body_set_state(box, PS3DE::BODY_STATE_ANGULAR_VELOCITY, Vector3(rng.random(-5.0, 5.0), rng.random(-5.0, 5.0), rng.random(-5.0, 5.0)));
+		boxes.push_back(box);
+	}
+
+	for (int i = 0; i < p_steps; i++) {
+		ps->step(1.0 / 60.0);
+	}
+
+	LocalVector<BodyMotion> motions;
+	for (const RID &box : boxes) {
+		BodyMotion motion;
+		motion.transform = ps->body_get_state(box, PS3DE::BODY_STATE_TRANSFORM);
+		motion.linear_velocity = ps->body_get_state(box, PS3DE::BODY_STATE_LINEAR_VELOCITY);
+		motion.angular_velocity = ps->body_get_state(box, PS3DE::BODY_STATE_ANGULAR_VELOCITY);
+		motions.push_back(motion);
+		ps->free_rid(box);
+	}
+	ps->free_rid(ground);
+	ps->free_rid(box_shape);
+	ps->free_rid(ground_shape);
+	ps->free_rid(space);
+	return motions;
+}
+
+TEST_CASE("[SceneTree][Physics3D] Bodies are integrated the same way with any number of threads") {
+	const int steps = 90;
+
+	LocalVector<BodyMotion> serial;
+	{
+		TestUtils::ScopedWorkerThreadCount thread_count(1);
+		serial = simulate_thrown_boxes(steps);
+	}
+	LocalVector<BodyMotion> threaded;
+	{
+		TestUtils::ScopedWorkerThreadCount thread_count(4);
+		threaded = simulate_thrown_boxes(steps);
+	}
+
+	REQUIRE(serial.size() == threaded.size());
+	for (uint32_t i = 0; i < serial.size(); i++) {
+		if (serial[i] != threaded[i]) {
+			FAIL_CHECK(vformat("Box %d should end up with a bit-identical transform and velocities.", i));
+			break;
+		}
+	}
+}
+
+static LocalVector<RID> synced_bodies;
+
+static void body_state_synced(PhysicsDirectBodyState3D *p_state, RID p_body) {
+	synced_bodies.push_back(p_body);
+}
+
+TEST_CASE("[SceneTree][Physics3D] Space updates deferred from parallel integration") {
+	TestUtils::ScopedWorkerThreadCount thread_count(4);
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+	RID shape = ps->box_shape_create();
+	ps->shape_set_data(shape, Vector3(0.5, 0.5, 0.5));
+
+	RID kinematic = ps->body_create();
+	ps->body_set_mode(kinematic, PS3DE::BODY_MODE_KINEMATIC);
+	ps->body_add_shape(kinematic, shape);
+	ps->body_set_space(kinematic, space);
+	ps->body_set_state(kinematic, PS3DE::BODY_STATE_TRANSFORM, Transform3D());
+	ps->body_set_state_sync_callback(kinematic, callable_mp_static(&body_state_synced).bind(kinematic));
+	auto step = [&]() {
+		ps->step(1.0 / 60.0);
+		ps->flush_queries();
+	};
+	step();
+	step();
+	REQUIRE(ps->body_get_state(kinematic, PS3DE::BODY_STATE_SLEEPING));
+	synced_bodies.clear();
+
+	SUBCASE("A kinematic body that stops moving is deactivated") {
+		ps->body_set_state(kinematic, PS3DE::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(1, 0, 0)));
+		CHECK_FALSE(ps->body_get_state(kinematic, PS3DE::BODY_STATE_SLEEPING));
+
+		step();
+		CHECK_MESSAGE(!ps->body_get_state(kinematic, PS3DE::BODY_STATE_SLEEPING), "The body moved during this step.");
+		CHECK(Vector3(ps->body_get_state(kinematic, PS3DE::BODY_STATE_LINEAR_VELOCITY)).x > 0);
+		CHECK(synced_bodies.size() == 1);
+
+		step();
+		CHECK(ps->body_get_state(kinematic, PS3DE::BODY_STATE_SLEEPING));
+		CHECK(synced_bodies.size() == 2);
+
+		step();
+		CHECK_MESSAGE(synced_bodies.size() == 2, "Deactivated bodies shouldn't be synced.");
+	}
+
+	SUBCASE("A body woken up after integrating forces still has its state synced") {
+		// Pairing with an area wakes the kinematic body during the broadphase update, after forces are integrated.
+		RID area = ps->area_create();
+		ps->area_add_shape(area, shape);
+		ps->area_set_transform(area, Transform3D(Basis(), Vector3(10, 0, 0)));
+		ps->area_set_space(area, space);
+		step();
+		REQUIRE(synced_bodies.is_empty());
+
+		ps->area_set_transform(area, Transform3D());
+		step();
+		CHECK(synced_bodies.size() == 1);
+		CHECK_MESSAGE(ps->body_get_state(kinematic, PS3DE::BODY_STATE_SLEEPING), "The woken body didn't move, so it should be deactivated again.");
+
+		ps->free_rid(area);
+	}
+
+	ps->free_rid(kinematic);
+	ps->free_rid(shape);
+	ps->free_rid(space);
+	synced_bodies.clear();
+}
+
+} // namespace TestStep3D
@@ -33,6 +33,7 @@
 #include "../joints/jolt_joint_3d.h"
 #include "../jolt_physics_server_3d.h"
 #include "../jolt_project_settings.h"
+#include "../misc/jolt_state_recorder.h"
 #include "../misc/jolt_stream_wrappers.h"
 #include "../objects/jolt_area_3d.h"
 #include "../objects/jolt_body_3d.h"
@@ -61,6 +62,9 @@ constexpr double SPACE_DEFAULT_SLEEP_THRESHOLD_LINEAR = 0.1;
 constexpr double SPACE_DEFAULT_SLEEP_THRESHOLD_ANGULAR = 8.0 * Math::PI / 180;
 constexpr double SPACE_DEFAULT_SOLVER_ITERATIONS = 8;
 
+constexpr uint32_t SPACE_STATE_MAGIC = 0x5333544A; // "JT3S"
+constexpr int SPACE_STATE_HEADER_SIZE = 2 * sizeof(uint32_t); // Magic and checksum of the rest.
+
 } // namespace
 
 void JoltSpace3D::_pre_step(float p_step) {
@@ -465,6 +469,76 @@ void JoltSpace3D::flush_pending_objects() {
 	}
 }
 
+void JoltSpace3D::_get_state_body_keys(LocalVector<uint64_t> &r_keys) const {
+	// Body IDs are handed out by the physics system of the space, so unlike RIDs they're the same in another
+	// process that creates the same objects in the same order.
+	JPH::BodyIDVector body_ids;
+	physics_system->GetBodies(body_ids);
+	for (const JPH::BodyID &body_id : body_ids) {
+		const JoltObject3D *object = try_get_object(body_id);
+		const uint64_t object_type = object != nullptr ? uint64_t(object->get_type()) : uint64_t(JoltObject3D::OBJECT_TYPE_INVALID);
+		r_keys.push_back((object_type << 32) | body_id.GetIndexAndSequenceNumber());
+	}
+}
+
+Vector<uint8_t> JoltSpace3D::save_state() {
+	ERR_FAIL_COND_V_MSG(stepping, Vector<uint8_t>(), "Space state can't be saved while the space is being stepped.");
+
+	// Bodies waiting to be added would be saved without their broad phase state otherwise.
+	flush_pending_objects();
+
+	// Jolt only checks the number of bodies when restoring, so the bodies and the kind of objects they belong to are saved as well.
+	LocalVector<uint64_t> body_keys;
+	_get_state_body_keys(body_keys);
+
+	JoltStateRecorder recorder;
+	recorder.Write(SPACE_STATE_MAGIC);
+	recorder.Write(uint32_t(0)); // Checksum, filled in below.
+	recorder.Write(uint32_t(body_keys.size()));
+	for (uint64_t body_key : body_keys) {
+		recorder.Write(body_key);
+	}
+	physics_system->SaveState(recorder);
+	ERR_FAIL_COND_V(recorder.IsFailed(), Vector<uint8_t>());
+
+	Vector<uint8_t> data = recorder.get_data();
+	const uint32_t checksum = hash_murmur3_buffer(data.ptr() + SPACE_STATE_HEADER_SIZE, data.size() - SPACE_STATE_HEADER_SIZE);
+	memcpy(data.ptrw() + sizeof(uint32_t), &checksum, sizeof(uint32_t));
+
+	return data;
+}
+
+bool JoltSpace3D::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_V_MSG(stepping, false, "Space state can't be restored while the space is being stepped.");
+
+	flush_pending_objects();
+
+	JoltStateRecorder recorder(p_state);
+	uint32_t magic = 0;
+	uint32_t checksum = 0;
+	recorder.Read(magic);
+	recorder.Read(checksum);
+	ERR_FAIL_COND_V_MSG(recorder.IsFailed() || magic != SPACE_STATE_MAGIC, false, "Invalid space state.");
+	ERR_FAIL_COND_V_MSG(checksum != hash_murmur3_buffer(p_state.ptr() + SPACE_STATE_HEADER_SIZE, p_state.size() - SPACE_STATE_HEADER_SIZE), false, "Space state is corrupted.");
+
+	// Checked before Jolt restores anything, since it can't undo a partial restore.
+	LocalVector<uint64_t> body_keys;
+	_get_state_body_keys(body_keys);
+	uint32_t body_count = 0;
+	recorder.Read(body_count);
+	bool bodies_match = !recorder.IsFailed() && body_count == body_keys.size();
+	for (uint32_t i = 0; bodies_match && i < body_count; i++) {
+		uint64_t body_key = 0;
+		recorder.Read(body_key);
+		bodies_match = !recorder.IsFailed() && body_key == body_keys[i];
+	}
+	ERR_FAIL_COND_V_MSG(!bodies_match, false, "Space state doesn't match the bodies of the space.");
+
+	ERR_FAIL_COND_V_MSG(!physics_system->RestoreState(recorder) || recorder.IsFailed(), false, "Space state doesn't match the joints of the space.");
+
+	return true;
+}
+
 void JoltSpace3D::set_is_object_sleeping(const JPH::BodyID &p_jolt_id, bool p_enable) {
 	if (p_enable) {
 		if (pending_objects_awake.erase_unordered(p_jolt_id)) {
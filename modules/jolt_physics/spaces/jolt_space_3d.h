@@ -91,6 +91,8 @@ class JoltSpace3D {
 	void _pre_step(float p_step);
 	void _post_step(float p_step);
 
+	void _get_state_body_keys(LocalVector<uint64_t> &r_keys) const;
+
 public:
 	explicit JoltSpace3D(JPH::JobSystem *p_job_system, JPH::TempAllocator *p_temp_allocator);
 	~JoltSpace3D();
@@ -146,6 +148,9 @@ public:
 	void remove_object(const JPH::BodyID &p_jolt_id);
 	void flush_pending_objects();
 
+	Vector<uint8_t> save_state();
+	bool restore_state(const Vector<uint8_t> &p_state);
+
 	void set_is_object_sleeping(const JPH::BodyID &p_jolt_id, bool p_enable);
 
 	void enqueue_call_queries(SelfList<JoltBody3D> *p_body);
@@ -45,6 +45,7 @@ STATIC_ASSERT_INCOMPLETE_TYPE(class, Engine);
 #include "core/object/class_db.h"
 #include "core/object/message_queue.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/string/print_string.h"
 #include "scene/animation/tween.h"
 #include "scene/main/instance_placeholder.h"
@@ -307,7 +308,7 @@ void Node::_notification(int p_notification) {
 
 			// kill children as cleanly as possible
 			while (data.children.size()) {
-				Node *child = data.children.last()->value; // begin from the end because its faster and more consistent with creation
+				Node *child = *data.children.last(); // begin from the end because its faster and more consistent with creation
 				memdelete(child);
 			}
 		} break;
@@ -321,10 +322,39 @@ void Node::_notification(int p_notification) {
 }
 
 void Node::_propagate_ready() {
+	// When getting ready on a worker thread, nested sub-thread groups are accessed as their own group.
+	Node *prev_thread_group = current_process_thread_group;
+	if (prev_thread_group && data.process_thread_group_owner != prev_thread_group) {
+		current_process_thread_group = data.process_thread_group_owner;
+	}
+
 	data.ready_notified = true;
 	data.blocked++;
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		K.value->_propagate_ready();
+
+	LocalVector<Node *> threaded_children;
+	if (current_process_thread_group == nullptr && data.tree && data.tree->is_parallel_ready_enabled() && Thread::is_main_thread()) {
+		// Subtrees owning a sub-thread process group may only access their own nodes, like when processing,
+		// so they can get ready in parallel. They are ready before their parent, as usual.
+		for (Node *child : data.children) {
+			if (child->data.process_thread_group == PROCESS_THREAD_GROUP_SUB_THREAD && child->_can_propagate_ready_in_thread()) {
+				threaded_children.push_back(child);
+			}
+		}
+		if (threaded_children.size() > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Node::_propagate_ready_thread, threaded_children.ptr(), threaded_children.size(), -1, true, SNAME("Propagate ready"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			threaded_children.clear();
+		}
+	}
+
+	uint32_t next_threaded_child = 0;
+	for (Node *child : data.children) {
+		if (next_threaded_child < threaded_children.size() && threaded_children[next_threaded_child] == child) {
+			next_threaded_child++; // Already done above.
+			continue;
+		}
+		child->_propagate_ready();
 	}
 
 	data.blocked--;
@@ -336,6 +366,28 @@ void Node::_propagate_ready() {
 		notification(NOTIFICATION_READY);
 		emit_signal(SceneStringName(ready));
 	}
+
+	current_process_thread_group = prev_thread_group;
+}
+
+bool Node::_can_propagate_ready_in_thread() const {
+	// Nodes that must run on the main thread can't be reached from a worker thread.
+	if (data.process_thread_group == PROCESS_THREAD_GROUP_MAIN_THREAD) {
+		return false;
+	}
+	for (Node *child : data.children) {
+		if (!child->_can_propagate_ready_in_thread()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void Node::_propagate_ready_thread(uint32_t p_index, Node **p_children) {
+	Node *child = p_children[p_index];
+	current_process_thread_group = child;
+	child->_propagate_ready();
+	current_process_thread_group = nullptr;
 }
 
 void Node::_propagate_enter_tree() {
@@ -374,9 +426,9 @@ void Node::_propagate_enter_tree() {
 	data.blocked++;
 	//block while adding children
 
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		if (!K.value->is_inside_tree()) { // could have been added in enter_tree
-			K.value->_propagate_enter_tree();
+	for (Node *child : data.children) {
+		if (!child->is_inside_tree()) { // could have been added in enter_tree
+			child->_propagate_enter_tree();
 		}
 	}
 
@@ -398,8 +450,8 @@ void Node::_propagate_after_exit_tree() {
 
 	data.blocked++;
 
-	for (HashMap<StringName, Node *>::Iterator I = data.children.last(); I; --I) {
-		I->value->_propagate_after_exit_tree();
+	for (ChildMap::Iterator I = data.children.last(); I; --I) {
+		I->_propagate_after_exit_tree();
 	}
 
 	data.blocked--;
@@ -418,8 +470,8 @@ void Node::_propagate_exit_tree() {
 #endif
 	data.blocked++;
 
-	for (HashMap<StringName, Node *>::Iterator I = data.children.last(); I; --I) {
-		I->value->_propagate_exit_tree();
+	for (ChildMap::Iterator I = data.children.last(); I; --I) {
+		I->_propagate_exit_tree();
 	}
 
 	data.blocked--;
@@ -482,8 +534,8 @@ void Node::_propagate_physics_interpolated(bool p_interpolated) {
 	update_configuration_warnings();
 
 	data.blocked++;
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		K.value->_propagate_physics_interpolated(p_interpolated);
+	for (Node *child : data.children) {
+		child->_propagate_physics_interpolated(p_interpolated);
 	}
 	data.blocked--;
 }
@@ -494,8 +546,8 @@ void Node::_propagate_physics_interpolation_reset_requested(bool p_requested) {
 	}
 
 	data.blocked++;
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		K.value->_propagate_physics_interpolation_reset_requested(p_requested);
+	for (Node *child : data.children) {
+		child->_propagate_physics_interpolation_reset_requested(p_requested);
 	}
 	data.blocked--;
 }
@@ -592,8 +644,8 @@ void Node::_propagate_groups_dirty() {
 		}
 	}
 
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		K.value->_propagate_groups_dirty();
+	for (Node *child : data.children) {
+		child->_propagate_groups_dirty();
 	}
 }
 
@@ -735,8 +787,8 @@ void Node::_propagate_pause_notification(bool p_enable) {
 	}
 
 	data.blocked++;
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		K.value->_propagate_pause_notification(p_enable);
+	for (Node *child : data.children) {
+		child->_propagate_pause_notification(p_enable);
 	}
 	data.blocked--;
 }
@@ -745,8 +797,8 @@ void Node::_propagate_suspend_notification(bool p_enable) {
 	notification(p_enable ? NOTIFICATION_SUSPENDED : NOTIFICATION_UNSUSPENDED);
 
 	data.blocked++;
-	for (KeyValue<StringName, Node *> &KV : data.children) {
-		KV.value->_propagate_suspend_notification(p_enable);
+	for (Node *child : data.children) {
+		child->_propagate_suspend_notification(p_enable);
 	}
 	data.blocked--;
 }
@@ -767,8 +819,7 @@ void Node::_propagate_process_owner(Node *p_owner, int p_pause_notification, int
 	}
 
 	data.blocked++;
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		Node *c = K.value;
+	for (Node *c : data.children) {
 		if (c->data.process_mode == PROCESS_MODE_INHERIT) {
 			c->_propagate_process_owner(p_owner, p_pause_notification, p_enabled_notification);
 		}
@@ -781,8 +832,8 @@ void Node::set_multiplayer_authority(int p_peer_id, bool p_recursive) {
 	data.multiplayer_authority = p_peer_id;
 
 	if (p_recursive) {
-		for (KeyValue<StringName, Node *> &K : data.children) {
-			K.value->set_multiplayer_authority(p_peer_id, true);
+		for (Node *child : data.children) {
+			child->set_multiplayer_authority(p_peer_id, true);
 		}
 	}
 }
@@ -904,6 +955,35 @@ bool Node::can_process_notification(int p_what) const {
 	return true;
 }
 
+Node::ProcessDispatch Node::_get_process_dispatch(bool p_physics) const {
+	// Only Node itself is known to handle the process notifications in C++, derived
+	// classes and extensions may handle them in their own _notification().
+	if (&get_gdtype() != &Node::get_gdtype_static() || _get_extension()) {
+		return PROCESS_DISPATCH_NOTIFY;
+	}
+
+	const ScriptInstance *si = get_script_instance();
+	if (!si) {
+		return PROCESS_DISPATCH_SKIP;
+	}
+	if (si->has_method(SNAME("_notification"))) {
+		return PROCESS_DISPATCH_NOTIFY;
+	}
+	if (si->has_method(p_physics ? SNAME("_physics_process") : SNAME("_process"))) {
+		return PROCESS_DISPATCH_SCRIPT_CALLBACK;
+	}
+	return PROCESS_DISPATCH_SKIP;
+}
+
+void Node::_call_process_callback(bool p_physics) {
+	// Same as what _notification() does for the process notifications.
+	if (p_physics) {
+		GDVIRTUAL_CALL(_physics_process, get_physics_process_delta_time());
+	} else {
+		GDVIRTUAL_CALL(_process, get_process_delta_time());
+	}
+}
+
 bool Node::can_process() const {
 	return is_inside_tree() && !data.tree->is_suspended() && _can_process(data.tree->is_paused());
 }
@@ -1091,12 +1171,12 @@ void Node::_remove_tree_from_process_thread_group() {
 		return; // May not be initialized yet.
 	}
 
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		if (K.value->data.process_thread_group != PROCESS_THREAD_GROUP_INHERIT) {
+	for (Node *child : data.children) {
+		if (child->data.process_thread_group != PROCESS_THREAD_GROUP_INHERIT) {
 			continue;
 		}
 
-		K.value->_remove_tree_from_process_thread_group();
+		child->_remove_tree_from_process_thread_group();
 	}
 
 	if (_is_any_processing()) {
@@ -1116,12 +1196,12 @@ void Node::_add_tree_to_process_thread_group(Node *p_owner) {
 		_add_to_process_thread_group();
 	}
 
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		if (K.value->data.process_thread_group != PROCESS_THREAD_GROUP_INHERIT) {
+	for (Node *child : data.children) {
+		if (child->data.process_thread_group != PROCESS_THREAD_GROUP_INHERIT) {
 			continue;
 		}
 
-		K.value->_add_tree_to_process_thread_group(p_owner);
+		child->_add_tree_to_process_thread_group(p_owner);
 	}
 }
 bool Node::is_processing_internal() const {
@@ -1415,8 +1495,7 @@ void Node::set_translation_domain_inherited() {
 }
 
 void Node::_propagate_translation_domain_dirty() {
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		Node *child = K.value;
+	for (Node *child : data.children) {
 		if (child->data.is_translation_domain_inherited) {
 			child->data.is_translation_domain_dirty = true;
 			child->_propagate_translation_domain_dirty();
@@ -1434,6 +1513,7 @@ StringName Node::get_name() const {
 
 void Node::_set_name_nocheck(const StringName &p_name) {
 	data.name = p_name;
+	_structure_changed();
 }
 
 void Node::set_name(const StringName &p_name) {
@@ -1457,9 +1537,10 @@ void Node::set_name(const StringName &p_name) {
 
 	if (data.parent) {
 		data.parent->_validate_child_name(this, true);
-		bool success = data.parent->data.children.replace_key(old_name, data.name);
+		bool success = data.parent->data.children.rename(old_name, this);
 		ERR_FAIL_COND_MSG(!success, "Renaming child in hashtable failed, this is a bug.");
 	}
+	_structure_changed();
 
 	if (data.unique_name_in_owner && data.owner) {
 		_acquire_unique_name_in_owner();
@@ -1544,8 +1625,8 @@ void Node::_validate_child_name(Node *p_child, bool p_force_human_readable) {
 			//new unique name must be assigned
 			unique = false;
 		} else {
-			const Node *const *existing = data.children.getptr(p_child->data.name);
-			unique = !existing || *existing == p_child;
+			const Node *existing = data.children.find(p_child->data.name);
+			unique = !existing || existing == p_child;
 		}
 
 		if (!unique) {
@@ -1609,8 +1690,8 @@ void Node::_generate_serial_child_name(const Node *p_child, StringName &name) co
 		name = p_child->get_class();
 	}
 
-	const Node *const *existing = data.children.getptr(name);
-	if (!existing || *existing == p_child) { // Unused, or is current node.
+	const Node *existing = data.children.find(name);
+	if (!existing || existing == p_child) { // Unused, or is current node.
 		return;
 	}
 
@@ -1639,8 +1720,8 @@ void Node::_generate_serial_child_name(const Node *p_child, StringName &name) co
 	for (;;) {
 		StringName attempt = name_string + nums;
 
-		existing = data.children.getptr(attempt);
-		bool exists = existing != nullptr && *existing != p_child;
+		existing = data.children.find(attempt);
+		bool exists = existing != nullptr && existing != p_child;
 
 		if (!exists) {
 			name = attempt;
@@ -1665,7 +1746,7 @@ void Node::_add_child_nocheck(Node *p_child, const StringName &p_name, InternalM
 	//add a child node quickly, without name validation
 
 	p_child->data.name = p_name;
-	data.children.insert(p_name, p_child);
+	data.children.insert(p_child);
 
 	p_child->data.internal_mode = p_internal_mode;
 
@@ -1689,6 +1770,7 @@ void Node::_add_child_nocheck(Node *p_child, const StringName &p_name, InternalM
 	}
 
 	p_child->data.parent = this;
+	p_child->_structure_changed(); // Also changes this node and its ancestors.
 
 	if (!data.children_cache_dirty && can_push_back) {
 		data.children_cache.push_back(p_child);
@@ -1787,8 +1869,9 @@ void Node::remove_child(RequiredParam<Node> rp_child) {
 	} else {
 		data.children_cache_dirty = true;
 	}
-	bool success = data.children.erase(p_child->data.name);
+	bool success = data.children.erase(p_child);
 	ERR_FAIL_COND_MSG(!success, "Children name does not match parent name in hashtable, this is a bug.");
+	p_child->_structure_changed();
 
 	p_child->data.parent = nullptr;
 	p_child->data.index = -1;
@@ -1805,8 +1888,8 @@ void Node::_update_children_cache_impl() const {
 	// Assign children
 	data.children_cache.resize(data.children.size());
 	int idx = 0;
-	for (const KeyValue<StringName, Node *> &K : data.children) {
-		data.children_cache[idx] = K.value;
+	for (Node *child : data.children) {
+		data.children_cache[idx] = child;
 		idx++;
 	}
 	// Sort them
@@ -1910,15 +1993,142 @@ TypedArray<Node> Node::get_children(bool p_include_internal) const {
 	return children;
 }
 
-Node *Node::_get_child_by_name(const StringName &p_name) const {
-	const Node *const *node = data.children.getptr(p_name);
-	if (node) {
-		return const_cast<Node *>(*node);
+Node *Node::ChildMap::find(const StringName &p_name) const {
+	if (map) {
+		Node *const *child = map->getptr(p_name);
+		return child ? *child : nullptr;
+	}
+	for (Node *child : list) {
+		if (child->data.name == p_name) {
+			return child;
+		}
+	}
+	return nullptr;
+}
+
+void Node::ChildMap::insert(Node *p_child) {
+	if (!map && list.size() + 1 >= HASH_THRESHOLD) {
+		map = memnew((HashMap<StringName, Node *>));
+		for (Node *child : list) {
+			map->insert(child->data.name, child);
+		}
+		list.reset();
+	}
+	if (map) {
+		map->insert(p_child->data.name, p_child);
 	} else {
-		return nullptr;
+		list.push_back(p_child);
 	}
 }
 
+bool Node::ChildMap::erase(Node *p_child) {
+	if (!map) {
+		int64_t idx = list.find(p_child);
+		if (idx < 0) {
+			return false;
+		}
+		list.remove_at(idx); // Keep the insertion order.
+		return true;
+	}
+
+	if (!map->erase(p_child->data.name)) {
+		return false;
+	}
+	if (map->size() < HASH_THRESHOLD / 2) {
+		// Go back to the array, so nodes that had many children don't keep the table around.
+		list.reserve(map->size());
+		for (const KeyValue<StringName, Node *> &E : *map) {
+			list.push_back(E.value);
+		}
+		memdelete(map);
+		map = nullptr;
+	}
+	return true;
+}
+
+bool Node::ChildMap::rename(const StringName &p_old_name, Node *p_child) {
+	if (map) {
+		return map->replace_key(p_old_name, p_child->data.name);
+	}
+	// The array is searched by the current name of the children.
+	return list.has(p_child);
+}
+
+void Node::ChildMap::clear() {
+	if (map) {
+		memdelete(map);
+		map = nullptr;
+	}
+	list.reset();
+}
+
+Node::ChildMap::Iterator Node::ChildMap::_make_iterator(int32_t p_index) const {
+	Iterator it;
+	it.list = list.ptr();
+	it.index = p_index;
+	it.count = list.size();
+	return it;
+}
+
+Node::ChildMap::Iterator Node::ChildMap::begin() const {
+	if (!map) {
+		return _make_iterator(0);
+	}
+	Iterator it;
+	it.use_map = true;
+	it.map_iterator = map->begin();
+	return it;
+}
+
+Node::ChildMap::Iterator Node::ChildMap::end() const {
+	if (!map) {
+		return _make_iterator(list.size());
+	}
+	Iterator it;
+	it.use_map = true;
+	return it;
+}
+
+Node::ChildMap::Iterator Node::ChildMap::last() const {
+	if (!map) {
+		return _make_iterator(int32_t(list.size()) - 1);
+	}
+	Iterator it;
+	it.use_map = true;
+	it.map_iterator = map->last();
+	return it;
+}
+
+Node *Node::_get_child_by_name(const StringName &p_name) const {
+	return data.children.find(p_name);
+}
+
+SafeNumeric<uint64_t> Node::structure_version_counter;
+
+void Node::_structure_changed() {
+	// Every version is new, so a freed node can't be mistaken for the one that was cached at its address.
+	const uint64_t version = structure_version_counter.increment();
+	for (Node *node = this; node; node = node->data.parent) {
+		node->data.structure_version = version;
+	}
+}
+
+struct Node::NodePathCache {
+	static constexpr uint32_t ENTRY_COUNT = 4;
+
+	struct Entry {
+		NodePath path;
+		Node *node = nullptr;
+		// Topmost node the path walk visited, as reached by going up `top_distance` parents.
+		const Node *top = nullptr;
+		uint32_t top_distance = 0;
+		uint64_t top_version = 0;
+	};
+
+	Entry entries[ENTRY_COUNT];
+	uint32_t next_entry = 0;
+};
+
 Node *Node::get_node_or_null(const NodePath &p_path) const {
 	ERR_THREAD_GUARD_V(nullptr);
 	if (p_path.is_empty()) {
@@ -1927,6 +2137,49 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 
 	ERR_FAIL_COND_V_MSG(!data.tree && p_path.is_absolute(), nullptr, "Can't use get_node() with absolute paths from outside the active scene tree.");
 
+	if (!data.node_path_cache) {
+		// Most nodes resolve a path only once, only keep a cache for those that look up the same path again.
+		const uint32_t hash = p_path.hash();
+		if (hash != data.last_node_path_hash) {
+			data.last_node_path_hash = hash;
+			return _resolve_node_path(p_path);
+		}
+		data.node_path_cache = memnew(NodePathCache);
+	}
+
+	for (const NodePathCache::Entry &E : data.node_path_cache->entries) {
+		// Paths coming from the same constant share their data, making the comparison cheap.
+		if (E.top == nullptr || E.path != p_path) {
+			continue;
+		}
+		const Node *top = this;
+		for (uint32_t i = 0; i < E.top_distance && top; i++) {
+			top = top->data.parent;
+		}
+		if (top == E.top && top->data.structure_version == E.top_version) {
+			return E.node;
+		}
+	}
+
+	const Node *top = nullptr;
+	Node *node = _resolve_node_path(p_path, &top);
+
+	uint32_t top_distance = 0;
+	for (const Node *n = this; n != top; n = n->data.parent) {
+		top_distance++;
+	}
+
+	NodePathCache::Entry &entry = data.node_path_cache->entries[data.node_path_cache->next_entry];
+	data.node_path_cache->next_entry = (data.node_path_cache->next_entry + 1) % NodePathCache::ENTRY_COUNT;
+	entry.path = p_path;
+	entry.node = node;
+	entry.top = top;
+	entry.top_distance = top_distance;
+	entry.top_version = top->data.structure_version;
+	return node;
+}
+
+Node *Node::_resolve_node_path(const NodePath &p_path, const Node **r_top) const {
 	Node *current = nullptr;
 	Node *root = nullptr;
 
@@ -1939,6 +2192,12 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 		}
 	}
 
+	// The walk only reads nodes inside the subtree of `top`, which is always this node or one of its ancestors.
+	const Node *top = root ? root : this;
+	if (r_top) {
+		*r_top = top;
+	}
+
 	for (int i = 0; i < p_path.get_name_count(); i++) {
 		StringName name = p_path.get_name(i);
 		Node *next = nullptr;
@@ -1952,6 +2211,12 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 			}
 
 			next = current->data.parent;
+			if (current == top) {
+				top = next;
+				if (r_top) {
+					*r_top = top;
+				}
+			}
 		} else if (current == nullptr) {
 			if (name == root->get_name()) {
 				next = root;
@@ -1960,6 +2225,12 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 		} else if (name.is_node_unique_name()) {
 			Node **unique = current->data.owned_unique_nodes.getptr(name);
 			if (!unique && current->data.owner) {
+				if (current->data.owner->is_ancestor_of(top)) {
+					top = current->data.owner;
+					if (r_top) {
+						*r_top = top;
+					}
+				}
 				unique = current->data.owner->data.owned_unique_nodes.getptr(name);
 			}
 			if (!unique) {
@@ -1968,10 +2239,8 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 			next = *unique;
 		} else {
 			next = nullptr;
-			const Node *const *node = current->data.children.getptr(name);
-			if (node) {
-				next = const_cast<Node *>(*node);
-			} else {
+			next = current->data.children.find(name);
+			if (!next) {
 				return nullptr;
 			}
 		}
@@ -2232,8 +2501,8 @@ void Node::get_owned_by(Node *p_by, List<Node *> *p_owned) {
 		p_owned->push_back(this);
 	}
 
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		K.value->get_owned_by(p_by, p_owned);
+	for (Node *child : data.children) {
+		child->get_owned_by(p_by, p_owned);
 	}
 }
 
@@ -2246,6 +2515,7 @@ void Node::_set_owner_nocheck(Node *p_owner) {
 	data.owner = p_owner;
 	data.owner->data.owned.push_back(this);
 	data.OW = data.owner->data.owned.back();
+	_structure_changed(); // Unique names are looked up in the owner.
 
 	owner_changed_notify();
 }
@@ -2258,6 +2528,7 @@ void Node::_release_unique_name_in_owner() {
 		return; // Ignore.
 	}
 	data.owner->data.owned_unique_nodes.erase(key);
+	data.owner->_structure_changed();
 }
 
 void Node::_acquire_unique_name_in_owner() {
@@ -2272,6 +2543,7 @@ void Node::_acquire_unique_name_in_owner() {
 		return;
 	}
 	data.owner->data.owned_unique_nodes[key] = this;
+	data.owner->_structure_changed();
 }
 
 void Node::set_unique_name_in_owner(bool p_enabled) {
@@ -2335,6 +2607,7 @@ void Node::_clean_up_owner() {
 	data.owner->data.owned.erase(data.OW);
 	data.owner = nullptr;
 	data.OW = nullptr;
+	_structure_changed();
 }
 
 Node *Node::find_common_parent_with(const Node *p_node) const {
@@ -2608,8 +2881,8 @@ void Node::propagate_notification(int p_notification) {
 	data.blocked++;
 	notification(p_notification);
 
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		K.value->propagate_notification(p_notification);
+	for (Node *child : data.children) {
+		child->propagate_notification(p_notification);
 	}
 	data.blocked--;
 }
@@ -2622,8 +2895,8 @@ void Node::propagate_call(const StringName &p_method, const Array &p_args, const
 		callv(p_method, p_args);
 	}
 
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		K.value->propagate_call(p_method, p_args, p_parent_first);
+	for (Node *child : data.children) {
+		child->propagate_call(p_method, p_args, p_parent_first);
 	}
 
 	if (!p_parent_first && has_method(p_method)) {
@@ -2639,8 +2912,8 @@ void Node::_propagate_replace_owner(Node *p_owner, Node *p_by_owner) {
 	}
 
 	data.blocked++;
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		K.value->_propagate_replace_owner(p_owner, p_by_owner);
+	for (Node *child : data.children) {
+		child->_propagate_replace_owner(p_owner, p_by_owner);
 	}
 	data.blocked--;
 }
@@ -3532,8 +3805,8 @@ void Node::get_argument_options(const StringName &p_function, int p_idx, List<St
 
 void Node::clear_internal_tree_resource_paths() {
 	clear_internal_resource_paths();
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		K.value->clear_internal_tree_resource_paths();
+	for (Node *child : data.children) {
+		child->clear_internal_tree_resource_paths();
 	}
 }
 
@@ -4124,6 +4397,8 @@ Node::Node() {
 #ifdef DEBUG_ENABLED
 	total_node_count.increment();
 #endif
+	data.structure_version = structure_version_counter.increment();
+
 	// Default member initializer for bitfield is a C++20 extension, so:
 
 	data.process_mode = PROCESS_MODE_INHERIT;
@@ -4166,6 +4441,9 @@ Node::~Node() {
 	data.owned.clear();
 	data.children.clear();
 	data.children_cache.clear();
+	if (data.node_path_cache) {
+		memdelete(data.node_path_cache);
+	}
 
 	ERR_FAIL_COND(data.parent);
 	ERR_FAIL_COND(data.children_cache.size());
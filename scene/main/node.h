@@ -195,6 +195,74 @@ private:
 		bool operator()(const Node *p_a, const Node *p_b) const { return p_b->data.physics_process_priority == p_a->data.physics_process_priority ? p_b->is_greater_than(p_a) : p_b->data.physics_process_priority > p_a->data.physics_process_priority; }
 	};
 
+	// Recently resolved paths of get_node_or_null(), see _structure_changed().
+	struct NodePathCache;
+
+	// Children by name, iterated in insertion order. Most nodes have no or few children, so they are kept
+	// in a plain array searched by name, and only indexed by a hash map once there are HASH_THRESHOLD of them.
+	class ChildMap {
+		static constexpr uint32_t HASH_THRESHOLD = 8;
+
+		LocalVector<Node *> list;
+		HashMap<StringName, Node *> *map = nullptr;
+
+	public:
+		class Iterator {
+			friend class ChildMap;
+
+			Node *const *list = nullptr;
+			int32_t index = 0;
+			int32_t count = 0;
+			HashMap<StringName, Node *>::Iterator map_iterator;
+			bool use_map = false;
+
+		public:
+			_FORCE_INLINE_ Node *operator*() const { return use_map ? map_iterator->value : list[index]; }
+			_FORCE_INLINE_ Node *operator->() const { return operator*(); }
+			_FORCE_INLINE_ Iterator &operator++() {
+				if (use_map) {
+					++map_iterator;
+				} else {
+					index++;
+				}
+				return *this;
+			}
+			_FORCE_INLINE_ Iterator &operator--() {
+				if (use_map) {
+					--map_iterator;
+				} else {
+					index--;
+				}
+				return *this;
+			}
+
+			_FORCE_INLINE_ bool operator==(const Iterator &p_other) const { return use_map ? map_iterator == p_other.map_iterator : index == p_other.index; }
+			_FORCE_INLINE_ bool operator!=(const Iterator &p_other) const { return !operator==(p_other); }
+
+			_FORCE_INLINE_ explicit operator bool() const { return use_map ? bool(map_iterator) : (index >= 0 && index < count); }
+		};
+
+		_FORCE_INLINE_ uint32_t size() const { return map ? map->size() : list.size(); }
+		_FORCE_INLINE_ bool is_empty() const { return size() == 0; }
+
+		Node *find(const StringName &p_name) const;
+		void insert(Node *p_child);
+		bool erase(Node *p_child);
+		bool rename(const StringName &p_old_name, Node *p_child);
+		void clear();
+
+		Iterator begin() const;
+		Iterator end() const;
+		Iterator last() const;
+
+		ChildMap() {}
+		ChildMap(const ChildMap &) = delete;
+		~ChildMap() { clear(); }
+
+	private:
+		Iterator _make_iterator(int32_t p_index) const;
+	};
+
 	// This Data struct is to avoid namespace pollution in derived classes.
 	struct Data {
 		String scene_file_path;
@@ -203,10 +271,13 @@ private:
 
 		Node *parent = nullptr;
 		Node *owner = nullptr;
-		HashMap<StringName, Node *> children;
+		ChildMap children;
 		mutable bool children_cache_dirty = false;
 		mutable LocalVector<Node *> children_cache;
 		HashMap<StringName, Node *> owned_unique_nodes;
+		mutable NodePathCache *node_path_cache = nullptr;
+		mutable uint32_t last_node_path_hash = 0;
+		uint64_t structure_version = 0;
 		bool unique_name_in_owner = false;
 		InternalMode internal_mode = INTERNAL_MODE_DISABLED;
 		mutable int internal_children_front_count_cache = 0;
@@ -308,8 +379,17 @@ private:
 	void _validate_child_name(Node *p_child, bool p_force_human_readable = false);
 	void _generate_serial_child_name(const Node *p_child, StringName &name) const;
 
+	// Each node's structure_version changes whenever what a NodePath walking its subtree resolves to may change
+	// (children added, removed or renamed, parent, owner or unique names changed), so cached path resolutions
+	// are only used while the topmost node of their walk keeps the same version.
+	static SafeNumeric<uint64_t> structure_version_counter;
+	void _structure_changed();
+	Node *_resolve_node_path(const NodePath &p_path, const Node **r_top = nullptr) const;
+
 	void _propagate_enter_tree();
 	void _propagate_ready();
+	bool _can_propagate_ready_in_thread() const;
+	void _propagate_ready_thread(uint32_t p_index, Node **p_children);
 	void _propagate_exit_tree();
 	void _propagate_after_exit_tree();
 	void _propagate_physics_interpolated(bool p_interpolated);
@@ -338,6 +418,15 @@ private:
 	_FORCE_INLINE_ bool _can_process(bool p_paused) const;
 	_FORCE_INLINE_ bool _is_enabled() const;
 
+	// How SceneTree delivers NOTIFICATION_PROCESS and NOTIFICATION_PHYSICS_PROCESS to a node.
+	enum ProcessDispatch {
+		PROCESS_DISPATCH_NOTIFY, // Send the notification through the class and script chain.
+		PROCESS_DISPATCH_SCRIPT_CALLBACK, // Only the script's _process() or _physics_process() handles it.
+		PROCESS_DISPATCH_SKIP, // Nothing handles it.
+	};
+	ProcessDispatch _get_process_dispatch(bool p_physics) const;
+	void _call_process_callback(bool p_physics);
+
 	void _release_unique_name_in_owner();
 	void _acquire_unique_name_in_owner();
 
@@ -0,0 +1,268 @@
+/**************************************************************************/
+/*  node_pool.cpp                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "node_pool.h"
+
+#include "core/object/class_db.h"
+#include "scene/main/node.h"
+
+void NodePool::_record_defaults(Node *p_root, Node *p_node) {
+	NodeDefaults node_defaults;
+	node_defaults.path = p_root->get_path_to(p_node);
+
+	List<PropertyInfo> plist;
+	p_node->get_property_list(&plist);
+	for (const PropertyInfo &E : plist) {
+		if (!(E.usage & PROPERTY_USAGE_STORAGE) || E.name == CoreStringName(script)) {
+			continue;
+		}
+
+		Variant value = p_node->get(E.name);
+		switch (value.get_type()) {
+			case Variant::OBJECT: {
+				// Nodes and resources local to the instance can't be shared between pooled instances.
+				Ref<Resource> res = value;
+				if (res.is_null() || res->is_local_to_scene()) {
+					continue;
+				}
+			} break;
+			case Variant::ARRAY:
+			case Variant::DICTIONARY: {
+				// The instance keeps a reference to the container, don't let later edits leak in here.
+				value = value.duplicate(true);
+			} break;
+			default: {
+			}
+		}
+		node_defaults.properties.push_back(Pair<StringName, Variant>(E.name, value));
+	}
+
+	List<Node::GroupInfo> groups;
+	p_node->get_groups(&groups);
+	for (const Node::GroupInfo &E : groups) {
+		node_defaults.groups.push_back(Pair<StringName, bool>(E.name, E.persistent));
+	}
+
+	for (int i = 0; i < p_node->get_child_count(false); i++) {
+		node_defaults.children.push_back(p_node->get_child(i, false)->get_name());
+	}
+	defaults.push_back(node_defaults);
+
+	for (int i = 0; i < p_node->get_child_count(false); i++) {
+		_record_defaults(p_root, p_node->get_child(i, false));
+	}
+}
+
+void NodePool::_reset_to_defaults(Node *p_root) const {
+	for (const NodeDefaults &node_defaults : defaults) {
+		Node *node = p_root->get_node_or_null(node_defaults.path);
+		if (!node) {
+			// Removed by the user while the instance was in use.
+			continue;
+		}
+
+		// Children added while the instance was in use are freed, like they would be with the instance.
+		for (int i = node->get_child_count(false) - 1; i >= 0; i--) {
+			Node *child = node->get_child(i, false);
+			if (!node_defaults.children.has(child->get_name())) {
+				node->remove_child(child);
+				child->queue_free();
+			}
+		}
+
+		List<Node::GroupInfo> groups;
+		node->get_groups(&groups);
+		for (const Node::GroupInfo &E : groups) {
+			bool recorded = false;
+			for (const Pair<StringName, bool> &F : node_defaults.groups) {
+				if (F.first == E.name) {
+					recorded = true;
+					break;
+				}
+			}
+			if (!recorded) {
+				node->remove_from_group(E.name);
+			}
+		}
+		for (const Pair<StringName, bool> &E : node_defaults.groups) {
+			if (!node->is_in_group(E.first)) {
+				node->add_to_group(E.first, E.second);
+			}
+		}
+
+		for (const Pair<StringName, Variant> &E : node_defaults.properties) {
+			bool valid = false;
+			const Variant current = node->get(E.first, &valid);
+			if (valid && current == E.second) {
+				continue;
+			}
+
+			if (E.second.get_type() == Variant::ARRAY || E.second.get_type() == Variant::DICTIONARY) {
+				node->set(E.first, E.second.duplicate(true));
+			} else {
+				node->set(E.first, E.second);
+			}
+		}
+	}
+}
+
+void NodePool::_push_available(Node *p_node) {
+	available.push_back(p_node->get_instance_id());
+	available_set.insert(p_node->get_instance_id());
+}
+
+ObjectID NodePool::_pop_available() {
+	const ObjectID id = available[available.size() - 1];
+	available.remove_at(available.size() - 1);
+	available_set.erase(id);
+	return id;
+}
+
+void NodePool::setup(const Ref<PackedScene> &p_scene, int p_size) {
+	ERR_FAIL_COND(p_scene.is_null());
+	ERR_FAIL_COND_MSG(scene.is_valid(), "NodePool is already set up.");
+	ERR_FAIL_COND(p_size < 0);
+
+	scene = p_scene;
+	max_size = p_size;
+
+	Node *first = scene->instantiate();
+	ERR_FAIL_NULL_MSG(first, "Failed to instantiate the scene for the pool.");
+	_record_defaults(first, first);
+
+	if (max_size == 0) {
+		memdelete(first);
+		return;
+	}
+
+	available.reserve(max_size);
+	available_set.reserve(max_size);
+	_push_available(first);
+	for (int i = 1; i < max_size; i++) {
+		Node *node = scene->instantiate();
+		ERR_BREAK(!node);
+		_push_available(node);
+	}
+}
+
+Ref<PackedScene> NodePool::get_scene() const {
+	return scene;
+}
+
+void NodePool::set_max_size(int p_max_size) {
+	ERR_FAIL_COND(p_max_size < 0);
+	max_size = p_max_size;
+
+	while ((int)available.size() > max_size) {
+		Node *node = ObjectDB::get_instance<Node>(_pop_available());
+		if (node) {
+			memdelete(node);
+		}
+	}
+}
+
+int NodePool::get_max_size() const {
+	return max_size;
+}
+
+Node *NodePool::acquire() {
+	ERR_FAIL_COND_V_MSG(scene.is_null(), nullptr, "NodePool was not set up, use SceneTree.create_node_pool() to create it.");
+
+	while (!available.is_empty()) {
+		Node *node = ObjectDB::get_instance<Node>(_pop_available());
+		if (node && !node->is_queued_for_deletion()) {
+			hit_count++;
+			total_hit_count.increment();
+			return node;
+		}
+	}
+
+	miss_count++;
+	total_miss_count.increment();
+	return scene->instantiate();
+}
+
+void NodePool::release(Node *p_node) {
+	ERR_FAIL_NULL(p_node);
+	ERR_FAIL_COND(scene.is_null());
+	ERR_FAIL_COND_MSG(!p_node->get_scene_file_path().is_empty() && p_node->get_scene_file_path() != scene->get_path(), "Node was not instantiated from the scene of this pool.");
+	ERR_FAIL_COND_MSG(available_set.has(p_node->get_instance_id()), "Node was already released to the pool.");
+
+	Node *parent = p_node->get_parent();
+	if (parent) {
+		parent->remove_child(p_node);
+		ERR_FAIL_COND_MSG(p_node->get_parent(), "Node could not be removed from its parent, try releasing it with call_deferred().");
+	}
+
+	if ((int)available.size() >= max_size) {
+		// The caller may be running inside one of the node's own methods.
+		p_node->queue_free();
+		return;
+	}
+
+	_reset_to_defaults(p_node);
+	// Run _ready() again the next time the node enters the tree, like a fresh instance would.
+	p_node->request_ready();
+	_push_available(p_node);
+}
+
+int NodePool::get_available_count() const {
+	return available.size();
+}
+
+uint64_t NodePool::get_hit_count() const {
+	return hit_count;
+}
+
+uint64_t NodePool::get_miss_count() const {
+	return miss_count;
+}
+
+void NodePool::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("get_scene"), &NodePool::get_scene);
+	ClassDB::bind_method(D_METHOD("set_max_size", "max_size"), &NodePool::set_max_size);
+	ClassDB::bind_method(D_METHOD("get_max_size"), &NodePool::get_max_size);
+	ClassDB::bind_method(D_METHOD("acquire"), &NodePool::acquire);
+	ClassDB::bind_method(D_METHOD("release", "node"), &NodePool::release);
+	ClassDB::bind_method(D_METHOD("get_available_count"), &NodePool::get_available_count);
+	ClassDB::bind_method(D_METHOD("get_hit_count"), &NodePool::get_hit_count);
+	ClassDB::bind_method(D_METHOD("get_miss_count"), &NodePool::get_miss_count);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_size", PROPERTY_HINT_RANGE, "0,4096,1,or_greater"), "set_max_size", "get_max_size");
+}
+
+NodePool::~NodePool() {
+	for (const ObjectID &id : available) {
+		Node *node = ObjectDB::get_instance<Node>(id);
+		if (node) {
+			memdelete(node);
+		}
+	}
+}
@@ -0,0 +1,92 @@
+/**************************************************************************/
+/*  node_pool.h                                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/ref_counted.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
+#include "scene/resources/packed_scene.h"
+
+class Node;
+
+class NodePool : public RefCounted {
+	GDCLASS(NodePool, RefCounted);
+
+	// Property values, groups and children of one node of the scene, as found right after instantiation.
+	struct NodeDefaults {
+		NodePath path; // Relative to the instance root.
+		LocalVector<Pair<StringName, Variant>> properties;
+		LocalVector<Pair<StringName, bool>> groups; // Name and whether the group is persistent.
+		LocalVector<StringName> children;
+	};
+
+	Ref<PackedScene> scene;
+	LocalVector<NodeDefaults> defaults;
+	LocalVector<ObjectID> available;
+	HashSet<ObjectID> available_set; // Same instances as `available`, to find released ones quickly.
+	int max_size = 0;
+
+	uint64_t hit_count = 0;
+	uint64_t miss_count = 0;
+
+	static inline SafeNumeric<uint64_t> total_hit_count{ 0 };
+	static inline SafeNumeric<uint64_t> total_miss_count{ 0 };
+
+	void _record_defaults(Node *p_root, Node *p_node);
+	void _reset_to_defaults(Node *p_root) const;
+
+	void _push_available(Node *p_node);
+	ObjectID _pop_available();
+
+protected:
+	static void _bind_methods();
+
+public:
+	void setup(const Ref<PackedScene> &p_scene, int p_size);
+	Ref<PackedScene> get_scene() const;
+
+	void set_max_size(int p_max_size);
+	int get_max_size() const;
+
+	Node *acquire();
+	void release(Node *p_node);
+
+	int get_available_count() const;
+	uint64_t get_hit_count() const;
+	uint64_t get_miss_count() const;
+
+	static uint64_t get_total_hit_count() { return total_hit_count.get(); }
+	static uint64_t get_total_miss_count() { return total_miss_count.get(); }
+
+	~NodePool();
+};
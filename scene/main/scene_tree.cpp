@@ -47,6 +47,7 @@ STATIC_ASSERT_INCOMPLETE_TYPE(class, RenderingServer);
 #include "scene/gui/control.h"
 #include "scene/main/multiplayer_api.h"
 #include "scene/main/node.h"
+#include "scene/main/node_pool.h"
 #include "scene/main/viewport.h"
 #include "scene/main/window.h"
 #include "scene/resources/environment.h"
@@ -180,8 +181,8 @@ SceneTreeGroup *SceneTree::add_to_group(const StringName &p_group, Node *p_node)
 	}
 
 	ERR_FAIL_COND_V_MSG(E->value.nodes.has(p_node), &E->value, "Already in group: " + p_group + ".");
+	// Appended after the sorted part, _update_group_order() merges it in.
 	E->value.nodes.push_back(p_node);
-	E->value.changed = true;
 	return &E->value;
 }
 
@@ -191,8 +192,15 @@ void SceneTree::remove_from_group(const StringName &p_group, Node *p_node) {
 	HashMap<StringName, SceneTreeGroup>::Iterator E = group_map.find(p_group);
 	ERR_FAIL_COND(!E);
 
-	E->value.nodes.erase(p_node);
-	if (E->value.nodes.is_empty()) {
+	SceneTreeGroup &g = E->value;
+	int index = g.nodes.find(p_node);
+	ERR_FAIL_COND(index == -1);
+	// Removing keeps the relative order of the remaining nodes.
+	g.nodes.remove_at(index);
+	if (index < g.sorted_count) {
+		g.sorted_count--;
+	}
+	if (g.nodes.is_empty()) {
 		group_map.remove(E);
 	}
 }
@@ -338,26 +346,82 @@ void SceneTree::_flush_ugc() {
 }
 
 void SceneTree::_update_group_order(SceneTreeGroup &g) {
-	if (!g.changed) {
+	int gr_node_count = g.nodes.size();
+	if (!g.changed && g.sorted_count == gr_node_count) {
 		return;
 	}
-	if (g.nodes.is_empty()) {
+	if (gr_node_count == 0) {
+		g.sorted_count = 0;
+		g.changed = false;
 		return;
 	}
 
 	Node **gr_nodes = g.nodes.ptrw();
-	int gr_node_count = g.nodes.size();
-
 	SortArray<Node *, Node::Comparator> node_sort;
-	node_sort.sort(gr_nodes, gr_node_count);
 
-	g.changed = false;
+	if (g.changed || g.sorted_count == 0) {
+		node_sort.sort(gr_nodes, gr_node_count);
+		g.sorted_count = gr_node_count;
+		g.changed = false;
+		return;
+	}
+
+	// Only nodes were added since the last sort: sort the new ones and merge them
+	// into the sorted part, instead of sorting the whole (possibly large) group again.
+	int sorted_count = g.sorted_count;
+	node_sort.sort(gr_nodes + sorted_count, gr_node_count - sorted_count);
+	g.sorted_count = gr_node_count;
+
+	Node::Comparator compare;
+	if (!compare(gr_nodes[sorted_count], gr_nodes[sorted_count - 1])) {
+		return; // Already in order, common when adding new nodes at the end of the tree.
+	}
+
+	LocalVector<Node *> sorted;
+	sorted.resize(sorted_count);
+	memcpy(sorted.ptr(), gr_nodes, sorted_count * sizeof(Node *));
+
+	int a = 0;
+	int b = sorted_count;
+	int to = 0;
+	while (a < sorted_count && b < gr_node_count) {
+		if (compare(gr_nodes[b], sorted[a])) {
+			gr_nodes[to++] = gr_nodes[b++];
+		} else {
+			gr_nodes[to++] = sorted[a++];
+		}
+	}
+	while (a < sorted_count) {
+		gr_nodes[to++] = sorted[a++];
+	}
 }
 
 RequiredResult<Window> SceneTree::get_root() const {
 	return root;
 }
 
+// Groups usually hold many nodes of only a few classes, so look up the native
+// method once per class instead of once per node.
+struct GroupCallMethodCache {
+	StringName method;
+	LocalVector<Pair<StringName, MethodBind *>> binds;
+
+	MethodBind *get(const Object *p_object) {
+		const StringName &class_name = p_object->get_class_name();
+		for (const Pair<StringName, MethodBind *> &E : binds) {
+			if (E.first == class_name) {
+				return E.second;
+			}
+		}
+		MethodBind *bind = ClassDB::get_method(class_name, method);
+		binds.push_back(Pair<StringName, MethodBind *>(class_name, bind));
+		return bind;
+	}
+
+	GroupCallMethodCache(const StringName &p_method) :
+			method(p_method) {}
+};
+
 void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_group, const StringName &p_function, const Variant **p_args, int p_argcount) {
 	Vector<Node *> nodes_copy;
 
@@ -399,6 +463,7 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 
 	Node **gr_nodes = nodes_copy.ptrw();
 	int gr_node_count = nodes_copy.size();
+	GroupCallMethodCache method_cache(p_function);
 
 	{
 		_THREAD_SAFE_METHOD_
@@ -414,7 +479,7 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 			Node *node = gr_nodes[i];
 			if (!(p_call_flags & GROUP_CALL_DEFERRED)) {
 				Callable::CallError ce;
-				node->callp(p_function, p_args, p_argcount, ce);
+				node->callp_with_method_bind(method_cache.get(node), p_function, p_args, p_argcount, ce);
 				if (unlikely(ce.error != Callable::CallError::CALL_OK && ce.error != Callable::CallError::CALL_ERROR_INVALID_METHOD)) {
 					ERR_PRINT(vformat("Error calling group method on node \"%s\": %s.", node->get_name(), Variant::get_callable_error_text(Callable(node, p_function), p_args, p_argcount, ce)));
 				}
@@ -432,7 +497,7 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 			Node *node = gr_nodes[i];
 			if (!(p_call_flags & GROUP_CALL_DEFERRED)) {
 				Callable::CallError ce;
-				node->callp(p_function, p_args, p_argcount, ce);
+				node->callp_with_method_bind(method_cache.get(node), p_function, p_args, p_argcount, ce);
 				if (unlikely(ce.error != Callable::CallError::CALL_OK && ce.error != Callable::CallError::CALL_ERROR_INVALID_METHOD)) {
 					ERR_PRINT(vformat("Error calling group method on node \"%s\": %s.", node->get_name(), Variant::get_callable_error_text(Callable(node, p_function), p_args, p_argcount, ce)));
 				}
@@ -1180,6 +1245,47 @@ bool SceneTree::is_suspended() const {
 	return suspended;
 }
 
+// Caches how the process notifications are dispatched for each class and script
+// combination seen during a process pass, as most nodes share them.
+struct SceneTree::ProcessDispatchCache {
+	struct Entry {
+		const GDType *type = nullptr;
+		const ObjectGDExtension *extension = nullptr;
+		const Script *script = nullptr;
+		Node::ProcessDispatch dispatch = Node::PROCESS_DISPATCH_NOTIFY;
+	};
+
+	LocalVector<Entry> entries;
+	bool physics = false;
+
+	Node::ProcessDispatch get(const Node *p_node) {
+		const GDType *type = &p_node->get_gdtype();
+		if (type != &Node::get_gdtype_static()) {
+			return Node::PROCESS_DISPATCH_NOTIFY; // Fast exit, derived classes always need the notification.
+		}
+
+		const ScriptInstance *si = p_node->get_script_instance();
+		const Script *script = si ? si->get_script().ptr() : nullptr;
+		const ObjectGDExtension *extension = p_node->_get_extension();
+		for (const Entry &E : entries) {
+			if (E.type == type && E.script == script && E.extension == extension) {
+				return E.dispatch;
+			}
+		}
+
+		Entry entry;
+		entry.type = type;
+		entry.extension = extension;
+		entry.script = script;
+		entry.dispatch = p_node->_get_process_dispatch(physics);
+		entries.push_back(entry);
+		return entry.dispatch;
+	}
+
+	ProcessDispatchCache(bool p_physics) :
+			physics(p_physics) {}
+};
+
 void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
 	// When reading this function, keep in mind that this code must work in a way where
 	// if any node is removed, this needs to continue working.
@@ -1208,10 +1314,12 @@ void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
 
 	uint32_t node_count = nodes_copy.size();
 	Node **nodes_ptr = (Node **)nodes_copy.ptr(); // Force cast, pointer will not change.
+	ProcessDispatchCache dispatch_cache(p_physics);
+	const int process_notification = p_physics ? Node::NOTIFICATION_PHYSICS_PROCESS : Node::NOTIFICATION_PROCESS;
 
 	for (uint32_t i = 0; i < node_count; i++) {
 		Node *n = nodes_ptr[i];
-		if (nodes_removed_on_group_call.has(n)) {
+		if (!nodes_removed_on_group_call.is_empty() && nodes_removed_on_group_call.has(n)) {
 			// Node may have been removed during process, skip it.
 			// Keep in mind removals can only happen on the main thread.
 			continue;
@@ -1221,20 +1329,32 @@ void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
 			continue;
 		}
 
+		bool processing;
 		if (p_physics) {
 			if (n->is_physics_processing_internal()) {
 				n->notification(Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
 			}
-			if (n->is_physics_processing()) {
-				n->notification(Node::NOTIFICATION_PHYSICS_PROCESS);
-			}
+			processing = n->is_physics_processing();
 		} else {
 			if (n->is_processing_internal()) {
 				n->notification(Node::NOTIFICATION_INTERNAL_PROCESS);
 			}
-			if (n->is_processing()) {
-				n->notification(Node::NOTIFICATION_PROCESS);
-			}
+			processing = n->is_processing();
+		}
+
+		if (!processing) {
+			continue;
+		}
+
+		switch (dispatch_cache.get(n)) {
+			case Node::PROCESS_DISPATCH_NOTIFY: {
+				n->notification(process_notification);
+			} break;
+			case Node::PROCESS_DISPATCH_SCRIPT_CALLBACK: {
+				n->_call_process_callback(p_physics);
+			} break;
+			case Node::PROCESS_DISPATCH_SKIP: {
+			} break;
 		}
 	}
 
@@ -1787,6 +1907,15 @@ RequiredResult<Tween> SceneTree::create_tween() {
 	return tween;
 }
 
+Ref<NodePool> SceneTree::create_node_pool(const Ref<PackedScene> &p_scene, int p_size) {
+	_THREAD_SAFE_METHOD_
+	ERR_FAIL_COND_V(p_scene.is_null(), Ref<NodePool>());
+	Ref<NodePool> pool;
+	pool.instantiate();
+	pool->setup(p_scene, p_size);
+	return pool;
+}
+
 void SceneTree::remove_tween(const Ref<Tween> &p_tween) {
 	_THREAD_SAFE_METHOD_
 	for (List<Ref<Tween>>::Element *E = tweens.back(); E; E = E->prev()) {
@@ -1916,6 +2045,7 @@ void SceneTree::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("create_timer", "time_sec", "process_always", "process_in_physics", "ignore_time_scale"), &SceneTree::create_timer, DEFVAL(true), DEFVAL(false), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("create_tween"), &SceneTree::create_tween);
+	ClassDB::bind_method(D_METHOD("create_node_pool", "scene", "size"), &SceneTree::create_node_pool);
 	ClassDB::bind_method(D_METHOD("get_processed_tweens"), &SceneTree::get_processed_tweens);
 
 	ClassDB::bind_method(D_METHOD("get_node_count"), &SceneTree::get_node_count);
@@ -2045,6 +2175,10 @@ void SceneTree::get_argument_options(const StringName &p_function, int p_idx, Li
 }
 #endif
 
+void SceneTree::set_parallel_ready_enabled(bool p_enabled) {
+	parallel_ready = p_enabled;
+}
+
 void SceneTree::set_disable_node_threading(bool p_disable) {
 	node_threading_disabled = p_disable;
 }
@@ -2091,6 +2225,9 @@ SceneTree::SceneTree() {
 
 	set_physics_interpolation_enabled(GLOBAL_DEF("physics/common/physics_interpolation", false));
 
+	// Tool scripts in the editor are not expected to run on worker threads.
+	parallel_ready = GLOBAL_DEF("threading/scene/parallel_ready", false) && !Engine::get_singleton()->is_editor_hint();
+
 	// Always disable jitter fix if physics interpolation is enabled -
 	// Jitter fix will interfere with interpolation, and is not necessary
 	// when interpolation is active.
@@ -45,6 +45,7 @@ class InputEvent;
 class Material;
 class MultiplayerAPI;
 class Node;
+class NodePool;
 class PackedScene;
 class Tween;
 class Viewport;
@@ -83,6 +84,9 @@ public:
 
 struct SceneTreeGroup {
 	Vector<Node *> nodes;
+	// Nodes before this index are in tree order, the ones after it were added since the last sort.
+	int sorted_count = 0;
+	// Set when nodes were moved in the tree, so the whole group must be sorted again.
 	bool changed = false;
 };
 
@@ -122,6 +126,7 @@ private:
 	ProcessGroup default_process_group;
 
 	bool node_threading_disabled = false;
+	bool parallel_ready = false;
 
 #ifndef _3D_DISABLED
 	struct ClientPhysicsInterpolation {
@@ -237,6 +242,7 @@ private:
 	SceneTreeGroup *add_to_group(const StringName &p_group, Node *p_node);
 	void remove_from_group(const StringName &p_group, Node *p_node);
 
+	struct ProcessDispatchCache;
 	void _process_group(ProcessGroup *p_group, bool p_physics);
 	void _process_groups_thread(uint32_t p_index, bool p_physics);
 	void _process(bool p_physics);
@@ -432,6 +438,7 @@ public:
 
 	RequiredResult<SceneTreeTimer> create_timer(double p_delay_sec, bool p_process_always = true, bool p_process_in_physics = false, bool p_ignore_time_scale = false);
 	RequiredResult<Tween> create_tween();
+	Ref<NodePool> create_node_pool(const Ref<PackedScene> &p_scene, int p_size);
 	void remove_tween(const Ref<Tween> &p_tween);
 	TypedArray<Tween> get_processed_tweens();
 
@@ -454,6 +461,8 @@ public:
 	static void add_idle_callback(IdleCallback p_callback);
 
 	void set_disable_node_threading(bool p_disable);
+	void set_parallel_ready_enabled(bool p_enabled);
+	_FORCE_INLINE_ bool is_parallel_ready_enabled() const { return parallel_ready && !node_threading_disabled; }
 	//default texture settings
 
 	void set_physics_interpolation_enabled(bool p_enabled);
@@ -272,6 +272,15 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 	bool deep_search_warned = false;
 
+	// Only at runtime, the editor can reload extension classes under our feet.
+	const PlannedSetter *plan = nullptr;
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && !Engine::get_singleton()->is_editor_hint()) {
+		if (!instantiation_plan_ready.is_set()) {
+			_build_instantiation_plan();
+		}
+		plan = instantiation_plan.ptr();
+	}
+
 	for (int i = 0; i < nc; i++) {
 		const NodeData &n = nd[i];
 
@@ -298,6 +307,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 		Node *node = nullptr;
 		MissingNode *missing_node = nullptr;
 		bool is_inherited_scene = false;
+		bool is_planned_type = false; // Created as the type the plan was resolved for.
 
 		if (i == 0 && base_scene_idx >= 0) {
 			// Scene inheritance on root node.
@@ -391,6 +401,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			Object *obj = ClassDB::instantiate(snames[n.type]);
 
 			node = Object::cast_to<Node>(obj);
+			is_planned_type = node != nullptr;
 
 			if (!node) {
 				if (obj) {
@@ -438,6 +449,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			int nprop_count = n.properties.size();
 			if (nprop_count) {
 				const NodeData::Property *nprops = &n.properties[0];
+				const PlannedSetter *node_plan = (plan && is_planned_type) ? &plan[instantiation_plan_offsets[i]] : nullptr;
 
 				Dictionary missing_resource_properties;
 
@@ -564,7 +576,12 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 						}
 
 						if (set_valid) {
-							node->set(snames[nprops[j].name], value, &valid);
+							// Scripts and extensions get the first say in Object::set(), only skip it without them.
+							if (node_plan && node_plan[j].valid && !node->get_script_instance() && !node->_get_extension()) {
+								ClassDB::set_property_with_setget(node, node_plan[j].setget, value, &valid);
+							} else {
+								node->set(snames[nprops[j].name], value, &valid);
+							}
 						}
 						if (p_edit_state == GEN_EDIT_STATE_INSTANCE && value.get_type() != Variant::OBJECT) {
 							value = value.duplicate(true); // Duplicate arrays and dictionaries for the editor.
@@ -773,6 +790,41 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	return ret_nodes[0];
 }
 
+void SceneState::_build_instantiation_plan() const {
+	MutexLock lock(instantiation_plan_mutex);
+	if (instantiation_plan_ready.is_set()) {
+		return;
+	}
+
+	instantiation_plan.clear();
+	instantiation_plan_offsets.resize(nodes.size());
+
+	for (int i = 0; i < nodes.size(); i++) {
+		const NodeData &n = nodes[i];
+		instantiation_plan_offsets[i] = instantiation_plan.size();
+
+		// Only nodes created from their type here, instances set their properties on another class.
+		bool created = n.type != TYPE_INSTANTIATED && n.instance < 0 && !(i == 0 && base_scene_idx >= 0) && n.type >= 0 && n.type < names.size();
+
+		for (const NodeData::Property &prop : n.properties) {
+			PlannedSetter setter;
+			if (created && !(prop.name & FLAG_PATH_PROPERTY_IS_NODE) && prop.name >= 0 && prop.name < names.size()) {
+				setter.valid = ClassDB::get_property_setget(names[n.type], names[prop.name], setter.setget);
+			}
+			instantiation_plan.push_back(setter);
+		}
+	}
+
+	instantiation_plan_ready.set();
+}
+
+void SceneState::_clear_instantiation_plan() {
+	MutexLock lock(instantiation_plan_mutex);
+	instantiation_plan_ready.clear();
+	instantiation_plan.clear();
+	instantiation_plan_offsets.clear();
+}
+
 Variant SceneState::make_local_resource(Variant &p_value, const SceneState::NodeData &p_node_data, HashMap<Node *, HashMap<Ref<Resource>, Ref<Resource>>> &p_resources_local_to_scenes, Node *p_node, const StringName p_sname, int p_i, Node **p_ret_nodes, SceneState::GenEditState p_edit_state) const {
 	Ref<Resource> res = p_value;
 	if (res.is_null() || !res->is_local_to_scene()) {
@@ -1508,6 +1560,7 @@ String SceneState::get_path() const {
 }
 
 void SceneState::clear() {
+	_clear_instantiation_plan();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1742,6 +1795,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 
 	ERR_FAIL_COND_MSG(version > PACKED_SCENE_VERSION, "Save format version too new.");
 
+	_clear_instantiation_plan();
+
 	const int node_count = p_dictionary["node_count"];
 	const Vector<int> snodes = p_dictionary["nodes"];
 	ERR_FAIL_COND(snodes.size() < node_count);
@@ -2395,6 +2450,7 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
 	nd.index = p_index;
 
 	nodes.push_back(nd);
+	_clear_instantiation_plan();
 
 	ids.push_back(p_unique_id);
 
@@ -2413,6 +2469,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 	}
 	prop.value = p_value;
 	nodes.write[p_node].properties.push_back(prop);
+	_clear_instantiation_plan();
 }
 
 void SceneState::add_node_group(int p_node, int p_group) {
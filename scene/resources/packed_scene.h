@@ -31,6 +31,8 @@
 #pragma once
 
 #include "core/io/resource.h"
+#include "core/object/class_db.h"
+#include "core/templates/local_vector.h"
 #include "scene/main/node.h"
 
 class PackedScene;
@@ -92,6 +94,20 @@ class SceneState : public RefCounted {
 
 	Vector<ConnectionData> connections;
 
+	// Built-in setters of node properties, resolved once so runtime instantiation doesn't
+	// look each property up through the class hierarchy again for every instance.
+	struct PlannedSetter {
+		ClassDB::PropertySetGet setget;
+		bool valid = false; // Otherwise, go through Object::set().
+	};
+	mutable LocalVector<PlannedSetter> instantiation_plan; // Flattened node properties, in node order.
+	mutable LocalVector<uint32_t> instantiation_plan_offsets; // First property of each node.
+	mutable SafeFlag instantiation_plan_ready;
+	mutable BinaryMutex instantiation_plan_mutex;
+
+	void _build_instantiation_plan() const;
+	void _clear_instantiation_plan();
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, HashMap<StringName, int> &name_map, HashMap<Variant, int> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map, HashSet<int32_t> &ids_saved);
 	Error _parse_connections(Node *p_owner, Node *p_node, HashMap<StringName, int> &name_map, HashMap<Variant, int> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 
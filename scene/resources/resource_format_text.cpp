@@ -32,9 +32,11 @@
 
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/missing_resource.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "scene/property_utils.h"
 
 void ResourceLoaderText::_printerr() {
@@ -123,6 +125,38 @@ Error ResourceLoaderText::_parse_sub_resource(VariantParser::Stream *p_stream, R
 	return OK;
 }
 
+Error ResourceLoaderText::_resolve_ext_resource(const String &p_id, Ref<Resource> &r_res) {
+	ExtResource *ext_resource = ext_resources.getptr(p_id);
+	ERR_FAIL_NULL_V(ext_resource, ERR_INVALID_PARAMETER);
+
+	if (!ext_resource->resolved) {
+		ext_resource->resolved = true;
+
+		if (ext_resource->load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
+			Error err = OK;
+			Ref<Resource> res = ResourceLoader::_load_complete(*ext_resource->load_token.ptr(), &err);
+			if (res.is_null()) {
+				if (!ResourceLoader::is_cleaning_tasks()) {
+					if (ResourceLoader::get_abort_on_missing_resources()) {
+						error = ERR_FILE_MISSING_DEPENDENCIES;
+						error_text = "[ext_resource] referenced non-existent resource at: " + ext_resource->path;
+						_printerr();
+						err = error;
+					} else {
+						ResourceLoader::notify_dependency_error(local_path, ext_resource->path, ext_resource->type);
+					}
+				}
+			} else {
+				ext_resource->resource = res;
+			}
+			ext_resource->resolve_error = err;
+		}
+	}
+
+	r_res = ext_resource->resource;
+	return ext_resource->resolve_error;
+}
+
 Error ResourceLoaderText::_parse_ext_resource(VariantParser::Stream *p_stream, Ref<Resource> &r_res, int &line, String &r_err_str) {
 	VariantParser::Token token;
 	VariantParser::get_token(p_stream, token, line, r_err_str);
@@ -140,29 +174,7 @@ Error ResourceLoaderText::_parse_ext_resource(VariantParser::Stream *p_stream, R
 			return ERR_PARSE_ERROR;
 		}
 
-		String path = ext_resources[id].path;
-		String type = ext_resources[id].type;
-		Ref<ResourceLoader::LoadToken> &load_token = ext_resources[id].load_token;
-
-		if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
-			Ref<Resource> res = ResourceLoader::_load_complete(*load_token.ptr(), &err);
-			if (res.is_null()) {
-				if (!ResourceLoader::is_cleaning_tasks()) {
-					if (ResourceLoader::get_abort_on_missing_resources()) {
-						error = ERR_FILE_MISSING_DEPENDENCIES;
-						error_text = "[ext_resource] referenced non-existent resource at: " + path;
-						_printerr();
-						err = error;
-					} else {
-						ResourceLoader::notify_dependency_error(local_path, path, type);
-					}
-				}
-			} else {
-				r_res = res;
-			}
-		} else {
-			r_res = Ref<Resource>();
-		}
+		err = _resolve_ext_resource(id, r_res);
 #ifdef TOOLS_ENABLED
 		if (r_res.is_null()) {
 			// Hack to allow checking original path.
@@ -420,6 +432,111 @@ Ref<PackedScene> ResourceLoaderText::_parse_node_tag(VariantParser::ResourcePars
 	}
 }
 
+Error ResourceLoaderText::_create_sub_resource(const String &p_type, const String &p_id, Ref<Resource> &r_res, Ref<MissingResource> &r_missing_resource, bool &r_do_assign, bool &r_reset_state) {
+	String path = local_path + "::" + p_id;
+
+	r_do_assign = false;
+	r_reset_state = false;
+
+	if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
+		//reuse existing
+		Ref<Resource> cache = ResourceCache::get_ref(path);
+		if (cache.is_valid() && cache->get_class() == p_type) {
+			r_res = cache;
+			r_reset_state = true;
+			r_do_assign = true;
+		}
+	}
+
+	if (r_res.is_null()) { //not reuse
+		Ref<Resource> cache = ResourceCache::get_ref(path);
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && cache.is_valid()) { //only if it doesn't exist
+			//cached, do not assign
+			r_res = cache;
+		} else {
+			//create
+
+			Object *obj = ClassDB::instantiate(p_type);
+			if (!obj) {
+				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+					r_missing_resource = memnew(MissingResource);
+					r_missing_resource->set_original_class(p_type);
+					r_missing_resource->set_recording_properties(true);
+					obj = r_missing_resource.ptr();
+				} else {
+					error_text = vformat("Can't create sub resource of type '%s'", p_type);
+					return ERR_FILE_CORRUPT;
+				}
+			}
+
+			Resource *r = Object::cast_to<Resource>(obj);
+			if (!r) {
+				error_text = vformat("Can't create sub resource of type '%s' as it's not a resource type", p_type);
+				return ERR_FILE_CORRUPT;
+			}
+
+			r_res = Ref<Resource>(r);
+			r_do_assign = true;
+		}
+	}
+
+	return OK;
+}
+
+void ResourceLoaderText::_register_sub_resource(const String &p_id, const Ref<Resource> &p_res, bool p_do_assign) {
+	int_resources[p_id] = p_res; // Always assign int resources.
+	if (p_do_assign) {
+		String path = local_path + "::" + p_id;
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+			p_res->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE);
+		} else {
+			p_res->set_path_cache(path);
+		}
+		p_res->set_scene_unique_id(p_id);
+	}
+}
+
+void ResourceLoaderText::_set_resource_property(const Ref<Resource> &p_res, const Ref<MissingResource> &p_missing_resource, const String &p_name, Variant &p_value, Dictionary &r_missing_resource_properties) {
+	if (p_value.get_type() == Variant::OBJECT && p_missing_resource.is_null() && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+		// If the property being set is a missing resource (and the parent is not),
+		// then setting it will most likely not work.
+		// Instead, save it as metadata.
+
+		Ref<MissingResource> mr = p_value;
+		if (mr.is_valid()) {
+			r_missing_resource_properties[p_name] = mr;
+			return;
+		}
+	}
+
+	if (p_value.get_type() == Variant::ARRAY) {
+		Array set_array = p_value;
+		bool is_get_valid = false;
+		Variant get_value = p_res->get(p_name, &is_get_valid);
+		if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+			Array get_array = get_value;
+			if (!set_array.is_same_typed(get_array)) {
+				p_value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
+			}
+		}
+	}
+
+	if (p_value.get_type() == Variant::DICTIONARY) {
+		Dictionary set_dict = p_value;
+		bool is_get_valid = false;
+		Variant get_value = p_res->get(p_name, &is_get_valid);
+		if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
+			Dictionary get_dict = get_value;
+			if (!set_dict.is_same_typed(get_dict)) {
+				p_value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
+						get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
+			}
+		}
+	}
+
+	p_res->set(p_name, p_value);
+}
+
 void ResourceLoaderText::_count_resources() {
 	Ref<FileAccess> scan_f = FileAccess::open(f->get_path(), FileAccess::READ);
 	if (scan_f.is_null()) {
@@ -449,6 +566,376 @@ void ResourceLoaderText::_count_resources() {
 	}
 }
 
+// Files with less than this much data left after the external resources are parsed serially,
+// as the scan and task dispatch would cost more than they save.
+static const uint64_t THREADED_SUB_RESOURCES_MIN_SIZE = 64 * 1024;
+
+// Finds the offsets of the [sub_resource] tags following the one that was just parsed, and where that run
+// of sub-resources ends. Tags are only recognized at the start of a line and outside of strings, comments
+// and brackets, which is how the saver writes them. Returns false if the text can't be split reliably.
+static bool _scan_sub_resource_tags(const uint8_t *p_text, uint64_t p_len, LocalVector<uint64_t> &r_tags, uint64_t &r_end, int &r_end_lines) {
+	static const char sub_resource_tag[] = "[sub_resource ";
+	const uint64_t sub_resource_tag_len = sizeof(sub_resource_tag) - 1;
+
+	int depth = 0;
+	int lines = 0;
+	bool line_start = false;
+
+	for (uint64_t i = 0; i < p_len; i++) {
+		const uint8_t c = p_text[i];
+		switch (c) {
+			case 0: {
+				return false;
+			}
+			case '\n': {
+				lines++;
+				line_start = true;
+			} break;
+			case ';': {
+				// Comment, skip until the end of the line.
+				while (i + 1 < p_len && p_text[i + 1] != '\n') {
+					i++;
+				}
+			} break;
+			case '"': {
+				i++;
+				while (i < p_len && p_text[i] != '"') {
+					if (p_text[i] == '\\') {
+						i++;
+					} else if (p_text[i] == '\n') {
+						lines++;
+					}
+					i++;
+				}
+				if (i >= p_len) {
+					return false; // Unterminated string.
+				}
+				line_start = false;
+			} break;
+			case '[': {
+				if (depth == 0 && line_start) {
+					if (p_len - i < sub_resource_tag_len || memcmp(p_text + i, sub_resource_tag, sub_resource_tag_len) != 0) {
+						r_end = i;
+						r_end_lines = lines;
+						return true;
+					}
+					r_tags.push_back(i);
+				}
+				depth++;
+				line_start = false;
+			} break;
+			case '(':
+			case '{': {
+				depth++;
+				line_start = false;
+			} break;
+			case ']':
+			case ')':
+			case '}': {
+				depth--;
+				if (depth < 0) {
+					return false;
+				}
+				line_start = false;
+			} break;
+			default: {
+				if (c > 32) {
+					line_start = false;
+				}
+			} break;
+		}
+	}
+
+	// Sub-resources can't be the last thing in the file, let the serial parser report it.
+	return false;
+}
+
+static bool _text_contains(const uint8_t *p_text, uint64_t p_len, const char *p_what) {
+	const uint64_t what_len = strlen(p_what);
+	if (p_len < what_len) {
+		return false;
+	}
+	for (uint64_t i = 0; i <= p_len - what_len; i++) {
+		if (p_text[i] == (uint8_t)p_what[0] && memcmp(p_text + i, p_what, what_len) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+Error ResourceLoaderText::_parse_sub_resource_threaded(void *p_self, VariantParser::Stream *p_stream, Ref<Resource> &r_res, int &line, String &r_err_str) {
+	const SubResourceParseContext *context = static_cast<const SubResourceParseContext *>(p_self);
+
+	VariantParser::Token token;
+	VariantParser::get_token(p_stream, token, line, r_err_str);
+	if (token.type != VariantParser::TK_NUMBER && token.type != VariantParser::TK_STRING) {
+		r_err_str = "Expected number (old style sub-resource index) or string";
+		return ERR_PARSE_ERROR;
+	}
+
+	// Only sub-resources declared before the one being parsed can be referenced.
+	const uint32_t *section = context->data->section_ids.getptr(token.value);
+	if (!section || *section >= context->section) {
+		return ERR_INVALID_PARAMETER;
+	}
+	r_res = context->data->sections[*section].resource;
+
+	VariantParser::get_token(p_stream, token, line, r_err_str);
+	if (token.type != VariantParser::TK_PARENTHESIS_CLOSE) {
+		r_err_str = "Expected ')'";
+		return ERR_PARSE_ERROR;
+	}
+
+	return OK;
+}
+
+Error ResourceLoaderText::_parse_ext_resource_threaded(void *p_self, VariantParser::Stream *p_stream, Ref<Resource> &r_res, int &line, String &r_err_str) {
+	const SubResourceParseContext *context = static_cast<const SubResourceParseContext *>(p_self);
+
+	VariantParser::Token token;
+	VariantParser::get_token(p_stream, token, line, r_err_str);
+	if (token.type != VariantParser::TK_NUMBER && token.type != VariantParser::TK_STRING) {
+		r_err_str = "Expected number (old style sub-resource index) or String (ext-resource ID)";
+		return ERR_PARSE_ERROR;
+	}
+
+	// External resources were all resolved before dispatching, so this is read-only.
+	const ExtResource *ext_resource = context->data->loader->ext_resources.getptr(token.value);
+	if (!ext_resource || !ext_resource->resolved) {
+		r_err_str = "Can't load cached ext-resource id: " + String(token.value);
+		return ERR_PARSE_ERROR;
+	}
+
+	r_res = ext_resource->resource;
+#ifdef TOOLS_ENABLED
+	if (r_res.is_null()) {
+		// Hack to allow checking original path.
+		r_res.instantiate();
+		r_res->set_meta("__load_path__", ext_resource->path);
+	}
+#endif
+
+	VariantParser::get_token(p_stream, token, line, r_err_str);
+	if (token.type != VariantParser::TK_PARENTHESIS_CLOSE) {
+		r_err_str = "Expected ')'";
+		return ERR_PARSE_ERROR;
+	}
+
+	return ext_resource->resolve_error;
+}
+
+Error ResourceLoaderText::_parse_resource_threaded(void *p_self, VariantParser::Stream *p_stream, Ref<Resource> &r_res, int &line, String &r_err_str) {
+	// Loading by path would block the worker thread, leave it to the serial parser.
+	return ERR_UNAVAILABLE;
+}
+
+void ResourceLoaderText::_parse_sub_resource_sections(void *p_data) {
+	SubResourceParseData *data = static_cast<SubResourceParseData *>(p_data);
+
+	while (!data->failed.is_set()) {
+		const uint32_t index = data->next_section.postincrement();
+		if (index >= data->sections.size()) {
+			break;
+		}
+
+		SubResourceSection &section = data->sections[index];
+
+		Ref<FileAccessMemory> section_file;
+		section_file.instantiate();
+		section_file->open_custom(data->text + section.begin, section.end - section.begin);
+
+		VariantParser::StreamFile section_stream;
+		section_stream.f = section_file;
+
+		SubResourceParseContext context;
+		context.data = data;
+		context.section = index;
+
+		VariantParser::ResourceParser parser;
+		parser.userdata = &context;
+		parser.func = _parse_resource_threaded;
+		parser.ext_func = _parse_ext_resource_threaded;
+		parser.sub_func = _parse_sub_resource_threaded;
+
+		int line = 0;
+		String error_text;
+
+		while (true) {
+			VariantParser::Tag tag;
+			String assign;
+			Variant value;
+
+			Error err = VariantParser::parse_tag_assign_eof(&section_stream, line, error_text, tag, assign, value, &parser);
+			if (err == ERR_FILE_EOF) {
+				break;
+			}
+			if (err != OK || assign.is_empty()) {
+				// Anything unexpected is handled (and reported) by the serial parser.
+				data->failed.set();
+				break;
+			}
+
+			section.properties.push_back(Pair<String, Variant>(assign, value));
+		}
+	}
+}
+
+Error ResourceLoaderText::_load_sub_resources_threaded() {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (ignore_resource_parsing || stream.saved != 0 || pool->get_thread_count() < 2) {
+		return OK;
+	}
+
+	if (!next_tag.fields.has("type") || !next_tag.fields.has("id")) {
+		return OK;
+	}
+
+	// The stream has read ahead of the file, the run starts where the stream is, not the file.
+	const uint64_t position = f->get_position();
+	const uint64_t base = position - stream.get_readahead_size();
+	const uint64_t length = f->get_length();
+	if (length < base || length - base < THREADED_SUB_RESOURCES_MIN_SIZE) {
+		return OK;
+	}
+
+	// When bailing out, the file goes back to where it was, so the stream's readahead stays valid.
+	Vector<uint8_t> text;
+	text.resize(length - base);
+	f->seek(base);
+	if (f->get_buffer(text.ptrw(), text.size()) != (uint64_t)text.size()) {
+		f->seek(position);
+		return OK;
+	}
+
+	LocalVector<uint64_t> tags;
+	uint64_t end = 0;
+	int end_lines = 0;
+	// Inline objects would be created on the worker threads, leave those to the serial parser.
+	if (!_scan_sub_resource_tags(text.ptr(), text.size(), tags, end, end_lines) || tags.is_empty() || _text_contains(text.ptr(), end, "Object(")) {
+		f->seek(position);
+		return OK;
+	}
+
+	SubResourceParseData data;
+	data.loader = this;
+	data.text = text.ptr();
+	data.sections.resize(tags.size() + 1);
+	data.sections[0].type = next_tag.fields["type"];
+	data.sections[0].id = next_tag.fields["id"];
+
+	{
+		Ref<FileAccessMemory> header_file;
+		header_file.instantiate();
+		header_file->open_custom(text.ptr(), end);
+
+		VariantParser::StreamFile header_stream(false);
+		header_stream.f = header_file;
+
+		for (uint32_t i = 0; i < tags.size(); i++) {
+			SubResourceSection &section = data.sections[i + 1];
+
+			header_file->seek(tags[i]);
+			VariantParser::Tag tag;
+			int header_lines = 0;
+			String header_error;
+			Error err = VariantParser::parse_tag(&header_stream, header_lines, header_error, tag);
+			if (err != OK || header_stream.saved != 0 || !tag.fields.has("type") || !tag.fields.has("id")) {
+				f->seek(position);
+				return OK;
+			}
+
+			section.type = tag.fields["type"];
+			section.id = tag.fields["id"];
+			section.begin = header_file->get_position();
+			data.sections[i].end = tags[i];
+		}
+		data.sections[tags.size()].end = end;
+	}
+
+	for (uint32_t i = 0; i < data.sections.size(); i++) {
+		if (data.section_ids.has(data.sections[i].id)) {
+			// Redefined IDs are resolved by declaration order, leave those to the serial parser.
+			f->seek(position);
+			return OK;
+		}
+		data.section_ids[data.sections[i].id] = i;
+	}
+
+	// Worker threads can't wait on loads, so all external resources are resolved up front.
+	// The saver only writes the external resources that are used, so they would be waited on later anyway.
+	for (const KeyValue<String, ExtResource> &E : ext_resources) {
+		Ref<Resource> res;
+		if (_resolve_ext_resource(E.key, res) != OK) {
+			f->seek(position);
+			return OK;
+		}
+	}
+
+	for (SubResourceSection &section : data.sections) {
+		if (_create_sub_resource(section.type, section.id, section.resource, section.missing_resource, section.do_assign, section.reset_state) != OK) {
+			f->seek(position);
+			return OK;
+		}
+	}
+
+	// The calling thread also parses sections, so this makes progress even if the pool is busy.
+	const int task_count = MIN(pool->get_thread_count(), (int)data.sections.size()) - 1;
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	for (int i = 0; i < task_count; i++) {
+		tasks.push_back(pool->add_native_task(&ResourceLoaderText::_parse_sub_resource_sections, &data, true, SNAME("ResourceLoaderTextSubResources")));
+	}
+	_parse_sub_resource_sections(&data);
+	for (WorkerThreadPool::TaskID task : tasks) {
+		pool->wait_for_task_completion(task);
+	}
+
+	if (data.failed.is_set()) {
+		f->seek(position);
+		return OK;
+	}
+
+	for (SubResourceSection &section : data.sections) {
+		if (section.reset_state) {
+			section.resource->reset_state();
+		}
+
+		resource_current++;
+
+		if (progress && resources_total > 0) {
+			*progress = resource_current / float(resources_total);
+		}
+
+		_register_sub_resource(section.id, section.resource, section.do_assign);
+
+		Dictionary missing_resource_properties;
+
+		if (section.do_assign) {
+			for (Pair<String, Variant> &property : section.properties) {
+				_set_resource_property(section.resource, section.missing_resource, property.first, property.second, missing_resource_properties);
+			}
+		}
+
+		if (section.missing_resource.is_valid()) {
+			section.missing_resource->set_recording_properties(false);
+		}
+
+		if (!missing_resource_properties.is_empty()) {
+			section.resource->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+		}
+	}
+
+	// Continue serially from the tag that ended the run.
+	f->seek(base + end);
+	stream.clear_readahead();
+	lines += end_lines;
+
+	error = VariantParser::parse_tag(&stream, lines, error_text, next_tag, &rp);
+	if (error) {
+		_printerr();
+	}
+	return error;
+}
+
 Error ResourceLoaderText::load() {
 	if (error != OK) {
 		return error;
@@ -544,6 +1031,15 @@ Error ResourceLoaderText::load() {
 	}
 #endif
 
+	if (next_tag.name == "sub_resource") {
+		// Large runs of sub-resources are parsed on worker threads. If this isn't possible, the loop below
+		// parses them as usual.
+		error = _load_sub_resources_threaded();
+		if (error) {
+			return error;
+		}
+	}
+
 	while (true) {
 		if (next_tag.name != "sub_resource") {
 			break;
@@ -566,59 +1062,19 @@ Error ResourceLoaderText::load() {
 		String type = next_tag.fields["type"];
 		String id = next_tag.fields["id"];
 
-		String path = local_path + "::" + id;
-
-		//bool exists=ResourceCache::has(path);
-
 		Ref<Resource> res;
+		Ref<MissingResource> missing_resource;
 		bool do_assign = false;
+		bool reset_state = false;
 
-		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-			//reuse existing
-			Ref<Resource> cache = ResourceCache::get_ref(path);
-			if (cache.is_valid() && cache->get_class() == type) {
-				res = cache;
-				res->reset_state();
-				do_assign = true;
-			}
+		error = _create_sub_resource(type, id, res, missing_resource, do_assign, reset_state);
+		if (error) {
+			_printerr();
+			return error;
 		}
 
-		Ref<MissingResource> missing_resource;
-
-		if (res.is_null()) { //not reuse
-			Ref<Resource> cache = ResourceCache::get_ref(path);
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && cache.is_valid()) { //only if it doesn't exist
-				//cached, do not assign
-				res = cache;
-			} else {
-				//create
-
-				Object *obj = ClassDB::instantiate(type);
-				if (!obj) {
-					if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-						missing_resource = memnew(MissingResource);
-						missing_resource->set_original_class(type);
-						missing_resource->set_recording_properties(true);
-						obj = missing_resource.ptr();
-					} else {
-						error_text = vformat("Can't create sub resource of type '%s'", type);
-						_printerr();
-						error = ERR_FILE_CORRUPT;
-						return error;
-					}
-				}
-
-				Resource *r = Object::cast_to<Resource>(obj);
-				if (!r) {
-					error_text = vformat("Can't create sub resource of type '%s' as it's not a resource type", type);
-					_printerr();
-					error = ERR_FILE_CORRUPT;
-					return error;
-				}
-
-				res = Ref<Resource>(r);
-				do_assign = true;
-			}
+		if (reset_state) {
+			res->reset_state();
 		}
 
 		resource_current++;
@@ -627,15 +1083,7 @@ Error ResourceLoaderText::load() {
 			*progress = resource_current / float(resources_total);
 		}
 
-		int_resources[id] = res; // Always assign int resources.
-		if (do_assign) {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-				res->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE);
-			} else {
-				res->set_path_cache(path);
-			}
-			res->set_scene_unique_id(id);
-		}
+		_register_sub_resource(id, res, do_assign);
 
 		Dictionary missing_resource_properties;
 
@@ -652,48 +1100,7 @@ Error ResourceLoaderText::load() {
 
 			if (!assign.is_empty()) {
 				if (do_assign) {
-					bool set_valid = true;
-
-					if (value.get_type() == Variant::OBJECT && missing_resource.is_null() && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-						// If the property being set is a missing resource (and the parent is not),
-						// then setting it will most likely not work.
-						// Instead, save it as metadata.
-
-						Ref<MissingResource> mr = value;
-						if (mr.is_valid()) {
-							missing_resource_properties[assign] = mr;
-							set_valid = false;
-						}
-					}
-
-					if (value.get_type() == Variant::ARRAY) {
-						Array set_array = value;
-						bool is_get_valid = false;
-						Variant get_value = res->get(assign, &is_get_valid);
-						if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-							Array get_array = get_value;
-							if (!set_array.is_same_typed(get_array)) {
-								value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-							}
-						}
-					}
-
-					if (value.get_type() == Variant::DICTIONARY) {
-						Dictionary set_dict = value;
-						bool is_get_valid = false;
-						Variant get_value = res->get(assign, &is_get_valid);
-						if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
-							Dictionary get_dict = get_value;
-							if (!set_dict.is_same_typed(get_dict)) {
-								value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
-										get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
-							}
-						}
-					}
-
-					if (set_valid) {
-						res->set(assign, value);
-					}
+					_set_resource_property(res, missing_resource, assign, value, missing_resource_properties);
 				}
 				//it's assignment
 			} else if (!next_tag.name.is_empty()) {
@@ -793,48 +1200,7 @@ Error ResourceLoaderText::load() {
 			}
 
 			if (!assign.is_empty()) {
-				bool set_valid = true;
-
-				if (value.get_type() == Variant::OBJECT && missing_resource.is_null() && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-					// If the property being set is a missing resource (and the parent is not),
-					// then setting it will most likely not work.
-					// Instead, save it as metadata.
-
-					Ref<MissingResource> mr = value;
-					if (mr.is_valid()) {
-						missing_resource_properties[assign] = mr;
-						set_valid = false;
-					}
-				}
-
-				if (value.get_type() == Variant::ARRAY) {
-					Array set_array = value;
-					bool is_get_valid = false;
-					Variant get_value = resource->get(assign, &is_get_valid);
-					if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-						Array get_array = get_value;
-						if (!set_array.is_same_typed(get_array)) {
-							value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-						}
-					}
-				}
-
-				if (value.get_type() == Variant::DICTIONARY) {
-					Dictionary set_dict = value;
-					bool is_get_valid = false;
-					Variant get_value = resource->get(assign, &is_get_valid);
-					if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
-						Dictionary get_dict = get_value;
-						if (!set_dict.is_same_typed(get_dict)) {
-							value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
-									get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
-						}
-					}
-				}
-
-				if (set_valid) {
-					resource->set(assign, value);
-				}
+				_set_resource_property(resource, missing_resource, assign, value, missing_resource_properties);
 				//it's assignment
 			} else if (!next_tag.name.is_empty()) {
 				error = ERR_FILE_CORRUPT;
@@ -31,9 +31,13 @@
 #pragma once
 
 #include "core/io/file_access.h"
+#include "core/io/missing_resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
 #include "core/templates/rb_map.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant_parser.h"
 #include "scene/resources/packed_scene.h"
 
@@ -62,6 +66,10 @@ private:
 		Ref<ResourceLoader::LoadToken> load_token;
 		String path;
 		String type;
+		// Result of waiting on the load token, so it's only done once per resource.
+		Ref<Resource> resource;
+		Error resolve_error = OK;
+		bool resolved = false;
 	};
 
 	bool is_scene = false;
@@ -98,8 +106,49 @@ private:
 
 	Error _parse_sub_resource(VariantParser::Stream *p_stream, Ref<Resource> &r_res, int &line, String &r_err_str);
 	Error _parse_ext_resource(VariantParser::Stream *p_stream, Ref<Resource> &r_res, int &line, String &r_err_str);
+	Error _resolve_ext_resource(const String &p_id, Ref<Resource> &r_res);
 	void _count_resources();
 
+	Error _create_sub_resource(const String &p_type, const String &p_id, Ref<Resource> &r_res, Ref<MissingResource> &r_missing_resource, bool &r_do_assign, bool &r_reset_state);
+	void _register_sub_resource(const String &p_id, const Ref<Resource> &p_res, bool p_do_assign);
+	void _set_resource_property(const Ref<Resource> &p_res, const Ref<MissingResource> &p_missing_resource, const String &p_name, Variant &p_value, Dictionary &r_missing_resource_properties);
+
+	// Threaded parsing of [sub_resource] sections.
+	// The remaining file is scanned for section boundaries, the property values of each section are parsed
+	// on the WorkerThreadPool, and the results are applied to the resources in file order.
+	struct SubResourceSection {
+		String type;
+		String id;
+		uint64_t begin = 0;
+		uint64_t end = 0;
+		Ref<Resource> resource;
+		Ref<MissingResource> missing_resource;
+		bool do_assign = false;
+		bool reset_state = false;
+		LocalVector<Pair<String, Variant>> properties;
+	};
+
+	struct SubResourceParseData {
+		ResourceLoaderText *loader = nullptr;
+		const uint8_t *text = nullptr;
+		LocalVector<SubResourceSection> sections;
+		HashMap<String, uint32_t> section_ids;
+		SafeNumeric<uint32_t> next_section;
+		SafeFlag failed;
+	};
+
+	struct SubResourceParseContext {
+		SubResourceParseData *data = nullptr;
+		uint32_t section = 0;
+	};
+
+	static Error _parse_sub_resource_threaded(void *p_self, VariantParser::Stream *p_stream, Ref<Resource> &r_res, int &line, String &r_err_str);
+	static Error _parse_ext_resource_threaded(void *p_self, VariantParser::Stream *p_stream, Ref<Resource> &r_res, int &line, String &r_err_str);
+	static Error _parse_resource_threaded(void *p_self, VariantParser::Stream *p_stream, Ref<Resource> &r_res, int &line, String &r_err_str);
+	static void _parse_sub_resource_sections(void *p_data);
+
+	Error _load_sub_resources_threaded();
+
 	struct DummyReadData {
 		bool no_placeholders = false;
 		HashMap<Ref<Resource>, int> external_resources;
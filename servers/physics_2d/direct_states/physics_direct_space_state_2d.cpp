@@ -153,6 +153,196 @@ Dictionary PhysicsDirectSpaceState2D::_get_rest_info(RequiredParam<PhysicsShapeQ
 	return r;
 }
 
+Dictionary PhysicsDirectSpaceState2D::_intersect_rays(RequiredParam<PhysicsRayQueryParameters2D> rp_ray_query, const PackedVector2Array &p_from, const PackedVector2Array &p_to) {
+	EXTRACT_PARAM_OR_FAIL_V(p_ray_query, rp_ray_query, Dictionary());
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The \"from\" and \"to\" arrays must have the same size.");
+
+	const int count = p_from.size();
+	LocalVector<PS2DT::RayResult> results;
+	results.resize(count);
+	intersect_rays(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), count, results.ptr());
+
+	PackedVector2Array positions;
+	positions.resize(count);
+	Vector2 *positions_ptr = positions.ptrw();
+	PackedVector2Array normals;
+	normals.resize(count);
+	Vector2 *normals_ptr = normals.ptrw();
+	PackedInt64Array collider_ids;
+	collider_ids.resize(count);
+	int64_t *collider_ids_ptr = collider_ids.ptrw();
+	PackedInt32Array shapes;
+	shapes.resize(count);
+	int32_t *shapes_ptr = shapes.ptrw();
+
+	for (int i = 0; i < count; i++) {
+		const PS2DT::RayResult &result = results[i];
+		if (result.rid.is_valid()) {
+			positions_ptr[i] = result.position;
+			normals_ptr[i] = result.normal;
+			collider_ids_ptr[i] = int64_t(result.collider_id);
+			shapes_ptr[i] = result.shape;
+		} else {
+			positions_ptr[i] = Vector2();
+			normals_ptr[i] = Vector2();
+			collider_ids_ptr[i] = 0;
+			shapes_ptr[i] = -1;
+		}
+	}
+
+	Dictionary d;
+	d["position"] = positions;
+	d["normal"] = normals;
+	d["collider_id"] = collider_ids;
+	d["shape"] = shapes;
+
+	return d;
+}
+
+Dictionary PhysicsDirectSpaceState2D::_intersect_points(RequiredParam<PhysicsPointQueryParameters2D> rp_point_query, const PackedVector2Array &p_positions) {
+	EXTRACT_PARAM_OR_FAIL_V(p_point_query, rp_point_query, Dictionary());
+
+	const int count = p_positions.size();
+	LocalVector<PS2DT::ShapeResult> results;
+	results.resize(count);
+	intersect_points(p_point_query->get_parameters(), p_positions.ptr(), count, results.ptr());
+
+	PackedInt64Array collider_ids;
+	collider_ids.resize(count);
+	int64_t *collider_ids_ptr = collider_ids.ptrw();
+	PackedInt32Array shapes;
+	shapes.resize(count);
+	int32_t *shapes_ptr = shapes.ptrw();
+
+	for (int i = 0; i < count; i++) {
+		const PS2DT::ShapeResult &result = results[i];
+		collider_ids_ptr[i] = result.rid.is_valid() ? int64_t(result.collider_id) : 0;
+		shapes_ptr[i] = result.rid.is_valid() ? result.shape : -1;
+	}
+
+	Dictionary d;
+	d["collider_id"] = collider_ids;
+	d["shape"] = shapes;
+
+	return d;
+}
+
+Dictionary PhysicsDirectSpaceState2D::_cast_motions(RequiredParam<PhysicsShapeQueryParameters2D> rp_shape_query, const PackedVector2Array &p_origins, const PackedVector2Array &p_motions) {
+	EXTRACT_PARAM_OR_FAIL_V(p_shape_query, rp_shape_query, Dictionary());
+	ERR_FAIL_COND_V_MSG(p_origins.size() != p_motions.size(), Dictionary(), "The \"origins\" and \"motions\" arrays must have the same size.");
+
+	const int count = p_origins.size();
+	Vector<real_t> closest_safe;
+	closest_safe.resize(count);
+	Vector<real_t> closest_unsafe;
+	closest_unsafe.resize(count);
+
+	if (!cast_motions(p_shape_query->get_parameters(), p_origins.ptr(), p_motions.ptr(), count, closest_safe.ptrw(), closest_unsafe.ptrw())) {
+		return Dictionary();
+	}
+
+	Dictionary d;
+	d["safe_fraction"] = closest_safe;
+	d["unsafe_fraction"] = closest_unsafe;
+
+	return d;
+}
+
+// Inserts a zero bit after each of the 16 lowest bits of p_value.
+static _FORCE_INLINE_ uint32_t _morton_spread_bits(uint32_t p_value) {
+	p_value &= 0xffff;
+	p_value = (p_value | (p_value << 8)) & 0x00ff00ff;
+	p_value = (p_value | (p_value << 4)) & 0x0f0f0f0f;
+	p_value = (p_value | (p_value << 2)) & 0x33333333;
+	p_value = (p_value | (p_value << 1)) & 0x55555555;
+	return p_value;
+}
+
+void PhysicsDirectSpaceState2D::_sort_queries_spatially(const Vector2 *p_points, int p_count, LocalVector<uint32_t> &r_order) {
+	r_order.resize(p_count);
+	if (p_count == 0) {
+		return;
+	}
+
+	Rect2 bounds(p_points[0], Vector2());
+	for (int i = 1; i < p_count; i++) {
+		bounds.expand_to(p_points[i]);
+	}
+
+	const real_t cells = 65535;
+	Vector2 scale;
+	for (int axis = 0; axis < 2; axis++) {
+		scale[axis] = bounds.size[axis] > 0 ? cells / bounds.size[axis] : 0;
+	}
+
+	// The index in the low bits keeps the order of queries in the same cell.
+	LocalVector<uint64_t> keys;
+	keys.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		const Vector2 cell = ((p_points[i] - bounds.position) * scale).clampf(0, cells);
+		const uint32_t code = _morton_spread_bits(uint32_t(cell.x)) | (_morton_spread_bits(uint32_t(cell.y)) << 1);
+		keys[i] = (uint64_t(code) << 32) | uint32_t(i);
+	}
+	keys.sort();
+
+	for (int i = 0; i < p_count; i++) {
+		r_order[i] = uint32_t(keys[i]);
+	}
+}
+
+int PhysicsDirectSpaceState2D::intersect_rays(const PS2DT::RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, PS2DT::RayResult *r_results) {
+	LocalVector<uint32_t> order;
+	_sort_queries_spatially(p_from, p_count, order);
+
+	PS2DT::RayParameters parameters = p_parameters;
+	int hit_count = 0;
+	for (uint32_t index : order) {
+		parameters.from = p_from[index];
+		parameters.to = p_to[index];
+		r_results[index] = PS2DT::RayResult();
+		if (intersect_ray(parameters, r_results[index])) {
+			hit_count++;
+		}
+	}
+
+	return hit_count;
+}
+
+int PhysicsDirectSpaceState2D::intersect_points(const PS2DT::PointParameters &p_parameters, const Vector2 *p_positions, int p_count, PS2DT::ShapeResult *r_results) {
+	LocalVector<uint32_t> order;
+	_sort_queries_spatially(p_positions, p_count, order);
+
+	PS2DT::PointParameters parameters = p_parameters;
+	int hit_count = 0;
+	for (uint32_t index : order) {
+		parameters.position = p_positions[index];
+		r_results[index] = PS2DT::ShapeResult();
+		if (intersect_point(parameters, &r_results[index], 1) > 0) {
+			hit_count++;
+		}
+	}
+
+	return hit_count;
+}
+
+bool PhysicsDirectSpaceState2D::cast_motions(const PS2DT::ShapeParameters &p_parameters, const Vector2 *p_origins, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	LocalVector<uint32_t> order;
+	_sort_queries_spatially(p_origins, p_count, order);
+
+	PS2DT::ShapeParameters parameters = p_parameters;
+	for (uint32_t index : order) {
+		parameters.transform.columns[2] = p_origins[index];
+		parameters.motion = p_motions[index];
+		r_closest_safe[index] = 1.0;
+		r_closest_unsafe[index] = 1.0;
+		if (!cast_motion(parameters, r_closest_safe[index], r_closest_unsafe[index])) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 PhysicsDirectSpaceState2D::PhysicsDirectSpaceState2D() {
 }
 
@@ -163,4 +353,7 @@ void PhysicsDirectSpaceState2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState2D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState2D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "parameters"), &PhysicsDirectSpaceState2D::_get_rest_info);
+	ClassDB::bind_method(D_METHOD("intersect_rays", "parameters", "from", "to"), &PhysicsDirectSpaceState2D::_intersect_rays);
+	ClassDB::bind_method(D_METHOD("intersect_points", "parameters", "positions"), &PhysicsDirectSpaceState2D::_intersect_points);
+	ClassDB::bind_method(D_METHOD("cast_motions", "parameters", "origins", "motions"), &PhysicsDirectSpaceState2D::_cast_motions);
 }
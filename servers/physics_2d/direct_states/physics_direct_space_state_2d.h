@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/templates/local_vector.h"
 #include "core/variant/type_info.h"
 #include "servers/physics_2d/physics_server_2d_types.h"
 #include "servers/physics_2d/queries/physics_point_query_parameters_2d.h"
@@ -45,10 +46,17 @@ class PhysicsDirectSpaceState2D : public Object {
 	Vector<real_t> _cast_motion(RequiredParam<PhysicsShapeQueryParameters2D> rp_shape_query);
 	TypedArray<Vector2> _collide_shape(RequiredParam<PhysicsShapeQueryParameters2D> rp_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(RequiredParam<PhysicsShapeQueryParameters2D> rp_shape_query);
+	Dictionary _intersect_rays(RequiredParam<PhysicsRayQueryParameters2D> rp_ray_query, const PackedVector2Array &p_from, const PackedVector2Array &p_to);
+	Dictionary _intersect_points(RequiredParam<PhysicsPointQueryParameters2D> rp_point_query, const PackedVector2Array &p_positions);
+	Dictionary _cast_motions(RequiredParam<PhysicsShapeQueryParameters2D> rp_shape_query, const PackedVector2Array &p_origins, const PackedVector2Array &p_motions);
 
 protected:
 	static void _bind_methods();
 
+	// Fills r_order with the indices of p_points sorted along a Morton curve,
+	// so that batched queries close to each other are run together.
+	static void _sort_queries_spatially(const Vector2 *p_points, int p_count, LocalVector<uint32_t> &r_order);
+
 public:
 	virtual bool intersect_ray(const PS2DT::RayParameters &p_parameters, PS2DT::RayResult &r_result) = 0;
 
@@ -59,5 +67,12 @@ public:
 	virtual bool collide_shape(const PS2DT::ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) = 0;
 	virtual bool rest_info(const PS2DT::ShapeParameters &p_parameters, PS2DT::ShapeRestInfo *r_info) = 0;
 
+	// Batched queries, running the single query once per element. The per-element values replace
+	// their counterparts in p_parameters (from and to, position, or transform origin and motion).
+	// Results that hit nothing keep an invalid rid. The amount of rays or points that hit is returned.
+	virtual int intersect_rays(const PS2DT::RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, PS2DT::RayResult *r_results);
+	virtual int intersect_points(const PS2DT::PointParameters &p_parameters, const Vector2 *p_positions, int p_count, PS2DT::ShapeResult *r_results);
+	virtual bool cast_motions(const PS2DT::ShapeParameters &p_parameters, const Vector2 *p_origins, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe);
+
 	PhysicsDirectSpaceState2D();
 };
@@ -72,6 +72,8 @@ void PhysicsServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer2D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer2D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer2D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_save_state", "space"), &PhysicsServer2D::space_save_state);
+	ClassDB::bind_method(D_METHOD("space_restore_state", "space", "state"), &PhysicsServer2D::space_restore_state);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer2D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer2D::area_set_space);
@@ -323,6 +325,13 @@ void PhysicsServer2D::_bind_methods() {
 	BIND_ENUM_CONSTANT(PS2DE::INFO_ACTIVE_OBJECTS);
 	BIND_ENUM_CONSTANT(PS2DE::INFO_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(PS2DE::INFO_ISLAND_COUNT);
+	BIND_ENUM_CONSTANT(PS2DE::INFO_CONTACT_COUNT);
+	BIND_ENUM_CONSTANT(PS2DE::INFO_SLEEPING_OBJECTS);
+	BIND_ENUM_CONSTANT(PS2DE::INFO_PAIRS_ADDED);
+	BIND_ENUM_CONSTANT(PS2DE::INFO_PAIRS_REMOVED);
+	BIND_ENUM_CONSTANT(PS2DE::INFO_QUERY_COUNT);
+	BIND_ENUM_CONSTANT(PS2DE::INFO_STEP_TIME);
+	BIND_ENUM_CONSTANT(PS2DE::INFO_SLOWEST_ISLAND_TIME);
 }
 
 PhysicsServer2D::PhysicsServer2D() {
@@ -166,6 +166,9 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const override { return Vector<Vector2>(); }
 	virtual int space_get_contact_count(RID p_space) const override { return 0; }
 
+	virtual Vector<uint8_t> space_save_state(RID p_space) override { return Vector<uint8_t>(); }
+	virtual bool space_restore_state(RID p_space, const Vector<uint8_t> &p_state) override { return false; }
+
 	/* AREA API */
 
 	virtual RID area_create() override { return RID(); }
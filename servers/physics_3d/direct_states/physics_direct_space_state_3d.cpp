@@ -154,6 +154,202 @@ Dictionary PhysicsDirectSpaceState3D::_get_rest_info(RequiredParam<PhysicsShapeQ
 	return r;
 }
 
+Dictionary PhysicsDirectSpaceState3D::_intersect_rays(RequiredParam<PhysicsRayQueryParameters3D> rp_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to) {
+	EXTRACT_PARAM_OR_FAIL_V(p_ray_query, rp_ray_query, Dictionary());
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The \"from\" and \"to\" arrays must have the same size.");
+
+	const int count = p_from.size();
+	LocalVector<PS3DT::RayResult> results;
+	results.resize(count);
+	intersect_rays(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), count, results.ptr());
+
+	PackedVector3Array positions;
+	positions.resize(count);
+	Vector3 *positions_ptr = positions.ptrw();
+	PackedVector3Array normals;
+	normals.resize(count);
+	Vector3 *normals_ptr = normals.ptrw();
+	PackedInt64Array collider_ids;
+	collider_ids.resize(count);
+	int64_t *collider_ids_ptr = collider_ids.ptrw();
+	PackedInt32Array shapes;
+	shapes.resize(count);
+	int32_t *shapes_ptr = shapes.ptrw();
+	PackedInt32Array face_indices;
+	face_indices.resize(count);
+	int32_t *face_indices_ptr = face_indices.ptrw();
+
+	for (int i = 0; i < count; i++) {
+		const PS3DT::RayResult &result = results[i];
+		if (result.rid.is_valid()) {
+			positions_ptr[i] = result.position;
+			normals_ptr[i] = result.normal;
+			collider_ids_ptr[i] = int64_t(result.collider_id);
+			shapes_ptr[i] = result.shape;
+			face_indices_ptr[i] = result.face_index;
+		} else {
+			positions_ptr[i] = Vector3();
+			normals_ptr[i] = Vector3();
+			collider_ids_ptr[i] = 0;
+			shapes_ptr[i] = -1;
+			face_indices_ptr[i] = -1;
+		}
+	}
+
+	Dictionary d;
+	d["position"] = positions;
+	d["normal"] = normals;
+	d["collider_id"] = collider_ids;
+	d["shape"] = shapes;
+	d["face_index"] = face_indices;
+
+	return d;
+}
+
+Dictionary PhysicsDirectSpaceState3D::_intersect_points(RequiredParam<PhysicsPointQueryParameters3D> rp_point_query, const PackedVector3Array &p_positions) {
+	EXTRACT_PARAM_OR_FAIL_V(p_point_query, rp_point_query, Dictionary());
+
+	const int count = p_positions.size();
+	LocalVector<PS3DT::ShapeResult> results;
+	results.resize(count);
+	intersect_points(p_point_query->get_parameters(), p_positions.ptr(), count, results.ptr());
+
+	PackedInt64Array collider_ids;
+	collider_ids.resize(count);
+	int64_t *collider_ids_ptr = collider_ids.ptrw();
+	PackedInt32Array shapes;
+	shapes.resize(count);
+	int32_t *shapes_ptr = shapes.ptrw();
+
+	for (int i = 0; i < count; i++) {
+		const PS3DT::ShapeResult &result = results[i];
+		collider_ids_ptr[i] = result.rid.is_valid() ? int64_t(result.collider_id) : 0;
+		shapes_ptr[i] = result.rid.is_valid() ? result.shape : -1;
+	}
+
+	Dictionary d;
+	d["collider_id"] = collider_ids;
+	d["shape"] = shapes;
+
+	return d;
+}
+
+Dictionary PhysicsDirectSpaceState3D::_cast_motions(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query, const PackedVector3Array &p_origins, const PackedVector3Array &p_motions) {
+	EXTRACT_PARAM_OR_FAIL_V(p_shape_query, rp_shape_query, Dictionary());
+	ERR_FAIL_COND_V_MSG(p_origins.size() != p_motions.size(), Dictionary(), "The \"origins\" and \"motions\" arrays must have the same size.");
+
+	const int count = p_origins.size();
+	Vector<real_t> closest_safe;
+	closest_safe.resize(count);
+	Vector<real_t> closest_unsafe;
+	closest_unsafe.resize(count);
+
+	if (!cast_motions(p_shape_query->get_parameters(), p_origins.ptr(), p_motions.ptr(), count, closest_safe.ptrw(), closest_unsafe.ptrw())) {
+		return Dictionary();
+	}
+
+	Dictionary d;
+	d["safe_fraction"] = closest_safe;
+	d["unsafe_fraction"] = closest_unsafe;
+
+	return d;
+}
+
+// Inserts two zero bits after each of the 10 lowest bits of p_value.
+static _FORCE_INLINE_ uint32_t _morton_spread_bits(uint32_t p_value) {
+	p_value &= 0x3ff;
+	p_value = (p_value | (p_value << 16)) & 0x030000ff;
+	p_value = (p_value | (p_value << 8)) & 0x0300f00f;
+	p_value = (p_value | (p_value << 4)) & 0x030c30c3;
+	p_value = (p_value | (p_value << 2)) & 0x09249249;
+	return p_value;
+}
+
+void PhysicsDirectSpaceState3D::_sort_queries_spatially(const Vector3 *p_points, int p_count, LocalVector<uint32_t> &r_order) {
+	r_order.resize(p_count);
+	if (p_count == 0) {
+		return;
+	}
+
+	AABB bounds(p_points[0], Vector3());
+	for (int i = 1; i < p_count; i++) {
+		bounds.expand_to(p_points[i]);
+	}
+
+	const real_t cells = 1023;
+	Vector3 scale;
+	for (int axis = 0; axis < 3; axis++) {
+		scale[axis] = bounds.size[axis] > 0 ? cells / bounds.size[axis] : 0;
+	}
+
+	// The index in the low bits keeps the order of queries in the same cell.
+	LocalVector<uint64_t> keys;
+	keys.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		const Vector3 cell = ((p_points[i] - bounds.position) * scale).clampf(0, cells);
+		const uint32_t code = _morton_spread_bits(uint32_t(cell.x)) | (_morton_spread_bits(uint32_t(cell.y)) << 1) | (_morton_spread_bits(uint32_t(cell.z)) << 2);
+		keys[i] = (uint64_t(code) << 32) | uint32_t(i);
+	}
+	keys.sort();
+
+	for (int i = 0; i < p_count; i++) {
+		r_order[i] = uint32_t(keys[i]);
+	}
+}
+
+int PhysicsDirectSpaceState3D::intersect_rays(const PS3DT::RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, PS3DT::RayResult *r_results) {
+	LocalVector<uint32_t> order;
+	_sort_queries_spatially(p_from, p_count, order);
+
+	PS3DT::RayParameters parameters = p_parameters;
+	int hit_count = 0;
+	for (uint32_t index : order) {
+		parameters.from = p_from[index];
+		parameters.to = p_to[index];
+		r_results[index] = PS3DT::RayResult();
+		if (intersect_ray(parameters, r_results[index])) {
+			hit_count++;
+		}
+	}
+
+	return hit_count;
+}
+
+int PhysicsDirectSpaceState3D::intersect_points(const PS3DT::PointParameters &p_parameters, const Vector3 *p_positions, int p_count, PS3DT::ShapeResult *r_results) {
+	LocalVector<uint32_t> order;
+	_sort_queries_spatially(p_positions, p_count, order);
+
+	PS3DT::PointParameters parameters = p_parameters;
+	int hit_count = 0;
+	for (uint32_t index : order) {
+		parameters.position = p_positions[index];
+		r_results[index] = PS3DT::ShapeResult();
+		if (intersect_point(parameters, &r_results[index], 1) > 0) {
+			hit_count++;
+		}
+	}
+
+	return hit_count;
+}
+
+bool PhysicsDirectSpaceState3D::cast_motions(const PS3DT::ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	LocalVector<uint32_t> order;
+	_sort_queries_spatially(p_origins, p_count, order);
+
+	PS3DT::ShapeParameters parameters = p_parameters;
+	for (uint32_t index : order) {
+		parameters.transform.origin = p_origins[index];
+		parameters.motion = p_motions[index];
+		r_closest_safe[index] = 1.0;
+		r_closest_unsafe[index] = 1.0;
+		if (!cast_motion(parameters, r_closest_safe[index], r_closest_unsafe[index])) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 PhysicsDirectSpaceState3D::PhysicsDirectSpaceState3D() {
 }
 
@@ -164,4 +360,7 @@ void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState3D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "parameters"), &PhysicsDirectSpaceState3D::_get_rest_info);
+	ClassDB::bind_method(D_METHOD("intersect_rays", "parameters", "from", "to"), &PhysicsDirectSpaceState3D::_intersect_rays);
+	ClassDB::bind_method(D_METHOD("intersect_points", "parameters", "positions"), &PhysicsDirectSpaceState3D::_intersect_points);
+	ClassDB::bind_method(D_METHOD("cast_motions", "parameters", "origins", "motions"), &PhysicsDirectSpaceState3D::_cast_motions);
 }
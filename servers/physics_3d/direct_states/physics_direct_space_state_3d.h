@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/templates/local_vector.h"
 #include "core/variant/type_info.h"
 #include "servers/physics_3d/physics_server_3d_types.h"
 #include "servers/physics_3d/queries/physics_point_query_parameters_3d.h"
@@ -46,10 +47,17 @@ private:
 	Vector<real_t> _cast_motion(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query);
 	TypedArray<Vector3> _collide_shape(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query);
+	Dictionary _intersect_rays(RequiredParam<PhysicsRayQueryParameters3D> rp_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to);
+	Dictionary _intersect_points(RequiredParam<PhysicsPointQueryParameters3D> rp_point_query, const PackedVector3Array &p_positions);
+	Dictionary _cast_motions(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query, const PackedVector3Array &p_origins, const PackedVector3Array &p_motions);
 
 protected:
 	static void _bind_methods();
 
+	// Fills r_order with the indices of p_points sorted along a Morton curve,
+	// so that batched queries close to each other are run together.
+	static void _sort_queries_spatially(const Vector3 *p_points, int p_count, LocalVector<uint32_t> &r_order);
+
 public:
 	virtual bool intersect_ray(const PS3DT::RayParameters &p_parameters, PS3DT::RayResult &r_result) = 0;
 
@@ -62,5 +70,12 @@ public:
 
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const = 0;
 
+	// Batched queries, running the single query once per element. The per-element values replace
+	// their counterparts in p_parameters (from and to, position, or transform origin and motion).
+	// Results that hit nothing keep an invalid rid. The amount of rays or points that hit is returned.
+	virtual int intersect_rays(const PS3DT::RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, PS3DT::RayResult *r_results);
+	virtual int intersect_points(const PS3DT::PointParameters &p_parameters, const Vector3 *p_positions, int p_count, PS3DT::ShapeResult *r_results);
+	virtual bool cast_motions(const PS3DT::ShapeParameters &p_parameters, const Vector3 *p_origins, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe);
+
 	PhysicsDirectSpaceState3D();
 };
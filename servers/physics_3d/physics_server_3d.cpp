@@ -105,6 +105,8 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer3D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer3D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer3D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_save_state", "space"), &PhysicsServer3D::space_save_state);
+	ClassDB::bind_method(D_METHOD("space_restore_state", "space", "state"), &PhysicsServer3D::space_restore_state);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer3D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer3D::area_set_space);
@@ -506,6 +508,13 @@ void PhysicsServer3D::_bind_methods() {
 	BIND_ENUM_CONSTANT(PS3DE::INFO_ACTIVE_OBJECTS);
 	BIND_ENUM_CONSTANT(PS3DE::INFO_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(PS3DE::INFO_ISLAND_COUNT);
+	BIND_ENUM_CONSTANT(PS3DE::INFO_CONTACT_COUNT);
+	BIND_ENUM_CONSTANT(PS3DE::INFO_SLEEPING_OBJECTS);
+	BIND_ENUM_CONSTANT(PS3DE::INFO_PAIRS_ADDED);
+	BIND_ENUM_CONSTANT(PS3DE::INFO_PAIRS_REMOVED);
+	BIND_ENUM_CONSTANT(PS3DE::INFO_QUERY_COUNT);
+	BIND_ENUM_CONSTANT(PS3DE::INFO_STEP_TIME);
+	BIND_ENUM_CONSTANT(PS3DE::INFO_SLOWEST_ISLAND_TIME);
 
 	BIND_ENUM_CONSTANT(PS3DE::SPACE_PARAM_CONTACT_RECYCLE_RADIUS);
 	BIND_ENUM_CONSTANT(PS3DE::SPACE_PARAM_CONTACT_MAX_SEPARATION);
@@ -256,7 +256,14 @@ enum AreaBodyStatus {
 enum ProcessInfo {
 	INFO_ACTIVE_OBJECTS,
 	INFO_COLLISION_PAIRS,
-	INFO_ISLAND_COUNT
+	INFO_ISLAND_COUNT,
+	INFO_CONTACT_COUNT,
+	INFO_SLEEPING_OBJECTS,
+	INFO_PAIRS_ADDED,
+	INFO_PAIRS_REMOVED,
+	INFO_QUERY_COUNT,
+	INFO_STEP_TIME,
+	INFO_SLOWEST_ISLAND_TIME,
 };
 
 #ifndef DISABLE_DEPRECATED
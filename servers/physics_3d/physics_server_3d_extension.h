@@ -247,6 +247,22 @@ public:
 	EXBIND1RC(Vector<Vector3>, space_get_contacts, RID)
 	EXBIND1RC(int, space_get_contact_count, RID)
 
+	// Optional, so extensions without snapshots keep working.
+	GDVIRTUAL1R(Vector<uint8_t>, _space_save_state, RID)
+	GDVIRTUAL2R(bool, _space_restore_state, RID, const Vector<uint8_t> &)
+
+	virtual Vector<uint8_t> space_save_state(RID p_space) override {
+		Vector<uint8_t> ret;
+		GDVIRTUAL_CALL(_space_save_state, p_space, ret);
+		return ret;
+	}
+
+	virtual bool space_restore_state(RID p_space, const Vector<uint8_t> &p_state) override {
+		bool ret = false;
+		GDVIRTUAL_CALL(_space_restore_state, p_space, p_state, ret);
+		return ret;
+	}
+
 	/* AREA API */
 
 	//EXBIND0RID(area);
@@ -32,6 +32,7 @@
 
 TEST_FORCE_LINK(test_file_access)
 
+#include "core/crypto/crypto_core.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "tests/test_utils.h"
@@ -297,4 +298,62 @@ TEST_CASE("[FileAccess] Cursor positioning") {
 	}
 }
 
+TEST_CASE("[FileAccess] Positional and asynchronous reads") {
+	const String file_path = TestUtils::get_temp_path("file_access_async_read.bin");
+
+	Vector<uint8_t> data;
+	data.resize(200000);
+	for (int i = 0; i < data.size(); i++) {
+		data.write[i] = uint8_t((i * 7) ^ (i >> 8));
+	}
+
+	{
+		Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(data);
+	}
+
+	Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+
+	SUBCASE("get_buffer_at() doesn't move the cursor") {
+		f->seek(10);
+		uint8_t buf[16];
+		CHECK(f->get_buffer_at(1000, buf, 16) == 16);
+		CHECK(memcmp(buf, data.ptr() + 1000, 16) == 0);
+		CHECK(f->get_position() == 10);
+		CHECK(f->get_8() == data[10]);
+
+		// Reads are clamped to the end of the file.
+		CHECK(f->get_buffer_at(data.size() - 4, buf, 16) == 4);
+		CHECK(f->get_buffer_at(data.size() + 4, buf, 16) == 0);
+	}
+
+	SUBCASE("Several reads in flight") {
+		const int block_size = 50000;
+		Vector<uint8_t> out;
+		out.resize(data.size());
+		uint64_t read[4] = {};
+		int64_t ids[4];
+		for (int i = 0; i < 4; i++) {
+			ids[i] = f->read_async(i * block_size, out.ptrw() + i * block_size, block_size, &read[i]);
+		}
+		for (int i = 0; i < 4; i++) {
+			FileAccess::wait_async_read(ids[i]);
+			CHECK(read[i] == block_size);
+		}
+		CHECK(out == data);
+		CHECK(f->get_position() == 0);
+	}
+
+	SUBCASE("Hashing large files") {
+		unsigned char hash[16];
+		CryptoCore::md5(data.ptr(), data.size(), hash);
+		CHECK(FileAccess::get_md5(file_path) == String::md5(hash));
+	}
+
+	f.unref();
+	DirAccess::remove_absolute(file_path);
+}
+
 } // namespace TestFileAccess
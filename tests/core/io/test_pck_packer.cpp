@@ -33,12 +33,33 @@
 TEST_FORCE_LINK(test_pck_packer)
 
 #include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
 #include "core/io/pck_packer.h"
 #include "core/os/os.h"
 #include "tests/test_utils.h"
 
 namespace TestPCKPacker {
 
+// Reads a file back through PackedData, the way packs are loaded at runtime.
+// Returns an empty buffer if the pack doesn't have the file.
+static Vector<uint8_t> read_from_pack(const String &p_pck_path, const String &p_file) {
+	PackedData *packed_data = PackedData::get_singleton();
+	REQUIRE(packed_data != nullptr);
+	REQUIRE(packed_data->add_pack(p_pck_path, true, 0) == OK);
+
+	// The default key of PCKPacker.
+	Vector<uint8_t> key;
+	key.resize_initialized(32);
+
+	Vector<uint8_t> data;
+	Ref<FileAccess> f = packed_data->try_open_path("res://" + p_file, key);
+	if (f.is_valid()) {
+		data = f->get_buffer(f->get_length());
+	}
+	packed_data->clear();
+	return data;
+}
+
 TEST_CASE("[PCKPacker] Pack an empty PCK file") {
 	PCKPacker pck_packer;
 	const String output_pck_path = TestUtils::get_temp_path("output_empty.pck");
@@ -120,4 +141,83 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			"The generated non-empty PCK file shouldn't be too large.");
 }
 
+TEST_CASE("[PCKPacker] Update a PCK file incrementally") {
+	const String output_pck_path = TestUtils::get_temp_path("output_incremental.pck");
+
+	Vector<uint8_t> large;
+	large.resize(65536);
+	for (int i = 0; i < large.size(); i++) {
+		large.write[i] = uint8_t(i * 31);
+	}
+
+	uint64_t initial_length = 0;
+	{
+		PCKPacker pck_packer;
+		REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+		CHECK(pck_packer.add_file_from_buffer("large.bin", large) == OK);
+		CHECK(pck_packer.add_file_from_buffer("small.txt", String("Hello world!").to_utf8_buffer()) == OK);
+		CHECK(pck_packer.flush() == OK);
+		initial_length = FileAccess::open(output_pck_path, FileAccess::READ)->get_length();
+	}
+	CHECK(read_from_pack(output_pck_path, "large.bin") == large);
+	CHECK(read_from_pack(output_pck_path, "small.txt") == String("Hello world!").to_utf8_buffer());
+
+	{
+		// Only the changed file and the directory are rewritten.
+		PCKPacker pck_packer;
+		REQUIRE(pck_packer.pck_start_incremental(output_pck_path) == OK);
+		CHECK(pck_packer.add_file_from_buffer("large.bin", large) == OK);
+		CHECK(pck_packer.add_file_from_buffer("small.txt", String("Hello again!").to_utf8_buffer()) == OK);
+		CHECK(pck_packer.flush() == OK);
+		uint64_t length = FileAccess::open(output_pck_path, FileAccess::READ)->get_length();
+		CHECK_MESSAGE(
+				length < initial_length + 1024,
+				"Unchanged file data should be reused from the previous PCK.");
+	}
+	CHECK_MESSAGE(read_from_pack(output_pck_path, "large.bin") == large, "Reused file data should still be read back.");
+	CHECK(read_from_pack(output_pck_path, "small.txt") == String("Hello again!").to_utf8_buffer());
+
+	{
+		// Changed data is appended.
+		large.write[0] = large[0] + 1;
+		PCKPacker pck_packer;
+		REQUIRE(pck_packer.pck_start_incremental(output_pck_path) == OK);
+		CHECK(pck_packer.add_file_from_buffer("large.bin", large) == OK);
+		CHECK(pck_packer.flush() == OK);
+		uint64_t length = FileAccess::open(output_pck_path, FileAccess::READ)->get_length();
+		CHECK(length >= initial_length + large.size());
+	}
+	CHECK_MESSAGE(read_from_pack(output_pck_path, "large.bin") == large, "Changed file data should be read from where it was appended.");
+	CHECK_MESSAGE(read_from_pack(output_pck_path, "small.txt").is_empty(), "Files that weren't added again should be left out.");
+}
+
+TEST_CASE("[PCKPacker] Store identical files once") {
+	const String output_pck_path = TestUtils::get_temp_path("output_deduplicated.pck");
+
+	Vector<uint8_t> data;
+	data.resize(65536);
+	for (int i = 0; i < data.size(); i++) {
+		data.write[i] = uint8_t(i * 13);
+	}
+
+	PCKPacker pck_packer;
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	CHECK(pck_packer.add_file_from_buffer("a/texture.bin", data) == OK);
+	CHECK(pck_packer.add_file_from_buffer("dlc/texture.bin", data) == OK);
+	CHECK(pck_packer.add_file_from_buffer("dlc/texture_encrypted.bin", data, true) == OK);
+	CHECK(pck_packer.flush() == OK);
+
+	uint64_t length = FileAccess::open(output_pck_path, FileAccess::READ)->get_length();
+	CHECK_MESSAGE(
+			length >= uint64_t(data.size()) * 2,
+			"Encrypted and plain copies of the same content should be stored separately.");
+	CHECK_MESSAGE(
+			length < uint64_t(data.size()) * 3,
+			"Identical plain files should share their data.");
+
+	CHECK(read_from_pack(output_pck_path, "a/texture.bin") == data);
+	CHECK(read_from_pack(output_pck_path, "dlc/texture.bin") == data);
+	CHECK(read_from_pack(output_pck_path, "dlc/texture_encrypted.bin") == data);
+}
+
 } // namespace TestPCKPacker
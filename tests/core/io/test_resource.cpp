@@ -32,6 +32,7 @@
 
 TEST_FORCE_LINK(test_resource)
 
+#include "core/io/file_access.h"
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
@@ -571,6 +572,100 @@ TEST_CASE("[Resource] Saving and loading") {
 			"The loaded child resource name should be equal to the expected value.");
 }
 
+// Large enough to have the sub-resources parsed on worker threads.
+static Ref<Resource> _create_resource_with_many_sub_resources() {
+	Ref<Resource> resource = memnew(Resource);
+	Array children;
+	Ref<Resource> previous;
+	for (int i = 0; i < 64; i++) {
+		Ref<Resource> child = memnew(Resource);
+		child->set_name(vformat("Child %d", i));
+		PackedFloat32Array data;
+		data.resize(512);
+		for (int j = 0; j < data.size(); j++) {
+			data.set(j, i + j * 0.25);
+		}
+		child->set_meta("data", data);
+		// Tags inside of strings must not be taken as section boundaries.
+		child->set_meta("text", "Not a tag:\n[sub_resource type=\"Resource\" id=\"fake\"]\n");
+		if (previous.is_valid()) {
+			child->set_meta("previous", previous);
+		}
+		children.push_back(child);
+		previous = child;
+	}
+	resource->set_meta("children", children);
+	return resource;
+}
+
+TEST_CASE("[Resource] Loading text resources with many sub-resources") {
+	const String save_path_text = TestUtils::get_temp_path("resource_many_sub_resources.tres");
+	ResourceSaver::save(_create_resource_with_many_sub_resources(), save_path_text);
+
+	const Ref<Resource> &loaded_resource = ResourceLoader::load(save_path_text, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(loaded_resource.is_valid());
+	const Array loaded_children = loaded_resource->get_meta("children");
+	REQUIRE(loaded_children.size() == 64);
+	for (int i = 0; i < loaded_children.size(); i++) {
+		const Ref<Resource> child = loaded_children[i];
+		REQUIRE(child.is_valid());
+		CHECK(child->get_name() == vformat("Child %d", i));
+		CHECK(child->get_meta("text") == "Not a tag:\n[sub_resource type=\"Resource\" id=\"fake\"]\n");
+		const PackedFloat32Array data = child->get_meta("data");
+		REQUIRE(data.size() == 512);
+		CHECK(data[0] == i);
+		CHECK(data[511] == i + 511 * 0.25f);
+		if (i > 0) {
+			CHECK_MESSAGE(
+					Ref<Resource>(child->get_meta("previous")) == Ref<Resource>(loaded_children[i - 1]),
+					"References between sub-resources should be preserved.");
+		}
+	}
+}
+
+TEST_CASE("[Resource] Loading many sub-resources on worker threads matches a serial load") {
+	const String save_path_text = TestUtils::get_temp_path("resource_many_sub_resources_threaded.tres");
+	ResourceSaver::save(_create_resource_with_many_sub_resources(), save_path_text);
+
+	Ref<Resource> serial_resource;
+	{
+		// A single thread always takes the serial path.
+		TestUtils::ScopedWorkerThreadCount thread_count(1);
+		serial_resource = ResourceLoader::load(save_path_text, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	}
+
+	Ref<Resource> threaded_resource;
+	{
+		TestUtils::ScopedWorkerThreadCount thread_count(4);
+		threaded_resource = ResourceLoader::load(save_path_text, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	}
+
+	REQUIRE(serial_resource.is_valid());
+	REQUIRE(threaded_resource.is_valid());
+	const Array serial_children = serial_resource->get_meta("children");
+	const Array threaded_children = threaded_resource->get_meta("children");
+	REQUIRE(threaded_children.size() == serial_children.size());
+	for (int i = 0; i < serial_children.size(); i++) {
+		const Ref<Resource> serial_child = serial_children[i];
+		const Ref<Resource> threaded_child = threaded_children[i];
+		REQUIRE(threaded_child.is_valid());
+		CHECK(threaded_child->get_name() == serial_child->get_name());
+		CHECK(threaded_child->get_scene_unique_id() == serial_child->get_scene_unique_id());
+		CHECK(threaded_child->get_meta("text") == serial_child->get_meta("text"));
+		CHECK(PackedFloat32Array(threaded_child->get_meta("data")) == PackedFloat32Array(serial_child->get_meta("data")));
+		if (i > 0) {
+			CHECK(Ref<Resource>(threaded_child->get_meta("previous")) == Ref<Resource>(threaded_children[i - 1]));
+		}
+	}
+
+	// Saving both again writes the same sub-resource IDs and values.
+	const String serial_path = TestUtils::get_temp_path("resource_many_sub_resources_serial_resaved.tres");
+	const String threaded_path = TestUtils::get_temp_path("resource_many_sub_resources_threaded_resaved.tres");
+	ResourceSaver::save(serial_resource, serial_path);
+	ResourceSaver::save(threaded_resource, threaded_path);
+	CHECK(FileAccess::get_file_as_bytes(threaded_path) == FileAccess::get_file_as_bytes(serial_path));
+}
+
 TEST_CASE("[Resource] Breaking circular references on save") {
 	Ref<Resource> resource_a = memnew(Resource);
 	resource_a->set_name("A");
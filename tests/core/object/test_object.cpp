@@ -36,7 +36,10 @@ TEST_FORCE_LINK(test_object)
 #include "core/object/class_db.h"
 #include "core/object/object.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
 #include "tests/signal_watcher.h"
+#include "tests/test_benchmark.h"
 
 namespace TestObject {
 
@@ -468,6 +471,32 @@ TEST_CASE("[Object] Signals") {
 		CHECK(signal_connections.size() == 0);
 	}
 
+	SUBCASE("Emitting follows the connections made and removed between emissions") {
+		Object first_target;
+		Object second_target;
+		const Callable first_callable = Callable(&first_target, "set_meta");
+		const Callable second_callable = Callable(&second_target, "set_meta");
+
+		object.connect("my_custom_signal", first_callable);
+		object.emit_signal("my_custom_signal", "value", 1);
+		CHECK(first_target.get_meta("value", 0) == Variant(1));
+		CHECK(second_target.get_meta("value", 0) == Variant(0));
+
+		object.connect("my_custom_signal", second_callable, Object::CONNECT_ONE_SHOT);
+		object.emit_signal("my_custom_signal", "value", 2);
+		CHECK(first_target.get_meta("value", 0) == Variant(2));
+		CHECK(second_target.get_meta("value", 0) == Variant(2));
+		CHECK_FALSE(object.is_connected("my_custom_signal", second_callable));
+
+		object.disconnect("my_custom_signal", first_callable);
+		object.connect("my_custom_signal", second_callable);
+		object.emit_signal("my_custom_signal", "value", 3);
+		CHECK(first_target.get_meta("value", 0) == Variant(2));
+		CHECK(second_target.get_meta("value", 0) == Variant(3));
+
+		object.disconnect("my_custom_signal", second_callable);
+	}
+
 	SUBCASE("Connecting with CONNECT_APPEND_SOURCE_OBJECT flag") {
 		SignalReceiver target;
 
@@ -691,4 +720,72 @@ TEST_CASE("[Object] RequiredResult") {
 	CHECK_EQ(ref, var);
 }
 
+TEST_CASE("[Object] ObjectDB lookups") {
+	Object *object = memnew(Object);
+	const ObjectID id = object->get_instance_id();
+	CHECK(ObjectDB::get_instance(id) == object);
+
+	memdelete(object);
+	CHECK(ObjectDB::get_instance(id) == nullptr);
+
+	// A new object may reuse the slot, the old ID must not resolve to it.
+	Object *other_object = memnew(Object);
+	CHECK(ObjectDB::get_instance(id) == nullptr);
+	CHECK(ObjectDB::get_instance(other_object->get_instance_id()) == other_object);
+	memdelete(other_object);
+
+	// Enough objects to need more than one chunk of slots.
+	LocalVector<Object *> objects;
+	for (int i = 0; i < 10'000; i++) {
+		objects.push_back(memnew(Object));
+	}
+	bool all_found = true;
+	for (Object *E : objects) {
+		all_found = all_found && ObjectDB::get_instance(E->get_instance_id()) == E;
+	}
+	CHECK(all_found);
+	for (Object *E : objects) {
+		memdelete(E);
+	}
+}
+
+struct ObjectDBLookupBenchmark {
+	LocalVector<ObjectID> ids;
+	SafeNumeric<uint64_t> found{ 0 };
+
+	void lookup(uint32_t p_index, void *p_userdata) {
+		constexpr uint32_t LOOKUPS_PER_TASK = 1'000'000;
+		uint64_t task_found = 0;
+		for (uint32_t i = 0; i < LOOKUPS_PER_TASK; i++) {
+			task_found += ObjectDB::get_instance(ids[(p_index * 7919 + i) % ids.size()]) != nullptr;
+		}
+		found.add(task_found);
+	}
+};
+
+// Not run by default, use `--test --benchmark` to run it.
+TEST_CASE("[Object][Benchmark] ObjectDB lookups from many threads" * doctest::skip()) {
+	constexpr int OBJECT_COUNT = 100'000;
+	const int task_count = OS::get_singleton()->get_processor_count() * 4;
+
+	LocalVector<Object *> objects;
+	ObjectDBLookupBenchmark benchmark;
+	for (int i = 0; i < OBJECT_COUNT; i++) {
+		Object *object = memnew(Object);
+		objects.push_back(object);
+		benchmark.ids.push_back(object->get_instance_id());
+	}
+
+	{
+		TestBenchmark::PhaseTimer timer("objectdb_lookup", "threaded_lookups", task_count);
+		WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_template_group_task(&benchmark, &ObjectDBLookupBenchmark::lookup, nullptr, task_count, -1, true, SNAME("ObjectDBLookupBenchmark"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+	}
+	CHECK(benchmark.found.get() == uint64_t(task_count) * 1'000'000);
+
+	for (Object *object : objects) {
+		memdelete(object);
+	}
+}
+
 } // namespace TestObject
@@ -106,6 +106,72 @@ TEST_CASE("[Variant] Writer and parser Variant::FLOAT") {
 	CHECK_MESSAGE(float_parsed == 1.0e+100, "Should match the double literal.");
 }
 
+TEST_CASE("[Variant] Writer and parser packed numeric arrays") {
+	String errs;
+	int line = 0;
+	Variant parsed;
+
+	PackedFloat32Array floats = { 0.0f, -0.5f, 1e-10f, 3.25e20f, (float)Math::INF, (float)-Math::INF };
+	String floats_str;
+	VariantWriter::write_to_string(floats, floats_str);
+
+	VariantParser::StreamString floats_ss;
+	floats_ss.s = floats_str;
+	CHECK(VariantParser::parse(&floats_ss, parsed, errs, line) == OK);
+	CHECK(parsed.get_type() == Variant::PACKED_FLOAT32_ARRAY);
+	CHECK(PackedFloat32Array(parsed) == floats);
+
+	PackedVector3Array vectors = { Vector3(1, 2, 3), Vector3(-0.25, 1e5, -7) };
+	String vectors_str;
+	VariantWriter::write_to_string(vectors, vectors_str);
+
+	VariantParser::StreamString vectors_ss;
+	vectors_ss.s = vectors_str;
+	CHECK(VariantParser::parse(&vectors_ss, parsed, errs, line) == OK);
+	CHECK(PackedVector3Array(parsed) == vectors);
+
+	PackedInt64Array ints = { 0, -1, 9223372036854775807 };
+	String ints_str;
+	VariantWriter::write_to_string(ints, ints_str);
+	CHECK(ints_str == "PackedInt64Array(0, -1, 9223372036854775807)");
+
+	VariantParser::StreamString ints_ss;
+	ints_ss.s = ints_str;
+	CHECK(VariantParser::parse(&ints_ss, parsed, errs, line) == OK);
+	CHECK(PackedInt64Array(parsed) == ints);
+
+	// Blanks, line breaks, comments and special values between elements.
+	VariantParser::StreamString spaced_ss;
+	spaced_ss.s = "PackedFloat32Array( 1 ,2.5 ; Comment.\n,\n-3e2, -inf,nan )";
+	line = 0;
+	CHECK(VariantParser::parse(&spaced_ss, parsed, errs, line) == OK);
+	CHECK(line == 2);
+	PackedFloat32Array spaced = parsed;
+	REQUIRE(spaced.size() == 5);
+	CHECK(spaced[0] == 1.0f);
+	CHECK(spaced[1] == 2.5f);
+	CHECK(spaced[2] == -300.0f);
+	CHECK(spaced[3] == -Math::INF);
+	CHECK(Math::is_nan(spaced[4]));
+
+	VariantParser::StreamString bytes_ss;
+	bytes_ss.s = "PackedByteArray(0, 1, 255)";
+	CHECK(VariantParser::parse(&bytes_ss, parsed, errs, line) == OK);
+	CHECK(PackedByteArray(parsed) == PackedByteArray({ 0, 1, 255 }));
+
+	ERR_PRINT_OFF;
+	VariantParser::StreamString missing_ss;
+	missing_ss.s = "PackedFloat32Array(1, , 2)";
+	CHECK(VariantParser::parse(&missing_ss, parsed, errs, line) == ERR_PARSE_ERROR);
+	CHECK(errs == "Expected float in constructor");
+
+	VariantParser::StreamString unterminated_ss;
+	unterminated_ss.s = "PackedInt32Array(1, 2";
+	CHECK(VariantParser::parse(&unterminated_ss, parsed, errs, line) == ERR_PARSE_ERROR);
+	CHECK(errs == "Expected ',' or ')' in constructor");
+	ERR_PRINT_ON;
+}
+
 TEST_CASE("[Variant] Assignment To Bool from Int,Float,String,Vec2,Vec2i,Vec3,Vec3i,Vec4,Vec4i,Rect2,Rect2i,Trans2d,Trans3d,Color,Call,Plane,Basis,AABB,Quant,Proj,RID,and Object") {
 	Variant int_v = 0;
 	Variant bool_v = true;
@@ -0,0 +1,94 @@
+/**************************************************************************/
+/*  physics_test_space_3d.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/physics_test_space_3d.h"
+
+namespace TestUtils {
+
+RID PhysicsTestSpace3D::create_box_shape(const Vector3 &p_half_extents) {
+	RID shape = ps->box_shape_create();
+	ps->shape_set_data(shape, p_half_extents);
+	shapes.push_back(shape);
+	return shape;
+}
+
+RID PhysicsTestSpace3D::create_sphere_shape(real_t p_radius) {
+	RID shape = ps->sphere_shape_create();
+	ps->shape_set_data(shape, p_radius);
+	shapes.push_back(shape);
+	return shape;
+}
+
+RID PhysicsTestSpace3D::add_body(RID p_shape, const Vector3 &p_position) {
+	RID body = ps->body_create();
+	ps->body_set_space(body, space);
+	ps->body_add_shape(body, p_shape);
+	ps->body_set_state(body, PS3DE::BODY_STATE_TRANSFORM, Transform3D(Basis(), p_position));
+	bodies.push_back(body);
+	return body;
+}
+
+RID PhysicsTestSpace3D::add_static_body(RID p_shape, const Vector3 &p_position) {
+	RID body = add_body(p_shape, p_position);
+	ps->body_set_mode(body, PS3DE::BODY_MODE_STATIC);
+	return body;
+}
+
+void PhysicsTestSpace3D::step(int p_count) {
+	for (int i = 0; i < p_count; i++) {
+		ps->step(1.0 / 60.0);
+	}
+}
+
+Vector<Transform3D> PhysicsTestSpace3D::get_transforms() const {
+	Vector<Transform3D> transforms;
+	for (const RID &body : bodies) {
+		transforms.push_back(ps->body_get_state(body, PS3DE::BODY_STATE_TRANSFORM));
+	}
+	return transforms;
+}
+
+PhysicsTestSpace3D::PhysicsTestSpace3D(PhysicsServer3D *p_ps) :
+		ps(p_ps) {
+	space = ps->space_create();
+	ps->space_set_active(space, true);
+}
+
+PhysicsTestSpace3D::~PhysicsTestSpace3D() {
+	for (const RID &body : bodies) {
+		ps->free_rid(body);
+	}
+	for (const RID &shape : shapes) {
+		ps->free_rid(shape);
+	}
+	ps->free_rid(space);
+}
+
+} // namespace TestUtils
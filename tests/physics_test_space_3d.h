@@ -0,0 +1,60 @@
+/**************************************************************************/
+/*  physics_test_space_3d.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/local_vector.h"
+#include "servers/physics_3d/physics_server_3d.h"
+
+namespace TestUtils {
+
+// An active space of a 3D physics server, which frees the shapes and bodies created through it.
+struct PhysicsTestSpace3D {
+	PhysicsServer3D *ps = nullptr;
+	RID space;
+	LocalVector<RID> shapes;
+	LocalVector<RID> bodies;
+
+	RID create_box_shape(const Vector3 &p_half_extents);
+	RID create_sphere_shape(real_t p_radius);
+
+	RID add_body(RID p_shape, const Vector3 &p_position);
+	RID add_static_body(RID p_shape, const Vector3 &p_position);
+
+	void step(int p_count);
+
+	// Transforms of all bodies, in the order they were added.
+	Vector<Transform3D> get_transforms() const;
+
+	PhysicsTestSpace3D(PhysicsServer3D *p_ps = PhysicsServer3D::get_singleton());
+	~PhysicsTestSpace3D();
+};
+
+} // namespace TestUtils
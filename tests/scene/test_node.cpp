@@ -35,10 +35,13 @@ TEST_FORCE_LINK(test_node)
 #include "core/io/file_access.h"
 #include "core/io/resource_saver.h"
 #include "core/object/class_db.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
 #include "scene/main/window.h"
 #include "scene/resources/packed_scene.h"
+#include "tests/test_benchmark.h"
 #include "tests/test_utils.h"
 
 namespace TestNode {
@@ -439,6 +442,43 @@ TEST_CASE("[SceneTree][Node] Testing node operations with a more complex simple
 		CHECK_EQ(E, node1_1);
 	}
 
+	SUBCASE("Groups should stay in tree order when nodes are added, removed and moved") {
+		// Added out of tree order, the group is sorted when it's read.
+		node2->add_to_group("nodes");
+		node1->add_to_group("nodes");
+		Vector<Node *> nodes = SceneTree::get_singleton()->get_nodes_in_group("nodes");
+		REQUIRE_EQ(nodes.size(), 2);
+		CHECK_EQ(nodes[0], node1);
+		CHECK_EQ(nodes[1], node2);
+
+		// Nodes added later are merged into the sorted nodes.
+		node1_1->add_to_group("nodes");
+		nodes = SceneTree::get_singleton()->get_nodes_in_group("nodes");
+		REQUIRE_EQ(nodes.size(), 3);
+		CHECK_EQ(nodes[0], node1);
+		CHECK_EQ(nodes[1], node1_1);
+		CHECK_EQ(nodes[2], node2);
+
+		node1->remove_from_group("nodes");
+		SceneTree::get_singleton()->get_root()->move_child(node2, 0);
+		nodes = SceneTree::get_singleton()->get_nodes_in_group("nodes");
+		REQUIRE_EQ(nodes.size(), 2);
+		CHECK_EQ(nodes[0], node2);
+		CHECK_EQ(nodes[1], node1_1);
+
+		node1->add_to_group("nodes");
+		CHECK_EQ(SceneTree::get_singleton()->get_first_node_in_group("nodes"), node2);
+		nodes = SceneTree::get_singleton()->get_nodes_in_group("nodes");
+		REQUIRE_EQ(nodes.size(), 3);
+		CHECK_EQ(nodes[1], node1);
+		CHECK_EQ(nodes[2], node1_1);
+
+		SceneTree::get_singleton()->call_group("nodes", "set_meta", "group_call", 1);
+		CHECK_EQ(int(node1->get_meta("group_call", 0)), 1);
+		CHECK_EQ(int(node1_1->get_meta("group_call", 0)), 1);
+		CHECK_EQ(int(node2->get_meta("group_call", 0)), 1);
+	}
+
 	SUBCASE("Nodes added as siblings of another node should be right next to it") {
 		node1->remove_child(node1_1);
 
@@ -918,4 +958,319 @@ TEST_CASE("[SceneTree][Node] Test the process priority") {
 	memdelete(node4);
 }
 
+class ReadyCheckNode : public Node {
+	GDCLASS(ReadyCheckNode, Node);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_READY) {
+			ready_count.increment();
+			if (get_parent() && get_parent()->is_ready()) {
+				parent_ready_first.set();
+			}
+			for (int i = 0; i < get_child_count(); i++) {
+				if (!get_child(i)->is_ready()) {
+					child_not_ready.set();
+				}
+			}
+			if (!Thread::is_main_thread()) {
+				ready_on_thread.set();
+			}
+		}
+	}
+
+public:
+	static inline SafeNumeric<int> ready_count{ 0 };
+	static inline SafeFlag parent_ready_first{ false };
+	static inline SafeFlag child_not_ready{ false };
+	static inline SafeFlag ready_on_thread{ false };
+};
+
+TEST_CASE("[SceneTree][Node] Ready sub-thread groups in parallel") {
+	ReadyCheckNode::ready_count.set(0);
+	ReadyCheckNode::parent_ready_first.clear();
+	ReadyCheckNode::child_not_ready.clear();
+	ReadyCheckNode::ready_on_thread.clear();
+	SceneTree::get_singleton()->set_parallel_ready_enabled(true);
+
+	constexpr int GROUP_COUNT = 4;
+	constexpr int GROUP_SIZE = 16;
+	ReadyCheckNode *level = memnew(ReadyCheckNode);
+	for (int i = 0; i < GROUP_COUNT; i++) {
+		ReadyCheckNode *group = memnew(ReadyCheckNode);
+		group->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+		level->add_child(group);
+		for (int j = 0; j < GROUP_SIZE; j++) {
+			ReadyCheckNode *child = memnew(ReadyCheckNode);
+			group->add_child(child);
+			child->add_child(memnew(ReadyCheckNode));
+		}
+	}
+	// A group with a main thread node in it is never readied on a worker thread.
+	ReadyCheckNode *main_thread_group = memnew(ReadyCheckNode);
+	main_thread_group->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+	ReadyCheckNode *main_thread_node = memnew(ReadyCheckNode);
+	main_thread_node->set_process_thread_group(Node::PROCESS_THREAD_GROUP_MAIN_THREAD);
+	main_thread_group->add_child(main_thread_node);
+	level->add_child(main_thread_group);
+
+	SceneTree::get_singleton()->get_root()->add_child(level);
+
+	CHECK_EQ(ReadyCheckNode::ready_count.get(), 1 + GROUP_COUNT * (1 + GROUP_SIZE * 2) + 2);
+	CHECK(level->is_ready());
+	CHECK(main_thread_node->is_ready());
+	CHECK_FALSE(ReadyCheckNode::parent_ready_first.is_set());
+	CHECK_FALSE(ReadyCheckNode::child_not_ready.is_set());
+	if (WorkerThreadPool::get_singleton()->get_thread_count() > 0) {
+		CHECK(ReadyCheckNode::ready_on_thread.is_set());
+	}
+
+	SceneTree::get_singleton()->set_parallel_ready_enabled(false);
+	memdelete(level);
+}
+
+TEST_CASE("[SceneTree][Node] Process plain and derived nodes in the same group") {
+	// Plain nodes without a script have nothing to run, derived nodes must still be notified.
+	Node *plain_node = memnew(Node);
+	TestNode *test_node = memnew(TestNode);
+	Node *other_plain_node = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(plain_node);
+	SceneTree::get_singleton()->get_root()->add_child(test_node);
+	SceneTree::get_singleton()->get_root()->add_child(other_plain_node);
+
+	plain_node->set_process(true);
+	plain_node->set_physics_process(true);
+	test_node->set_process(true);
+	test_node->set_physics_process(true);
+	other_plain_node->set_process(true);
+
+	SceneTree::get_singleton()->process(0);
+	SceneTree::get_singleton()->physics_process(0);
+	SceneTree::get_singleton()->process(0);
+
+	CHECK_EQ(2, test_node->process_counter);
+	CHECK_EQ(1, test_node->physics_process_counter);
+
+	memdelete(plain_node);
+	memdelete(test_node);
+	memdelete(other_plain_node);
+}
+
+TEST_CASE("[SceneTree][Node] Cached node path resolution follows tree changes") {
+	Node *root = memnew(Node);
+	Node *child = memnew(Node);
+	child->set_name("Child");
+	root->add_child(child);
+	SceneTree::get_singleton()->get_root()->add_child(root);
+
+	// The cache is only kept once a node looks up the same path again.
+	const NodePath path = NodePath("Child");
+	CHECK(root->get_node_or_null(path) == child);
+	CHECK(root->get_node_or_null(path) == child);
+	CHECK(root->get_node_or_null(path) == child);
+
+	SUBCASE("Rename invalidates the cached path") {
+		child->set_name("Renamed");
+		CHECK(root->get_node_or_null(path) == nullptr);
+		CHECK(root->get_node_or_null(NodePath("Renamed")) == child);
+
+		child->set_name("Child");
+		CHECK(root->get_node_or_null(path) == child);
+	}
+
+	SUBCASE("Removing and adding children invalidates the cached path") {
+		root->remove_child(child);
+		CHECK(root->get_node_or_null(path) == nullptr);
+
+		Node *other = memnew(Node);
+		other->set_name("Child");
+		root->add_child(other);
+		CHECK(root->get_node_or_null(path) == other);
+
+		root->remove_child(other);
+		memdelete(other);
+		root->add_child(child);
+		CHECK(root->get_node_or_null(path) == child);
+	}
+
+	SUBCASE("Unique name changes invalidate the cached path") {
+		const NodePath unique_path = NodePath("%Child");
+		CHECK(root->get_node_or_null(unique_path) == nullptr);
+
+		child->set_owner(root);
+		child->set_unique_name_in_owner(true);
+		CHECK(root->get_node_or_null(unique_path) == child);
+
+		child->set_unique_name_in_owner(false);
+		CHECK(root->get_node_or_null(unique_path) == nullptr);
+	}
+
+	SUBCASE("Unique names looked up in the owner from a descendant follow owner changes") {
+		Node *grandchild = memnew(Node);
+		child->add_child(grandchild);
+		grandchild->set_owner(root);
+		child->set_owner(root);
+		child->set_unique_name_in_owner(true);
+
+		const NodePath unique_path = NodePath("%Child");
+		CHECK(grandchild->get_node_or_null(unique_path) == child);
+		CHECK(grandchild->get_node_or_null(unique_path) == child);
+
+		child->set_unique_name_in_owner(false);
+		CHECK(grandchild->get_node_or_null(unique_path) == nullptr);
+
+		child->set_unique_name_in_owner(true);
+		CHECK(grandchild->get_node_or_null(unique_path) == child);
+		grandchild->set_owner(nullptr);
+		CHECK(grandchild->get_node_or_null(unique_path) == nullptr);
+	}
+
+	SUBCASE("Paths going up follow reparenting") {
+		Node *sibling = memnew(Node);
+		sibling->set_name("Sibling");
+		root->add_child(sibling);
+
+		const NodePath sibling_path = NodePath("../Sibling");
+		CHECK(child->get_node_or_null(sibling_path) == sibling);
+		CHECK(child->get_node_or_null(sibling_path) == sibling);
+
+		// Moving the node changes what it walks up to.
+		Node *other_parent = memnew(Node);
+		root->add_child(other_parent);
+		child->reparent(other_parent);
+		CHECK(child->get_node_or_null(sibling_path) == nullptr);
+		CHECK(child->get_node_or_null(NodePath("../../Sibling")) == sibling);
+
+		// Freeing the sibling is seen from the old cached entries as well.
+		child->reparent(root);
+		CHECK(child->get_node_or_null(sibling_path) == sibling);
+		memdelete(sibling);
+		CHECK(child->get_node_or_null(sibling_path) == nullptr);
+	}
+
+	SUBCASE("Absolute paths follow changes above the node") {
+		root->set_name("CacheRoot");
+		const NodePath absolute_path = NodePath("/root/CacheRoot/Child");
+		CHECK(child->get_node_or_null(absolute_path) == child);
+		CHECK(child->get_node_or_null(absolute_path) == child);
+
+		root->set_name("RenamedRoot");
+		CHECK(child->get_node_or_null(absolute_path) == nullptr);
+		CHECK(child->get_node_or_null(NodePath("/root/RenamedRoot/Child")) == child);
+	}
+
+	SUBCASE("Changes elsewhere in the tree keep the cached path valid") {
+		Node *unrelated = memnew(Node);
+		SceneTree::get_singleton()->get_root()->add_child(unrelated);
+		unrelated->set_name("Unrelated");
+		CHECK(root->get_node_or_null(path) == child);
+		memdelete(unrelated);
+		CHECK(root->get_node_or_null(path) == child);
+	}
+
+	memdelete(root);
+}
+
+// Not run by default, use `--test --benchmark` to run it.
+TEST_CASE("[SceneTree][Node][Benchmark] Process 100k idle nodes" * doctest::skip()) {
+	constexpr int NODE_COUNT = 100'000;
+	constexpr int FRAME_COUNT = 100;
+
+	Node *parent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+	for (int i = 0; i < NODE_COUNT; i++) {
+		Node *node = memnew(Node);
+		node->set_process(true);
+		parent->add_child(node);
+	}
+
+	// The first frame sorts the process list.
+	SceneTree::get_singleton()->process(0);
+
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < FRAME_COUNT; i++) {
+		SceneTree::get_singleton()->process(0);
+	}
+	const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(vformat("%d idle processing nodes: %.3f ms per frame, %.1f ns per node.", NODE_COUNT, elapsed / 1000.0 / FRAME_COUNT, elapsed * 1000.0 / FRAME_COUNT / NODE_COUNT));
+	TestBenchmark::add_result("idle_processing_nodes", "process", elapsed, FRAME_COUNT);
+
+	memdelete(parent);
+}
+
+TEST_CASE("[Node] Many children keep their names and order") {
+	// Enough children to switch the child storage to a hash map and back.
+	constexpr int CHILD_COUNT = 20;
+
+	Node *parent = memnew(Node);
+	Vector<Node *> children;
+	for (int i = 0; i < CHILD_COUNT; i++) {
+		Node *child = memnew(Node);
+		child->set_name(vformat("Child%d", i));
+		parent->add_child(child);
+		children.push_back(child);
+	}
+
+	for (int i = 0; i < CHILD_COUNT; i++) {
+		CHECK(parent->get_node_or_null(NodePath(vformat("Child%d", i))) == children[i]);
+		CHECK(parent->get_child(i) == children[i]);
+	}
+
+	children[5]->set_name("Renamed");
+	CHECK(parent->get_node_or_null(NodePath("Child5")) == nullptr);
+	CHECK(parent->get_node_or_null(NodePath("Renamed")) == children[5]);
+
+	// Duplicate names are still made unique.
+	Node *duplicate = memnew(Node);
+	duplicate->set_name("Child3");
+	parent->add_child(duplicate);
+	CHECK(duplicate->get_name() != StringName("Child3"));
+	CHECK(parent->get_node_or_null(NodePath("Child3")) == children[3]);
+	parent->remove_child(duplicate);
+	memdelete(duplicate);
+
+	for (int i = CHILD_COUNT - 1; i >= 2; i--) {
+		parent->remove_child(children[i]);
+		memdelete(children[i]);
+	}
+	CHECK(parent->get_child_count() == 2);
+	CHECK(parent->get_child(0) == children[0]);
+	CHECK(parent->get_node_or_null(NodePath("Child1")) == children[1]);
+
+	children[0]->set_name("First");
+	CHECK(parent->get_node_or_null(NodePath("First")) == children[0]);
+	CHECK(parent->get_node_or_null(NodePath("Child0")) == nullptr);
+
+	memdelete(parent);
+}
+
+// Not run by default, use `--test --benchmark` to run it.
+// Memory usage is only tracked in debug builds.
+TEST_CASE("[Node][Benchmark] Memory of 1M nodes" * doctest::skip()) {
+	constexpr int NODE_COUNT = 1'000'000;
+	constexpr int CHILDREN_PER_NODE = 4;
+
+	const uint64_t memory_before = Memory::get_mem_usage();
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+	// A tree made mostly of leaves, like big simulations.
+	LocalVector<Node *> nodes;
+	nodes.reserve(NODE_COUNT);
+	nodes.push_back(memnew(Node));
+	for (int i = 1; i < NODE_COUNT; i++) {
+		Node *node = memnew(Node);
+		nodes[(i - 1) / CHILDREN_PER_NODE]->add_child(node);
+		nodes.push_back(node);
+	}
+
+	const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+	const uint64_t memory_used = Memory::get_mem_usage() - memory_before;
+
+	MESSAGE(vformat("%d nodes: %.1f bytes per node (sizeof(Node) is %d), built in %.3f ms.", NODE_COUNT, double(memory_used) / NODE_COUNT, (int)sizeof(Node), elapsed / 1000.0));
+	TestBenchmark::add_result("million_nodes", "build", elapsed);
+
+	memdelete(nodes[0]);
+}
+
 } // namespace TestNode
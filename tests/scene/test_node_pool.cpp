@@ -0,0 +1,125 @@
+/**************************************************************************/
+/*  test_node_pool.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_node_pool)
+
+#include "scene/2d/node_2d.h"
+#include "scene/main/node_pool.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+#include "scene/resources/packed_scene.h"
+
+namespace TestNodePool {
+
+static Ref<PackedScene> _create_test_scene() {
+	Node2D *root = memnew(Node2D);
+	root->set_name("Root");
+	Node2D *child = memnew(Node2D);
+	child->set_name("Child");
+	child->set_position(Vector2(1, 2));
+	child->add_to_group("targets", true);
+	root->add_child(child);
+	child->set_owner(root);
+
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	packed_scene->pack(root);
+	memdelete(root);
+	return packed_scene;
+}
+
+TEST_CASE("[SceneTree][NodePool] Acquire and release instances") {
+	Ref<NodePool> pool = SceneTree::get_singleton()->create_node_pool(_create_test_scene(), 2);
+	REQUIRE(pool.is_valid());
+	CHECK(pool->get_available_count() == 2);
+
+	Node2D *instance = Object::cast_to<Node2D>(pool->acquire());
+	REQUIRE(instance != nullptr);
+	CHECK(pool->get_available_count() == 1);
+	CHECK(pool->get_hit_count() == 1);
+	CHECK(pool->get_miss_count() == 0);
+
+	Node2D *child = Object::cast_to<Node2D>(instance->get_node(NodePath("Child")));
+	REQUIRE(child != nullptr);
+	SceneTree::get_singleton()->get_root()->add_child(instance);
+	instance->set_rotation(1.0);
+	child->set_position(Vector2(10, 20));
+	child->set_visible(false);
+	child->remove_from_group("targets");
+	instance->add_to_group("extra");
+	Node *extra_child = memnew(Node);
+	child->add_child(extra_child);
+
+	pool->release(instance);
+	CHECK(instance->get_parent() == nullptr);
+	CHECK(pool->get_available_count() == 2);
+
+	SUBCASE("Released instances are reset to their defaults") {
+		CHECK(instance->get_rotation() == doctest::Approx(0.0));
+		CHECK(child->get_position() == Vector2(1, 2));
+		CHECK(child->is_visible());
+		CHECK(child->is_in_group("targets"));
+		CHECK_FALSE(instance->is_in_group("extra"));
+		CHECK(child->get_child_count() == 0);
+		CHECK(extra_child->is_queued_for_deletion());
+	}
+
+	SUBCASE("Released instances are reused") {
+		Node *first = pool->acquire();
+		Node *second = pool->acquire();
+		CHECK((first == instance || second == instance));
+		CHECK(pool->get_hit_count() == 3);
+
+		Node *third = pool->acquire();
+		REQUIRE(third != nullptr);
+		CHECK(pool->get_miss_count() == 1);
+		CHECK(pool->get_available_count() == 0);
+
+		pool->release(first);
+		pool->release(second);
+		CHECK(pool->get_available_count() == 2);
+
+		// The pool is full, extra instances are freed.
+		pool->release(third);
+		CHECK(pool->get_available_count() == 2);
+		CHECK(third->is_queued_for_deletion());
+	}
+
+	SUBCASE("Releasing the same instance twice is rejected") {
+		ERR_PRINT_OFF;
+		pool->release(instance);
+		ERR_PRINT_ON;
+		CHECK(pool->get_available_count() == 2);
+	}
+}
+
+} // namespace TestNodePool
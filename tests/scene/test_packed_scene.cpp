@@ -33,6 +33,7 @@
 TEST_FORCE_LINK(test_packed_scene)
 
 #include "core/object/callable_mp.h"
+#include "scene/2d/node_2d.h"
 #include "scene/resources/packed_scene.h"
 
 namespace TestPackedScene {
@@ -282,4 +283,50 @@ TEST_CASE("[PackedScene] Recreate State") {
 	memdelete(scene);
 }
 
+TEST_CASE("[PackedScene] Instantiate Packed Scene Properties Repeatedly") {
+	// Create a scene to pack.
+	Node *scene = memnew(Node);
+	scene->set_name("TestScene");
+	scene->set_process_priority(3);
+
+	Node2D *child = memnew(Node2D);
+	child->set_name("Child");
+	child->set_position(Vector2(4, 2));
+	child->set_rotation(0.5);
+	child->set_meta("tag", "enemy");
+	scene->add_child(child);
+	child->set_owner(scene);
+
+	// Pack the scene.
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	packed_scene->pack(scene);
+
+	// Later instances set properties through setters resolved by the first one.
+	for (int i = 0; i < 3; i++) {
+		Node *instance = packed_scene->instantiate();
+		REQUIRE(instance != nullptr);
+		CHECK(instance->get_process_priority() == 3);
+#ifdef TOOLS_ENABLED
+		CHECK_MESSAGE(instance->is_edited(), "Setting properties should mark the node as edited, like Object::set() does.");
+#endif
+		Node2D *instance_child = Object::cast_to<Node2D>(instance->get_child(0));
+		REQUIRE(instance_child != nullptr);
+		CHECK(instance_child->get_position() == Vector2(4, 2));
+		CHECK(instance_child->get_rotation() == doctest::Approx(0.5));
+		CHECK(instance_child->get_meta("tag") == "enemy");
+		memdelete(instance);
+	}
+
+	// Packing again must not reuse setters resolved for the previous state.
+	child->set_position(Vector2(8, 8));
+	packed_scene->pack(scene);
+	Node *instance = packed_scene->instantiate();
+	REQUIRE(instance != nullptr);
+	CHECK(Object::cast_to<Node2D>(instance->get_child(0))->get_position() == Vector2(8, 8));
+
+	memdelete(instance);
+	memdelete(scene);
+}
+
 } // namespace TestPackedScene
@@ -0,0 +1,306 @@
+/**************************************************************************/
+/*  test_scene_tree_benchmark.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_scene_tree_benchmark)
+
+#include "core/object/callable_mp.h"
+#include "core/object/class_db.h"
+#include "scene/main/node.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+#include "tests/test_benchmark.h"
+
+#ifndef PHYSICS_3D_DISABLED
+#include "scene/3d/physics/collision_shape_3d.h"
+#include "scene/3d/physics/rigid_body_3d.h"
+#include "scene/3d/physics/static_body_3d.h"
+#include "scene/resources/3d/box_shape_3d.h"
+#include "servers/physics_3d/physics_server_3d.h"
+#endif // PHYSICS_3D_DISABLED
+
+// Synthetic scenes run headless through the main loop, with the timings of each phase reported to TestBenchmark.
+// Not run by default, use `--test --benchmark` to run them.
+
+namespace TestSceneTreeBenchmark {
+
+constexpr int FRAME_COUNT = 60;
+
+class BenchmarkNode : public Node {
+	GDCLASS(BenchmarkNode, Node);
+
+protected:
+	void _notification(int p_what) {
+		switch (p_what) {
+			case NOTIFICATION_PROCESS:
+			case NOTIFICATION_PHYSICS_PROCESS: {
+				counter++;
+			} break;
+		}
+	}
+
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("touch"), &BenchmarkNode::touch);
+		ADD_SIGNAL(MethodInfo("benchmarked"));
+	}
+
+public:
+	uint64_t counter = 0;
+
+	void touch() { counter++; }
+};
+
+// Times adding the scene to the tree, the given number of idle and physics frames, and freeing the scene.
+static void run_scene(const String &p_benchmark, Node *p_scene, int p_frames = FRAME_COUNT) {
+	SceneTree *tree = SceneTree::get_singleton();
+	{
+		TestBenchmark::PhaseTimer timer(p_benchmark, "enter_tree");
+		tree->get_root()->add_child(p_scene);
+	}
+
+	// The first frame sorts the process lists.
+	tree->process(0);
+	tree->physics_process(0);
+
+	{
+		TestBenchmark::PhaseTimer timer(p_benchmark, "process", p_frames);
+		for (int i = 0; i < p_frames; i++) {
+			tree->process(1.0 / 60.0);
+		}
+	}
+	{
+		TestBenchmark::PhaseTimer timer(p_benchmark, "physics_process", p_frames);
+		for (int i = 0; i < p_frames; i++) {
+			tree->physics_process(1.0 / 60.0);
+		}
+	}
+	{
+		TestBenchmark::PhaseTimer timer(p_benchmark, "exit_tree");
+		tree->get_root()->remove_child(p_scene);
+	}
+	{
+		TestBenchmark::PhaseTimer timer(p_benchmark, "free");
+		memdelete(p_scene);
+	}
+}
+
+TEST_CASE("[SceneTree][Benchmark] Deep tree" * doctest::skip()) {
+	constexpr int CHAIN_COUNT = 50;
+	constexpr int CHAIN_DEPTH = 1000;
+	const String benchmark = "deep_tree";
+
+	Node *scene = nullptr;
+	{
+		TestBenchmark::PhaseTimer timer(benchmark, "build");
+		scene = memnew(Node);
+		for (int i = 0; i < CHAIN_COUNT; i++) {
+			Node *parent = scene;
+			for (int j = 0; j < CHAIN_DEPTH; j++) {
+				Node *node = memnew(Node);
+				parent->add_child(node);
+				parent = node;
+			}
+		}
+	}
+
+	run_scene(benchmark, scene);
+}
+
+TEST_CASE("[SceneTree][Benchmark] Wide tree" * doctest::skip()) {
+	constexpr int CHILD_COUNT = 100'000;
+	const String benchmark = "wide_tree";
+
+	Node *scene = nullptr;
+	{
+		TestBenchmark::PhaseTimer timer(benchmark, "build");
+		scene = memnew(Node);
+		for (int i = 0; i < CHILD_COUNT; i++) {
+			scene->add_child(memnew(Node));
+		}
+	}
+
+	run_scene(benchmark, scene);
+}
+
+TEST_CASE("[SceneTree][Benchmark] Processing nodes" * doctest::skip()) {
+	GDREGISTER_CLASS(BenchmarkNode);
+
+	constexpr int NODE_COUNT = 100'000;
+	const String benchmark = "processing_nodes";
+
+	Node *scene = nullptr;
+	{
+		TestBenchmark::PhaseTimer timer(benchmark, "build");
+		scene = memnew(Node);
+		for (int i = 0; i < NODE_COUNT; i++) {
+			BenchmarkNode *node = memnew(BenchmarkNode);
+			node->set_process(true);
+			node->set_physics_process(true);
+			scene->add_child(node);
+		}
+	}
+
+	run_scene(benchmark, scene);
+}
+
+TEST_CASE("[SceneTree][Benchmark] Signals" * doctest::skip()) {
+	GDREGISTER_CLASS(BenchmarkNode);
+
+	constexpr int EMITTER_COUNT = 10'000;
+	constexpr int RECEIVERS_PER_EMITTER = 8;
+	const String benchmark = "signals";
+	const StringName signal_name = "benchmarked";
+
+	Node *scene = memnew(Node);
+	LocalVector<BenchmarkNode *> emitters;
+	{
+		TestBenchmark::PhaseTimer timer(benchmark, "build");
+		for (int i = 0; i < EMITTER_COUNT; i++) {
+			BenchmarkNode *emitter = memnew(BenchmarkNode);
+			scene->add_child(emitter);
+			emitters.push_back(emitter);
+		}
+	}
+	{
+		TestBenchmark::PhaseTimer timer(benchmark, "connect");
+		for (BenchmarkNode *emitter : emitters) {
+			for (int j = 0; j < RECEIVERS_PER_EMITTER; j++) {
+				BenchmarkNode *receiver = emitters[(emitter->get_index() + j + 1) % EMITTER_COUNT];
+				emitter->connect(signal_name, callable_mp(receiver, &BenchmarkNode::touch));
+			}
+		}
+	}
+	{
+		TestBenchmark::PhaseTimer timer(benchmark, "emit", FRAME_COUNT);
+		for (int i = 0; i < FRAME_COUNT; i++) {
+			for (BenchmarkNode *emitter : emitters) {
+				emitter->emit_signal(signal_name);
+			}
+		}
+	}
+
+	run_scene(benchmark, scene);
+}
+
+TEST_CASE("[SceneTree][Benchmark] Group calls" * doctest::skip()) {
+	GDREGISTER_CLASS(BenchmarkNode);
+
+	constexpr int NODE_COUNT = 100'000;
+	const String benchmark = "group_calls";
+	const StringName group = "benchmark";
+
+	Node *scene = nullptr;
+	{
+		TestBenchmark::PhaseTimer timer(benchmark, "build");
+		scene = memnew(Node);
+		for (int i = 0; i < NODE_COUNT; i++) {
+			BenchmarkNode *node = memnew(BenchmarkNode);
+			node->add_to_group(group);
+			scene->add_child(node);
+		}
+	}
+
+	SceneTree *tree = SceneTree::get_singleton();
+	tree->get_root()->add_child(scene);
+	{
+		TestBenchmark::PhaseTimer timer(benchmark, "call_group", FRAME_COUNT);
+		for (int i = 0; i < FRAME_COUNT; i++) {
+			tree->call_group(group, "touch");
+		}
+	}
+	{
+		TestBenchmark::PhaseTimer timer(benchmark, "notify_group", FRAME_COUNT);
+		for (int i = 0; i < FRAME_COUNT; i++) {
+			tree->notify_group(group, Node::NOTIFICATION_PROCESS);
+		}
+	}
+	tree->get_root()->remove_child(scene);
+
+	run_scene(benchmark, scene);
+}
+
+#ifndef PHYSICS_3D_DISABLED
+TEST_CASE("[SceneTree][Benchmark] Physics bodies" * doctest::skip()) {
+	constexpr int GRID_SIZE = 16;
+	constexpr int LAYER_COUNT = 4;
+	const String benchmark = "physics_bodies";
+
+	Node *scene = nullptr;
+	{
+		TestBenchmark::PhaseTimer timer(benchmark, "build");
+		scene = memnew(Node);
+
+		Ref<BoxShape3D> floor_shape;
+		floor_shape.instantiate();
+		floor_shape->set_size(Vector3(1000, 1, 1000));
+		StaticBody3D *floor = memnew(StaticBody3D);
+		CollisionShape3D *floor_collision = memnew(CollisionShape3D);
+		floor_collision->set_shape(floor_shape);
+		floor->add_child(floor_collision);
+		scene->add_child(floor);
+
+		Ref<BoxShape3D> box_shape;
+		box_shape.instantiate();
+		for (int layer = 0; layer < LAYER_COUNT; layer++) {
+			for (int x = 0; x < GRID_SIZE; x++) {
+				for (int z = 0; z < GRID_SIZE; z++) {
+					RigidBody3D *body = memnew(RigidBody3D);
+					CollisionShape3D *collision = memnew(CollisionShape3D);
+					collision->set_shape(box_shape);
+					body->add_child(collision);
+					body->set_position(Vector3(x * 1.1, 1.0 + layer * 1.1, z * 1.1));
+					scene->add_child(body);
+				}
+			}
+		}
+	}
+
+	SceneTree *tree = SceneTree::get_singleton();
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	tree->get_root()->add_child(scene);
+	{
+		// Same order as the main loop.
+		TestBenchmark::PhaseTimer timer(benchmark, "physics_frame", FRAME_COUNT);
+		for (int i = 0; i < FRAME_COUNT; i++) {
+			physics_server->sync();
+			physics_server->flush_queries();
+			tree->physics_process(1.0 / 60.0);
+			physics_server->end_sync();
+			physics_server->step(1.0 / 60.0);
+		}
+	}
+	tree->get_root()->remove_child(scene);
+
+	run_scene(benchmark, scene);
+}
+#endif // PHYSICS_3D_DISABLED
+
+} // namespace TestSceneTreeBenchmark
@@ -0,0 +1,155 @@
+/**************************************************************************/
+/*  test_physics_server_3d_state.cpp                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_physics_server_3d_state)
+
+#include "servers/physics_3d/physics_server_3d.h"
+#include "servers/physics_3d/physics_server_3d_manager.h"
+#include "tests/physics_test_space_3d.h"
+
+namespace TestPhysicsServer3DState {
+
+using TestUtils::PhysicsTestSpace3D;
+
+// Bodies that keep touching the same bodies while the state is saved and replayed, so the physics
+// engines solve them in the same order. None of them sleeps, the rest of the state changes with every step.
+// Returns the box that rests alone on the ground.
+static RID build_world(PhysicsTestSpace3D &r_world, int p_stack_height) {
+	PhysicsServer3D *ps = r_world.ps;
+
+	// The top of the ground is at y = 0.5.
+	r_world.add_static_body(r_world.create_box_shape(Vector3(20, 0.5, 20)), Vector3());
+
+	const RID box_shape = r_world.create_box_shape(Vector3(0.5, 0.5, 0.5));
+	for (int i = 0; i < p_stack_height; i++) {
+		r_world.add_body(box_shape, Vector3(0, 1.01 + i * 1.01, 0));
+	}
+	RID lone_box = r_world.add_body(box_shape, Vector3(6, 1.0, 0));
+	RID sphere = r_world.add_body(r_world.create_sphere_shape(0.5), Vector3(-6, 1.0, 0));
+	ps->body_set_state(sphere, PS3DE::BODY_STATE_LINEAR_VELOCITY, Vector3(1, 0, 0));
+
+	// Everything but the ground.
+	for (uint32_t i = 1; i < r_world.bodies.size(); i++) {
+		ps->body_set_state(r_world.bodies[i], PS3DE::BODY_STATE_CAN_SLEEP, false);
+	}
+	return lone_box;
+}
+
+// Transforms of the bodies after each of the given number of steps.
+static Vector<Transform3D> record_steps(PhysicsTestSpace3D &r_world, int p_count) {
+	Vector<Transform3D> transforms;
+	for (int i = 0; i < p_count; i++) {
+		r_world.step(1);
+		transforms.append_array(r_world.get_transforms());
+	}
+	return transforms;
+}
+
+static void test_space_state(const String &p_engine) {
+	PhysicsServer3D *ps = PhysicsServer3DManager::get_singleton()->new_server(p_engine);
+	if (ps == nullptr) {
+		MESSAGE(vformat("%s is not available in this build, skipping.", p_engine));
+		return;
+	}
+	ps->init();
+
+	{
+		const int replayed_steps = 60;
+		PhysicsTestSpace3D world(ps);
+		const RID lone_box = build_world(world, 3);
+		world.step(30);
+
+		const Vector<uint8_t> state = ps->space_save_state(world.space);
+		REQUIRE_FALSE(state.is_empty());
+		const Vector<Transform3D> saved = world.get_transforms();
+
+		const Vector<Transform3D> expected = record_steps(world, replayed_steps);
+		const Vector<uint8_t> expected_end_state = ps->space_save_state(world.space);
+
+		// Separating bodies drops their contacts, which have to come back from the restored state.
+		ps->body_set_state(lone_box, PS3DE::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(6, 20, 0)));
+		world.step(5);
+
+		CHECK(ps->space_restore_state(world.space, state));
+		CHECK_MESSAGE(record_steps(world, replayed_steps) == expected, "Replayed steps should give bit-identical transforms.");
+		CHECK_MESSAGE(ps->space_save_state(world.space) == expected_end_state, "Replayed steps should end in the same state, contacts included.");
+
+		Vector<uint8_t> corrupted_header = state;
+		corrupted_header.write[0] ^= 0xFF;
+		Vector<uint8_t> corrupted_body = state;
+		corrupted_body.write[state.size() / 2] ^= 0xFF;
+
+		Vector<uint8_t> other_state;
+		{
+			PhysicsTestSpace3D other_world(ps);
+			build_world(other_world, 2);
+			other_world.step(1);
+			other_state = ps->space_save_state(other_world.space);
+		}
+		REQUIRE_FALSE(other_state.is_empty());
+
+		// Rejected states must leave the space as it is.
+		const Vector<uint8_t> current_state = ps->space_save_state(world.space);
+
+		ERR_PRINT_OFF;
+		CHECK_FALSE(ps->space_restore_state(world.space, Vector<uint8_t>()));
+		CHECK_FALSE(ps->space_restore_state(world.space, corrupted_header));
+		CHECK_FALSE(ps->space_restore_state(world.space, corrupted_body));
+		CHECK_FALSE_MESSAGE(ps->space_restore_state(world.space, other_state), "A state saved with other bodies should be rejected.");
+		ERR_PRINT_ON;
+
+		CHECK(ps->space_save_state(world.space) == current_state);
+
+		// Bodies are matched by the order they were added to their space, so the state can also be restored
+		// into another space built the same way, as it would be in another process.
+		PhysicsTestSpace3D copy(ps);
+		build_world(copy, 3);
+		copy.step(1);
+		CHECK(ps->space_restore_state(copy.space, state));
+		CHECK(copy.get_transforms() == saved);
+	}
+
+	ps->finish();
+	memdelete(ps);
+}
+
+TEST_CASE("[Physics3D] Restoring a saved space state replays the same steps") {
+	SUBCASE("Godot Physics 3D") {
+		test_space_state("GodotPhysics3D");
+	}
+
+	SUBCASE("Jolt Physics") {
+		test_space_state("Jolt Physics");
+	}
+}
+
+} // namespace TestPhysicsServer3DState
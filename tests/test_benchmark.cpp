@@ -0,0 +1,95 @@
+/**************************************************************************/
+/*  test_benchmark.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_benchmark.h"
+
+#include "core/io/json.h"
+#include "core/os/os.h"
+#include "core/variant/dictionary.h"
+#include "core/version.h"
+
+namespace TestBenchmark {
+
+// Allocated on first use, so nothing is left behind when benchmarks don't run.
+static Dictionary *results = nullptr;
+
+void add_result(const String &p_benchmark, const String &p_phase, uint64_t p_usec, uint32_t p_iterations) {
+	ERR_FAIL_COND(p_iterations == 0);
+
+	if (!results) {
+		results = memnew(Dictionary);
+	}
+	if (!results->has(p_benchmark)) {
+		(*results)[p_benchmark] = Dictionary();
+	}
+	Dictionary phases = (*results)[p_benchmark];
+
+	Dictionary phase;
+	phase["usec"] = p_usec;
+	phase["iterations"] = p_iterations;
+	phase["usec_per_iteration"] = double(p_usec) / p_iterations;
+	phases[p_phase] = phase;
+}
+
+bool has_results() {
+	return results && !results->is_empty();
+}
+
+String get_results_json() {
+	Dictionary report;
+	report["version"] = GODOT_VERSION_FULL_BUILD;
+	report["hash"] = GODOT_VERSION_HASH;
+#ifdef DEBUG_ENABLED
+	report["debug"] = true;
+#else
+	report["debug"] = false;
+#endif
+	report["processor_count"] = OS::get_singleton()->get_processor_count();
+	report["benchmarks"] = results ? *results : Dictionary();
+	return JSON::stringify(report, "\t", false);
+}
+
+void clear_results() {
+	if (results) {
+		memdelete(results);
+		results = nullptr;
+	}
+}
+
+PhaseTimer::PhaseTimer(const String &p_benchmark, const String &p_phase, uint32_t p_iterations) :
+		benchmark(p_benchmark), phase(p_phase), iterations(p_iterations) {
+	begin_usec = OS::get_singleton()->get_ticks_usec();
+}
+
+PhaseTimer::~PhaseTimer() {
+	add_result(benchmark, phase, OS::get_singleton()->get_ticks_usec() - begin_usec, iterations);
+}
+
+} // namespace TestBenchmark
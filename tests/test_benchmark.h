@@ -0,0 +1,60 @@
+/**************************************************************************/
+/*  test_benchmark.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/string/ustring.h"
+
+// Benchmarks are test cases tagged `[Benchmark]` and skipped by default.
+// `godot --test --benchmark` runs only them and prints the timings they report as JSON,
+// `godot --test --benchmark-file <path>` saves the JSON to a file instead, to compare it across commits.
+// With `--test-case=<filter>`, only the matching test cases run instead of all benchmarks.
+
+namespace TestBenchmark {
+
+// Adds the time spent in a phase of a benchmark (e.g. "process"), over a number of iterations (e.g. frames).
+void add_result(const String &p_benchmark, const String &p_phase, uint64_t p_usec, uint32_t p_iterations = 1);
+bool has_results();
+String get_results_json();
+void clear_results();
+
+// Reports the time between its creation and destruction as a phase of a benchmark.
+class PhaseTimer {
+	String benchmark;
+	String phase;
+	uint32_t iterations = 1;
+	uint64_t begin_usec = 0;
+
+public:
+	PhaseTimer(const String &p_benchmark, const String &p_phase, uint32_t p_iterations = 1);
+	~PhaseTimer();
+};
+
+} // namespace TestBenchmark
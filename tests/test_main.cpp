@@ -34,6 +34,7 @@
 #include "core/input/input.h"
 #include "core/input/input_map.h"
 #include "core/io/dir_access.h"
+#include "core/io/file_access.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/string/translation_server.h"
@@ -47,6 +48,7 @@
 #include "tests/display_server_mock.h"
 #include "tests/force_link.gen.h"
 #include "tests/signal_watcher.h"
+#include "tests/test_benchmark.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -119,14 +121,34 @@ int test_main(int argc, char *argv[]) {
 	doctest::Context test_context;
 	LocalVector<String> test_args;
 
+	bool run_benchmarks = false;
+	bool has_test_case_filter = false;
+	String benchmark_file;
+
 	// Clean arguments of "--test" from the args.
 	for (int x = 0; x < argc; x++) {
 		String arg = String(argv[x]);
-		if (arg != "--test") {
+		if (arg == "--benchmark") {
+			run_benchmarks = true;
+		} else if (arg == "--benchmark-file" && x + 1 < argc) {
+			run_benchmarks = true;
+			benchmark_file = String::utf8(argv[++x]);
+		} else if (arg != "--test") {
+			if (arg.begins_with("--test-case=") || arg.begins_with("-tc=") || arg.begins_with("--dt-test-case=") || arg.begins_with("--dt-tc=")) {
+				has_test_case_filter = true;
+			}
 			test_args.push_back(arg);
 		}
 	}
 
+	if (run_benchmarks) {
+		// Benchmarks are skipped by default, only run them unless other test cases were asked for.
+		test_args.push_back("--no-skip");
+		if (!has_test_case_filter) {
+			test_args.push_back("--test-case=*[Benchmark]*");
+		}
+	}
+
 	if (test_args.size() > 0) {
 		// Convert Godot command line arguments back to standard arguments.
 		char **doctest_args = new char *[test_args.size()];
@@ -148,7 +170,25 @@ int test_main(int argc, char *argv[]) {
 		delete[] doctest_args;
 	}
 
-	return test_context.run();
+	int status = test_context.run();
+
+	if (run_benchmarks) {
+		const String json = TestBenchmark::get_results_json();
+		if (benchmark_file.is_empty()) {
+			print_line(json);
+		} else {
+			Ref<FileAccess> f = FileAccess::open(benchmark_file, FileAccess::WRITE);
+			if (f.is_valid()) {
+				f->store_string(json);
+			} else {
+				ERR_PRINT(vformat("Can't open benchmark output file: \"%s\".", benchmark_file));
+				status = EXIT_FAILURE;
+			}
+		}
+	}
+	TestBenchmark::clear_results();
+
+	return status;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 String TestUtils::get_data_path(const String &p_file) {
@@ -49,6 +50,27 @@ String TestUtils::get_temp_path(const String &p_suffix) {
 	return temp_base.path_join(p_suffix);
 }
 
+TestUtils::ScopedWorkerThreadCount::ScopedWorkerThreadCount(int p_thread_count) {
+#ifdef THREADS_ENABLED
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	previous_count = pool->get_thread_count();
+	if (p_thread_count != previous_count) {
+		pool->finish();
+		pool->init(p_thread_count);
+	}
+#endif // THREADS_ENABLED
+}
+
+TestUtils::ScopedWorkerThreadCount::~ScopedWorkerThreadCount() {
+#ifdef THREADS_ENABLED
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (pool->get_thread_count() != previous_count) {
+		pool->finish();
+		pool->init(previous_count);
+	}
+#endif // THREADS_ENABLED
+}
+
 String &TestProjectSettingsInternalsAccessor::resource_path() {
 	return ProjectSettings::get_singleton()->resource_path;
 }
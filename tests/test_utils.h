@@ -37,6 +37,16 @@ namespace TestUtils {
 String get_data_path(const String &p_file);
 String get_executable_dir();
 String get_temp_path(const String &p_suffix);
+
+// Runs the WorkerThreadPool with the given number of threads while in scope, so code paths
+// that depend on the number of threads are tested the same way on any machine.
+class ScopedWorkerThreadCount {
+	int previous_count = 0;
+
+public:
+	ScopedWorkerThreadCount(int p_thread_count);
+	~ScopedWorkerThreadCount();
+};
 } // namespace TestUtils
 
 // FIXME: This was originally constrained to `tests/core/config/test_project_settings.h`, but that